@@ -2,7 +2,10 @@
 
 #include <memory>
 #include "renderer/Model.h"
+#include "renderer/Bounds.h"
 
 struct RenderComponent {
     std::shared_ptr<Model> model;
+    // AABB del modelo en espacio de mundo; la mantiene el RenderSystem al actualizar el transform.
+    AABB worldBounds;
 };
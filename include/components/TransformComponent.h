@@ -21,6 +21,8 @@ struct TransformComponent {
     glm::vec3 rotation = glm::vec3(0.0f);  // (pitch, yaw, roll) en grados.
     glm::vec3 scale = glm::vec3(1.0f);
     glm::mat4 transform = glm::mat4(1.0f);
+    // Inversa traspuesta de la parte 3x3 de transform, salvo un factor de escala (los shaders normalizan).
+    glm::mat3 normalMatrix = glm::mat3(1.0f);
 
     // Actualiza la transformación final: T * R * S.
     void UpdateTransform() {
@@ -30,5 +32,12 @@ struct TransformComponent {
                                         glm::radians(rotation.z));
         glm::mat4 S = glm::scale(glm::mat4(1.0f), scale);
         transform = T * R * S;
+        // (R * S)^-T = R * S^-1; con escala uniforme basta R (identidad si no hay rotación).
+        normalMatrix = glm::mat3(R);
+        if (scale.x != scale.y || scale.y != scale.z) {
+            normalMatrix[0] /= scale.x;
+            normalMatrix[1] /= scale.y;
+            normalMatrix[2] /= scale.z;
+        }
     }
 };
@@ -10,7 +10,7 @@ struct Vertex {
     glm::vec3 Normal;
     glm::vec2 TexCoords;
     glm::vec2 TexCoords2; // Segundo set de coordenadas UV
-    glm::vec3 Tangent;
+    glm::vec4 Tangent;    // xyz: tangente, w: signo de la bitangente (B = cross(N, T) * w)
 };
 
 void processNode(aiNode* node, const aiScene* scene,
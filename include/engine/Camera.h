@@ -13,6 +13,12 @@ public:
     float Pitch{0.0f};
     float MouseSensitivity{0.1f};
 
+    // Parámetros de proyección (fov vertical en grados).
+    float Fov{45.0f};
+    float AspectRatio{1920.0f / 1080.0f};
+    float NearPlane{0.1f};
+    float FarPlane{100.0f};
+
     // Nueva bandera para evitar que la cámara se actualice con input.
     bool fixedCamera = true;
 
@@ -31,6 +37,10 @@ public:
     glm::mat4 GetViewMatrix() const {
         return glm::lookAt(Position, Position + Front, Up);
     }
+
+    glm::mat4 GetProjectionMatrix() const {
+        return glm::perspective(glm::radians(Fov), AspectRatio, NearPlane, FarPlane);
+    }
     
     // Procesamiento del teclado: si la cámara está en modo fijo, no se actualiza.
     void ProcessKeyboard(char direction, float deltaTime) {
@@ -9,6 +9,9 @@ struct LightConfig {
     std::string type;
     glm::vec3 position;
     glm::vec3 color;
+    glm::vec3 direction{0.0f, -1.0f, 0.0f}; // Solo direccionales
+    bool castShadows = false;               // Direccional: la primera con sombras usa cascadas; puntuales: atlas de cubos
+    float range = 0.0f; // Radio de influencia para el clustering (0: ilumina toda la escena)
 };
 
 class Config {
@@ -21,6 +24,24 @@ public:
     std::string vertexShader;  // Nombre del vertex shader global (sin extensión)
     std::string defaultShader; // Nombre del fragment shader por defecto (sin extensión)
     glm::vec3 ambientColor;
+    std::string renderPath = "forward"; // forward o deferred (G-buffer + pasada de iluminación)
+    bool depthPrepass = false; // Pre-pasada de profundidad de opacos (sombreado con GL_EQUAL)
+    bool shaderVariants = true; // Una variante del shader PBR por combinación de mapas del material (ver ShaderVariants.h)
+    int maxLightsPerCluster = 64; // MAX_LIGHTS de las variantes: tope de luces evaluadas por cluster
+    std::string shaderCacheDir = "./cache/shaders"; // Binarios de programas enlazados (vacío: sin caché)
+    bool renderThread = true; // Hilo dedicado de GL: simula el frame N mientras envía el N-1 (ver RenderThread.h)
+    std::string culling = "bvh"; // bvh (jerárquico) o flat (SIMD sobre todas las cajas)
+    bool occlusionCulling = true;
+    int occluderTriangleBudget = 20000; // Triángulos de oclusores rasterizados por frame
+    float lodBias = 1.0f;      // >1 mantiene más detalle a distancia, <1 baja antes de LOD
+    // Sombras en cascada de la luz direccional con castShadows.
+    int shadowCascades = 4;
+    int shadowResolution = 2048;
+    float shadowDistance = 100.0f;
+    // Atlas de sombras de luces puntuales con castShadows.
+    int pointShadowSlots = 8;
+    int pointShadowResolution = 512;
+    int pointShadowFaceBudget = 12; // Caras de cubo refrescadas por frame como máximo
     std::vector<LightConfig> lights;
 
     static Config LoadFromFile(const std::string& configFilePath);
@@ -2,6 +2,7 @@
 
 #include "core/Coordinator.h"
 #include "components/TransformComponent.h"
+#include "engine/RenderThread.h"
 #include "utils/Logger.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -48,7 +49,8 @@ public:
     }
     
     void Update(float dt) {
-        GLFWwindow* window = glfwGetCurrentContext();
+        // Con hilo de GL el contexto no es de este hilo: la ventana la da el RenderThread.
+        GLFWwindow* window = RenderThread::GetInstance().GetWindow();
         if (!window) return;
         auto& transform = mCoordinator->GetComponent<TransformComponent>(mEntity);
         
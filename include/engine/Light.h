@@ -8,7 +8,7 @@ enum class LightType : int { POINT = 0, SPOT = 1, DIRECTIONAL = 2 };
 
 struct Light {
     glm::vec4 typeAndPadding;   // x: tipo, yzw: padding
-    glm::vec4 position;         // xyz: posición, w: padding
+    glm::vec4 position;         // xyz: posición, w: rango de influencia (<= 0: sin límite ni atenuación)
     glm::vec4 direction;        // xyz: dirección, w: padding
     glm::vec4 colorAndIntensity;// rgb: color, a: intensidad
     glm::vec4 spotParams;       // x: cutOff, y: outerCutOff, z/w: padding
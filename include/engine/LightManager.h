@@ -1,72 +1,233 @@
 #pragma once
 
+#include <algorithm>
+#include <cstring>
 #include <vector>
+#include <memory>
 #include "Light.h"
-#include "utils/UniformBuffer.h"
+#include "engine/Camera.h"
+#include "engine/RenderThread.h"
+#include "renderer/LightClusterGrid.h"
+#include "renderer/Shader.h"
+#include "utils/DirtyRangeTracker.h"
+#include "utils/FrameRingBuffer.h"
+#include "utils/GLDebug.h"
+#include "utils/ThreadPool.h"
 #include "utils/Logger.h"
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+/**
+ * @brief Luces de la escena con clustered forward: todas las luces viven en un SSBO y cada
+ * cluster del frustum referencia solo las que lo alcanzan (ver LightClusterGrid).
+ *
+ * Bloques que lee pbr_fragment.glsl:
+ *   - "LightBlock" (UBO, ParamsBindingPoint): parámetros de la rejilla.
+ *   - "LightBuffer" (SSBO): todas las luces.
+ *   - "ClusterBlock" (SSBO): offset/count de cada cluster.
+ *   - "LightIndexBlock" (SSBO): [luces sin rango][índices del cluster 0][cluster 1]...
+ *
+ * Update (simulación) construye la rejilla en el paquete del frame junto con las luces modificadas;
+ * Upload (hilo de GL) escribe rejilla, clusters e índices en el FrameRingBuffer. Las luces no pasan
+ * por el ring: viven en su propio buffer persistente con una sección por frame en vuelo, y solo se
+ * copian a la sección del frame las modificadas (SetLight/AddLight) desde la última vez que se usó.
+ * Una escena estática no sube nada; una luz animada, sus 80 bytes. El rango enlazado cubre solo las
+ * luces activas, así que lights.length() en el shader es el número de luces.
+ */
 class LightManager
 {
 public:
-    std::vector<Light> lights;
-    UniformBuffer lightUBO;
-    // Bandera para saber si las luces han cambiado
-    bool lightsChanged = true;
+    static constexpr GLuint ParamsBindingPoint = 1;
+    static constexpr GLuint LightBufferBindingPoint = 4;
+    static constexpr GLuint ClusterBindingPoint = 5;
+    static constexpr GLuint LightIndexBindingPoint = 6;
 
     LightManager()
     {
-        Logger::Info("[LightManager] Created and UBO initialized.");
-        // Aquí se inicializa el UBO
+        Logger::Info("[LightManager] Created.");
     }
 
-    void UpdateUBO()
+    ~LightManager()
     {
-        // Si no han cambiado, se evita la actualización
-        if (!lightsChanged)
-            return;
+        if (lightBuffer)
+            glDeleteBuffers(1, &lightBuffer);
+    }
 
-        Logger::ThrottledLog("LightManager_UpdateUBO", LogLevel::INFO, "[LightManager] Updating UBO", 0.5);
-        constexpr int maxLights = 10;
-        std::vector<Light> lightData(maxLights);
-        for (int i = 0; i < maxLights; i++)
+    LightManager(const LightManager &) = delete;
+    LightManager &operator=(const LightManager &) = delete;
+
+    // Asocia los bloques de luces del programa a sus binding points. Devuelve false si falta alguno.
+    bool BindBlocks(Shader &shader)
+    {
+        bool found = shader.BindUniformBlock("LightBlock", ParamsBindingPoint);
+        found &= shader.BindStorageBlock("LightBuffer", LightBufferBindingPoint);
+        found &= shader.BindStorageBlock("ClusterBlock", ClusterBindingPoint);
+        found &= shader.BindStorageBlock("LightIndexBlock", LightIndexBindingPoint);
+        return found;
+    }
+
+    // Simulación: reconstruye los clusters para la cámara (en los hilos del ThreadPool) y anota en el
+    // paquete del frame las luces modificadas desde el anterior.
+    void Update(const Camera &camera)
+    {
+        FramePacket &packet = packets.Write();
+        packet.grid.SetProjection(camera.Fov, camera.AspectRatio, camera.NearPlane, camera.FarPlane);
+        packet.grid.Build(lights, camera.GetViewMatrix(), &ThreadPool::GetInstance());
+
+        DirtyRangeTracker<1>::Range range = changed.Take(0, lights.size());
+        packet.lightCount = lights.size();
+        packet.firstChanged = range.begin;
+        packet.changedLights.assign(lights.begin() + range.begin, lights.begin() + range.begin + range.Count());
+
+        const ClusterStats &stats = packet.grid.GetStats();
+        Logger::ThrottledLog("LightManager_Clusters", LogLevel::DEBUG,
+                             "[LightManager] " + std::to_string(lights.size()) + " lights (" +
+                                 std::to_string(stats.lights) + " in frustum, " + std::to_string(stats.globalLights) +
+                                 " unbounded), " + std::to_string(stats.references) + " cluster references, max " +
+                                 std::to_string(stats.maxPerCluster) + " per cluster, " +
+                                 std::to_string(range.Count() * sizeof(Light)) + " light bytes changed",
+                             5.0);
+    }
+
+    // Hilo de GL: sube el paquete del frame (luces cambiadas y clusters). Los rangos valen hasta el final del frame.
+    void Upload()
+    {
+        const FramePacket &packet = packets.Read();
+        renderLights.resize(packet.lightCount);
+        if (!packet.changedLights.empty())
         {
-            if (i < static_cast<int>(lights.size()))
-                lightData[i] = lights[i];
-            else
-            {
-                lightData[i].typeAndPadding = glm::vec4(-1, 0, 0, 0);
-                lightData[i].position = glm::vec4(0.0f);
-                lightData[i].direction = glm::vec4(0.0f);
-                lightData[i].colorAndIntensity = glm::vec4(0.0f);
-                lightData[i].spotParams = glm::vec4(0.0f);
-            }
+            std::copy(packet.changedLights.begin(), packet.changedLights.end(), renderLights.begin() + packet.firstChanged);
+            dirty.Mark(packet.firstChanged, packet.firstChanged + packet.changedLights.size());
         }
-        size_t dataSize = lightData.size() * sizeof(Light);
-        lightUBO.Bind();
-        glBufferData(GL_UNIFORM_BUFFER, dataSize, lightData.data(), GL_DYNAMIC_DRAW);
-        lightUBO.Unbind();
-        Logger::ThrottledLog("LightManager_UBOUpdated", LogLevel::INFO,
-                             "[LightManager] UBO updated (" + std::to_string(lights.size()) +
-                                 " active lights, max " + std::to_string(maxLights) + ").",
-                             0.5);
-
-        // Se marca como actualizado
-        lightsChanged = false;
+        UploadLights();
+
+        FrameRingBuffer &ring = FrameRingBuffer::GetInstance();
+        const std::vector<uint32_t> &indices = packet.grid.GetLightIndices();
+        indexRange = ring.Upload(GL_SHADER_STORAGE_BUFFER, indices.data(), static_cast<GLsizeiptr>(indices.size() * sizeof(uint32_t)));
+        clusterRange = ring.Upload(GL_SHADER_STORAGE_BUFFER, packet.grid.GetClusters().data(),
+                                   sizeof(ClusterRange) * LightClusterGrid::ClusterCount);
+        ClusterGridParams params = packet.grid.GetParams();
+        paramsRange = ring.Upload(GL_UNIFORM_BUFFER, &params, sizeof(ClusterGridParams));
+    }
+
+    // Enlaza los rangos escritos por el último Upload.
+    void Bind()
+    {
+        if (paramsRange.buffer == 0)
+            return;
+        FrameRingBuffer::Bind(GL_UNIFORM_BUFFER, ParamsBindingPoint, paramsRange);
+        GLCall(glBindBufferRange(GL_SHADER_STORAGE_BUFFER, LightBufferBindingPoint, lightBuffer,
+                                 static_cast<GLintptr>(lightSection * sectionBytes), lightBytes));
+        FrameRingBuffer::Bind(GL_SHADER_STORAGE_BUFFER, ClusterBindingPoint, clusterRange);
+        FrameRingBuffer::Bind(GL_SHADER_STORAGE_BUFFER, LightIndexBindingPoint, indexRange);
     }
 
     void AddLight(const Light &light)
     {
         lights.push_back(light);
-        lightsChanged = true;
+        changed.Mark(lights.size() - 1, lights.size());
         Logger::Debug("[LightManager] Added light. Total: " + std::to_string(lights.size()));
     }
 
     void ClearLights()
     {
         lights.clear();
-        lightsChanged = true;
+        changed.Clear();
         Logger::Info("[LightManager] Cleared all lights.");
     }
-};
+
+    // Para luces animadas: sin reservas y, en los próximos frames, solo se copian los bytes de esta luz.
+    void SetLight(size_t index, const Light &light)
+    {
+        lights[index] = light;
+        changed.Mark(index, index + 1);
+    }
+
+    const Light &GetLight(size_t index) const { return lights[index]; }
+    // Luces de la simulación (las que verá el próximo Update).
+    const std::vector<Light> &GetLights() const { return lights; }
+
+private:
+    // Lo que Update deja para el hilo de GL. Los vectores conservan su capacidad entre frames.
+    struct FramePacket
+    {
+        LightClusterGrid grid;
+        size_t lightCount = 0;
+        size_t firstChanged = 0;
+        std::vector<Light> changedLights; // Luces [firstChanged, firstChanged + size) desde el paquete anterior
+    };
+
+    // Copia a la sección del frame actual lo que cambió desde su último uso. El fence que espera
+    // FrameRingBuffer::BeginFrame cubre también esta sección: es la del mismo índice, FrameCount frames atrás
+    // (el índice y los fences sobreviven a que el ring crezca).
+    void UploadLights()
+    {
+        // Un SSBO vacío no es válido: siempre al menos una luz (desactivada).
+        size_t count = std::max<size_t>(renderLights.size(), 1);
+        if (count > capacity)
+            CreateLightBuffer(std::max(count, capacity * 2));
+
+        lightSection = FrameRingBuffer::GetInstance().GetFrameIndex();
+        char *section = mapped + lightSection * sectionBytes;
+        if (renderLights.empty())
+        {
+            Light disabled{};
+            disabled.typeAndPadding = glm::vec4(-1, 0, 0, 0);
+            std::memcpy(section, &disabled, sizeof(Light));
+            // La luz 0 de las demás secciones ya no es la de renderLights.
+            dirty.Mark(0, 1);
+        }
+        else
+        {
+            DirtyRangeTracker<RingAllocator::FrameCount>::Range range = dirty.Take(lightSection, renderLights.size());
+            if (!range.Empty())
+                std::memcpy(section + range.begin * sizeof(Light), &renderLights[range.begin], range.Count() * sizeof(Light));
+        }
+        lightBytes = static_cast<GLsizeiptr>(count * sizeof(Light));
+    }
+
+    // Solo al superar la capacidad (se duplica). Las secciones nuevas están vacías: todo queda pendiente.
+    // El buffer anterior se puede borrar ya: GL lo mantiene vivo mientras haya comandos en vuelo que lo usen.
+    void CreateLightBuffer(size_t newCapacity)
+    {
+        if (lightBuffer)
+            GLCall(glDeleteBuffers(1, &lightBuffer));
+
+        GLint alignment = 0;
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        size_t align = static_cast<size_t>(std::max(alignment, 1));
+        capacity = newCapacity;
+        sectionBytes = (capacity * sizeof(Light) + align - 1) / align * align;
+
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        const GLsizeiptr totalBytes = static_cast<GLsizeiptr>(sectionBytes * RingAllocator::FrameCount);
+        GLCall(glGenBuffers(1, &lightBuffer));
+        GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, lightBuffer));
+        GLCall(glBufferStorage(GL_COPY_WRITE_BUFFER, totalBytes, nullptr, flags));
+        mapped = static_cast<char *>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalBytes, flags));
+        GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+
+        dirty.MarkAll(renderLights.size());
+        Logger::Info("[LightManager] Light buffer: " + std::to_string(RingAllocator::FrameCount) + " x " +
+                     std::to_string(capacity) + " lights");
+    }
+
+    // Simulación.
+    std::vector<Light> lights;
+    DirtyRangeTracker<1> changed; // Luces modificadas desde el último paquete
+    RenderPacket<FramePacket> packets;
+
+    // Hilo de GL: copia de las luces tal como están en el buffer y secciones pendientes de cada una.
+    std::vector<Light> renderLights;
+    DirtyRangeTracker<RingAllocator::FrameCount> dirty;
+    GLuint lightBuffer = 0;
+    char *mapped = nullptr;
+    size_t capacity = 0;
+    size_t sectionBytes = 0;
+    uint32_t lightSection = 0;
+    GLsizeiptr lightBytes = 0;
+
+    FrameRingBuffer::Range paramsRange;
+    FrameRingBuffer::Range clusterRange;
+    FrameRingBuffer::Range indexRange;
+};
\ No newline at end of file
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <GLFW/glfw3.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include "utils/Logger.h"
+
+/**
+ * @brief Hilo dedicado de OpenGL. El hilo principal simula el frame N (input, ECS, culling, clusters)
+ * mientras este envía al driver el frame N-1: la CPU de la simulación y la del driver se solapan.
+ *
+ * Lo que comparten ambos lados viaja en RenderPacket<T>: Update escribe Write() y Render lee Read().
+ * SubmitFrame es la única sincronización por frame. Espera a que el hilo de GL termine el frame
+ * anterior, con lo que su paquete queda libre para la simulación siguiente, y le entrega el nuevo.
+ * El contexto pertenece al hilo de GL: cualquier otro trabajo con GL (cambiar de escena, cargar
+ * recursos) pasa por Execute, que lo ejecuta allí con el pipeline vacío.
+ *
+ * Sin hilo (render: renderThread: no) todo corre en serie en el hilo que llama, con el mismo código.
+ */
+class RenderThread {
+public:
+    static RenderThread& GetInstance() {
+        static RenderThread instance;
+        return instance;
+    }
+
+    // renderFrame dibuja y presenta el frame publicado. Con threaded, el contexto de window pasa del
+    // hilo que llama al de GL.
+    void Start(GLFWwindow* renderWindow, std::function<void()> renderFrame, bool threaded) {
+        window = renderWindow;
+        frameCallback = std::move(renderFrame);
+        if (!threaded) {
+            Logger::Info("[RenderThread] Rendering on the main thread");
+            return;
+        }
+        glfwMakeContextCurrent(nullptr);
+        thread = std::thread(&RenderThread::Run, this);
+        Logger::Info("[RenderThread] GL thread started");
+    }
+
+    // Publica el frame que la simulación acaba de escribir y vuelve en cuanto el anterior está dibujado.
+    void SubmitFrame() {
+        if (!thread.joinable()) {
+            renderFrame = simFrame++;
+            frameCallback();
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        auto waitStart = std::chrono::steady_clock::now();
+        idle.wait(lock, [this] { return !frameInFlight; });
+        double waited = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - waitStart).count();
+        RethrowError();
+        renderFrame = simFrame++;
+        frameInFlight = true;
+        wake.notify_one();
+        Logger::ThrottledLog("RenderThread_Wait", LogLevel::DEBUG,
+                             "[RenderThread] Simulation waited " + std::to_string(waited) + " ms for the GL thread",
+                             5.0);
+    }
+
+    // Ejecuta job en el hilo de GL, sin frames en vuelo, y espera a que termine.
+    void Execute(const std::function<void()>& job) {
+        if (!thread.joinable()) {
+            job();
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return !frameInFlight && !pendingJob; });
+        pendingJob = &job;
+        wake.notify_one();
+        idle.wait(lock, [this] { return pendingJob == nullptr; });
+        RethrowError();
+    }
+
+    // Termina el frame en vuelo y devuelve el contexto al hilo que llama.
+    void Stop() {
+        if (!thread.joinable())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        thread.join();
+        stopping = false;
+        glfwMakeContextCurrent(window);
+        Logger::Info("[RenderThread] GL thread stopped");
+    }
+
+    // Ranura de RenderPacket que escribe la simulación y la que lee el hilo de GL (iguales sin hilo).
+    uint32_t GetSimSlot() const { return static_cast<uint32_t>(simFrame & 1); }
+    uint32_t GetRenderSlot() const { return static_cast<uint32_t>(renderFrame & 1); }
+    // La ventana es la del contexto, pero el input (glfwGetKey) se sigue leyendo en el hilo principal.
+    GLFWwindow* GetWindow() const { return window; }
+
+private:
+    RenderThread() = default;
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    void Run() {
+        glfwMakeContextCurrent(window);
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [this] { return pendingJob || frameInFlight || stopping; });
+            if (pendingJob) {
+                lock.unlock();
+                Invoke(*pendingJob);
+                lock.lock();
+                pendingJob = nullptr;
+            } else if (frameInFlight) {
+                lock.unlock();
+                Invoke(frameCallback);
+                lock.lock();
+                frameInFlight = false;
+            } else {
+                break;
+            }
+            idle.notify_all();
+        }
+        glfwMakeContextCurrent(nullptr);
+    }
+
+    // Las excepciones del hilo de GL se relanzan en el principal en la siguiente sincronización.
+    void Invoke(const std::function<void()>& function) {
+        try {
+            function();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            error = std::current_exception();
+        }
+    }
+
+    void RethrowError() {
+        if (!error)
+            return;
+        std::exception_ptr pending = error;
+        error = nullptr;
+        std::rethrow_exception(pending);
+    }
+
+    GLFWwindow* window = nullptr;
+    std::function<void()> frameCallback;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake; // Hilo de GL: hay frame, trabajo o parada
+    std::condition_variable idle; // Hilo principal: frame o trabajo terminado
+    const std::function<void()>* pendingJob = nullptr;
+    bool frameInFlight = false;
+    bool stopping = false;
+    std::exception_ptr error;
+    uint64_t simFrame = 0;
+    uint64_t renderFrame = 0;
+};
+
+/**
+ * @brief Datos que la simulación produce para el hilo de GL, con doble buffer: mientras Render lee el
+ * paquete del frame anterior, Update escribe el siguiente en la otra ranura. Un paquete no cambia
+ * desde que se publica (SubmitFrame) hasta que el hilo de GL termina con él.
+ */
+template <typename T>
+class RenderPacket {
+public:
+    T& Write() { return slots[RenderThread::GetInstance().GetSimSlot()]; }
+    const T& Read() const { return slots[RenderThread::GetInstance().GetRenderSlot()]; }
+
+private:
+    T slots[2];
+};
\ No newline at end of file
@@ -4,12 +4,15 @@
  * @brief Interfaz base para una escena.
  *
  * Define los métodos necesarios para inicializar, actualizar, renderizar y limpiar la escena.
+ * Update (frame N) y Render (frame N-1) pueden correr a la vez en hilos distintos (ver RenderThread):
+ * todo lo que Render lee de la simulación pasa por un RenderPacket. Init y Destroy usan GL y se
+ * ejecutan en el hilo de GL sin frames en vuelo.
  */
 class Scene {
 public:
     virtual void Init() = 0;         // Cargar recursos, entidades, sistemas, etc.
-    virtual void Update(float dt) = 0; // Lógica de actualización (input, movimiento, etc.)
-    virtual void Render() = 0;       // Renderizado de la escena
+    virtual void Update(float dt) = 0; // Lógica de actualización (input, movimiento, etc.); sin llamadas GL
+    virtual void Render() = 0;       // Renderizado en el hilo de GL, solo con lo que dejó el último Update
     virtual void Destroy() = 0;      // Liberar recursos propios de la escena
     virtual ~Scene() {}
 };
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <memory>
 #include <string>
 #include "renderer/Shader.h"
+#include "renderer/ShaderVariants.h"
 #include "renderer/Texture2D.h"
 #include "renderer/Model.h"
 
@@ -14,6 +15,9 @@
 class SceneResources {
 public:
     std::shared_ptr<Shader> LoadShader(const char* vShaderFile, const char* fShaderFile, const std::string& name);
+    // Variantes de un par de shaders (ver ShaderVariantCache); se compilan bajo demanda.
+    std::shared_ptr<ShaderVariantCache> LoadShaderVariants(const char* vShaderFile, const char* fShaderFile,
+                                                           const std::string& name, uint32_t maxLights);
     std::shared_ptr<Texture2D> LoadTexture(const char* file, bool alpha, const std::string& name);
     std::shared_ptr<Model> LoadModel(const char* file, const std::string& name);
     
@@ -25,7 +29,11 @@ public:
     void Clear();
     
 private:
+    // Rutas relativas a "./shaders/".
+    static std::string ResolveShaderPath(const char* file);
+
     std::map<std::string, std::shared_ptr<Shader>> shaders;
+    std::map<std::string, std::shared_ptr<ShaderVariantCache>> shaderVariants;
     std::map<std::string, std::shared_ptr<Texture2D>> textures;
     std::map<std::string, std::shared_ptr<Model>> models;
 };
\ No newline at end of file
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include "renderer/Bounds.h"
+#include "renderer/Frustum.h"
+#include "renderer/FrustumCuller.h"
+
+/**
+ * @brief Árbol dinámico de AABBs (BVH) para culling jerárquico y consultas espaciales.
+ *
+ * - Las hojas guardan una AABB "engordada" (margin) para que los objetos en movimiento
+ *   solo se reinserten cuando salen de ella; el resto de movimientos no tocan el árbol.
+ * - La inserción elige el hermano por coste de superficie y el árbol se mantiene
+ *   balanceado con rotaciones (como en un árbol AVL).
+ * - Rebuild() reconstruye todo el árbol de arriba a abajo con SAH por bins; pensado para
+ *   geometría estática tras la carga de una escena.
+ */
+class AABBTree {
+public:
+    static constexpr int32_t NullNode = -1;
+
+    struct RayHit {
+        uint32_t userData;
+        float distance; // Distancia de entrada del rayo a la AABB de la hoja
+    };
+
+    explicit AABBTree(float fatMargin = 0.1f);
+
+    // Crea una hoja para la caja dada y devuelve su identificador (proxy).
+    int32_t CreateProxy(const AABB& box, uint32_t userData);
+    void DestroyProxy(int32_t proxy);
+    // Actualiza la caja de un proxy. Devuelve true si tuvo que reinsertarse en el árbol.
+    bool MoveProxy(int32_t proxy, const AABB& box);
+
+    uint32_t GetUserData(int32_t proxy) const { return nodes[proxy].userData; }
+    const AABB& GetFatAABB(int32_t proxy) const { return nodes[proxy].box; }
+    size_t GetProxyCount() const { return proxyCount; }
+    int32_t GetHeight() const { return root == NullNode ? 0 : nodes[root].height; }
+
+    // Reconstrucción completa (SAH por bins) con las hojas actuales. Los proxies siguen siendo válidos.
+    void Rebuild();
+    void Clear();
+
+    // Hojas cuya AABB intersecta el frustum. Los subárboles completamente dentro no se testean.
+    void QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& out, CullingStats* stats = nullptr) const;
+    // Hojas cuya AABB se solapa con la caja dada.
+    void QueryAABB(const AABB& box, std::vector<uint32_t>& out) const;
+    // Hojas cuya AABB atraviesa el rayo en [0, maxDistance].
+    void QueryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                  std::vector<RayHit>& out) const;
+
+    /**
+     * @brief Recorre las hojas atravesadas por el rayo. El callback recibe (userData, distancia)
+     * y devuelve la nueva distancia máxima (p. ej. la del impacto más cercano); si devuelve <= 0
+     * la consulta termina.
+     */
+    template <typename Callback>
+    void RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Callback&& callback) const {
+        if (root == NullNode)
+            return;
+        glm::vec3 invDir = SafeInverse(direction);
+        std::vector<int32_t> stack;
+        stack.reserve(64);
+        stack.push_back(root);
+        while (!stack.empty()) {
+            int32_t index = stack.back();
+            stack.pop_back();
+            const Node& node = nodes[index];
+            float tEntry;
+            if (!RayIntersects(node.box, origin, invDir, maxDistance, tEntry))
+                continue;
+            if (node.IsLeaf()) {
+                float newMax = callback(node.userData, tEntry);
+                if (newMax <= 0.0f)
+                    return;
+                maxDistance = newMax;
+            } else {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+        }
+    }
+
+    // Comprueba la coherencia estructural (padres, alturas y cajas). Usado en tests.
+    bool Validate() const;
+
+private:
+    struct Node {
+        AABB box;
+        int32_t parent = NullNode; // También "next" dentro de la free list
+        int32_t child1 = NullNode;
+        int32_t child2 = NullNode;
+        int32_t height = -1;       // -1: nodo libre, 0: hoja
+        uint32_t userData = 0;
+
+        bool IsLeaf() const { return child1 == NullNode; }
+    };
+
+    std::vector<Node> nodes;
+    int32_t root = NullNode;
+    int32_t freeList = NullNode;
+    size_t proxyCount = 0;
+    float margin;
+
+    int32_t AllocateNode();
+    void FreeNode(int32_t index);
+    void InsertLeaf(int32_t leaf);
+    void RemoveLeaf(int32_t leaf);
+    int32_t Balance(int32_t index);
+    int32_t BuildRange(std::vector<int32_t>& leaves, size_t begin, size_t end);
+    void CollectLeaves(int32_t index, std::vector<uint32_t>& out) const;
+    bool ValidateNode(int32_t index) const;
+
+    static glm::vec3 SafeInverse(const glm::vec3& direction);
+    static bool RayIntersects(const AABB& box, const glm::vec3& origin, const glm::vec3& invDir,
+                              float maxDistance, float& tEntry);
+};
\ No newline at end of file
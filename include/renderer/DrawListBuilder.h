@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include "renderer/FrustumCuller.h"
+
+class ThreadPool;
+
+// Draw visible: clave de orden y candidato del que sale (índice en los registros de quien construye).
+struct DrawSortEntry {
+    uint64_t key = 0;
+    uint32_t candidate = 0;
+    uint32_t lod = 0;
+
+    // A igual clave, por candidato: el orden no depende de cómo se repartieron los bloques.
+    bool operator<(const DrawSortEntry& other) const {
+        return key != other.key ? key < other.key : candidate < other.candidate;
+    }
+};
+
+/**
+ * @brief Culling y lista de draws ordenada, repartidos entre los hilos del ThreadPool.
+ *
+ * Los candidatos se parten en un bloque por hilo. Cada bloque pasa entero por un mismo hilo: test del
+ * frustum (SIMD), filtro de quien construye (oclusión, LOD) y clave de orden, que se acumulan en el
+ * bucket del bloque y este ordena al terminar. Después los buckets se mezclan por parejas, también en
+ * paralelo. Los hilos no comparten nada más que los datos de entrada, y el resultado es el mismo con
+ * cualquier número de hilos.
+ */
+class DrawListBuilder {
+public:
+    // Campos de la clave, de más a menos significativo: transparente (1 bit) | variante | material |
+    // submesh | LOD. Un valor que no cabe en su campo se recorta: solo se pierde agrupación.
+    static constexpr uint32_t VariantBits = 5;
+    static constexpr uint32_t MaterialBits = 16;
+    static constexpr uint32_t SubmeshBits = 24;
+    static constexpr uint32_t LODBits = 4;
+    // Candidatos mínimos por bloque: por debajo, repartir cuesta más que lo que se gana.
+    static constexpr size_t MinBatch = 1024;
+
+    static uint64_t MakeKey(bool transparent, uint32_t variant, uint32_t material, uint32_t submesh, uint32_t lod);
+    static bool IsTransparent(uint64_t key) { return (key >> 63) != 0; }
+
+    // Rellena entry.key y entry.lod de un candidato que pasó el frustum; false lo descarta. Se llama a la
+    // vez desde varios hilos con candidatos distintos: solo puede escribir estado propio del candidato.
+    using Filter = std::function<bool(uint32_t candidate, DrawSortEntry& entry)>;
+
+    // Candidatos [0, bounds.Size()): test del frustum incluido.
+    void Build(const Frustum& frustum, const AABBSoA& bounds, const Filter& filter, ThreadPool* pool = nullptr);
+    // Candidatos ya dentro del frustum (p. ej. la consulta al BVH).
+    void Build(const std::vector<uint32_t>& candidates, const Filter& filter, ThreadPool* pool = nullptr);
+
+    // Opacos primero; los transparentes desde GetFirstTransparent().
+    const std::vector<DrawSortEntry>& GetSorted() const { return sorted; }
+    size_t GetFirstTransparent() const;
+    // Test del frustum (vacío si se construyó desde una lista de candidatos).
+    const CullingStats& GetCullingStats() const { return cullingStats; }
+    // Candidatos dentro del frustum que el filtro descartó.
+    uint32_t GetRejectedCount() const { return rejected; }
+    // Bloques en que se repartió la última construcción.
+    size_t GetBucketCount() const { return bucketCount; }
+
+private:
+    struct Bucket {
+        std::vector<DrawSortEntry> entries;
+        CullingStats stats;
+        uint32_t rejected = 0;
+    };
+
+    // Parte [0, count) en bloques (múltiplos de 4 para el test SIMD), llama a visit(bucket, begin, end)
+    // en paralelo, ordena cada bucket y los mezcla en sorted.
+    void Run(size_t count, ThreadPool* pool, const std::function<void(Bucket&, size_t, size_t)>& visit);
+    void Merge(ThreadPool* pool);
+
+    std::vector<Bucket> buckets;
+    size_t bucketCount = 0;
+    std::vector<uint8_t> visibility;
+    std::vector<DrawSortEntry> sorted;
+    std::vector<DrawSortEntry> scratch; // Destino alterno de cada ronda de mezcla
+    std::vector<size_t> runs;           // Límites de los tramos ordenados en la ronda actual
+    CullingStats cullingStats;
+    uint32_t rejected = 0;
+};
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "engine/Camera.h"
+#include "utils/FrameRingBuffer.h"
+
+/**
+ * @brief Constantes por frame compartidas por todos los programas (layout std140).
+ *
+ * Debe coincidir con el bloque "FrameConstants" declarado en los shaders.
+ */
+struct FrameConstants {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 viewProj;
+    glm::vec4 camPos;       // xyz: posición de la cámara, w: padding
+    glm::vec4 ambientColor; // rgb: color ambiente, a: padding
+};
+
+/**
+ * @brief Constantes por frame. Se escriben una sola vez por frame en el FrameRingBuffer y su
+ * rango se enlaza al binding point FrameUniforms::BindingPoint.
+ */
+class FrameUniforms {
+public:
+    static constexpr GLuint BindingPoint = 0;
+
+    void Update(const Camera& camera, const glm::mat4& projection, const glm::vec3& ambientColor) {
+        data.view = camera.GetViewMatrix();
+        data.projection = projection;
+        data.viewProj = projection * data.view;
+        data.camPos = glm::vec4(camera.Position, 1.0f);
+        data.ambientColor = glm::vec4(ambientColor, 1.0f);
+        FrameRingBuffer::Bind(GL_UNIFORM_BUFFER, BindingPoint,
+                              FrameRingBuffer::GetInstance().Upload(GL_UNIFORM_BUFFER, &data, sizeof(FrameConstants)));
+    }
+
+    const FrameConstants& GetData() const { return data; }
+
+private:
+    FrameConstants data{};
+};
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include "renderer/Bounds.h"
+
+/**
+ * @brief Frustum de la cámara como seis planos (nx, ny, nz, d) con la normal hacia dentro.
+ *
+ * Los planos se extraen de la matriz viewProj (método de Gribb/Hartmann) y se normalizan,
+ * de modo que dot(n, p) + d es la distancia con signo de p al plano.
+ */
+struct Frustum {
+    enum Plane { Left = 0, Right, Bottom, Top, Near, Far, Count };
+
+    glm::vec4 planes[Count];
+
+    static Frustum FromMatrix(const glm::mat4& viewProj) {
+        Frustum f;
+        glm::vec4 row0(viewProj[0][0], viewProj[1][0], viewProj[2][0], viewProj[3][0]);
+        glm::vec4 row1(viewProj[0][1], viewProj[1][1], viewProj[2][1], viewProj[3][1]);
+        glm::vec4 row2(viewProj[0][2], viewProj[1][2], viewProj[2][2], viewProj[3][2]);
+        glm::vec4 row3(viewProj[0][3], viewProj[1][3], viewProj[2][3], viewProj[3][3]);
+        f.planes[Left] = row3 + row0;
+        f.planes[Right] = row3 - row0;
+        f.planes[Bottom] = row3 + row1;
+        f.planes[Top] = row3 - row1;
+        f.planes[Near] = row3 + row2;
+        f.planes[Far] = row3 - row2;
+        for (auto& plane : f.planes) {
+            float length = glm::length(glm::vec3(plane));
+            if (length > 0.0f)
+                plane /= length;
+        }
+        return f;
+    }
+
+    // Test escalar de referencia: false solo si la caja está completamente fuera de algún plano.
+    bool IntersectsAABB(const AABB& box) const {
+        glm::vec3 center = box.Center();
+        glm::vec3 extents = box.Extents();
+        for (const auto& plane : planes) {
+            glm::vec3 n(plane);
+            float distance = glm::dot(n, center) + plane.w;
+            float radius = glm::dot(glm::abs(n), extents);
+            if (distance + radius < 0.0f)
+                return false;
+        }
+        return true;
+    }
+
+    bool IntersectsSphere(const BoundingSphere& sphere) const {
+        for (const auto& plane : planes) {
+            if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius)
+                return false;
+        }
+        return true;
+    }
+};
\ No newline at end of file
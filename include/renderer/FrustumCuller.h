@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "renderer/Bounds.h"
+#include "renderer/Frustum.h"
+
+/**
+ * @brief Cajas en formato SoA (centro/extents por componente) para el test SIMD.
+ */
+struct AABBSoA {
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> extentX, extentY, extentZ;
+
+    void Clear() {
+        centerX.clear(); centerY.clear(); centerZ.clear();
+        extentX.clear(); extentY.clear(); extentZ.clear();
+    }
+
+    void Reserve(size_t count) {
+        centerX.reserve(count); centerY.reserve(count); centerZ.reserve(count);
+        extentX.reserve(count); extentY.reserve(count); extentZ.reserve(count);
+    }
+
+    void Push(const AABB& box) {
+        glm::vec3 c = box.Center();
+        glm::vec3 e = box.Extents();
+        centerX.push_back(c.x); centerY.push_back(c.y); centerZ.push_back(c.z);
+        extentX.push_back(e.x); extentY.push_back(e.y); extentZ.push_back(e.z);
+    }
+
+    // Tamaño fijo para rellenar con Set desde varios hilos (cada uno su rango de índices).
+    void Resize(size_t count) {
+        centerX.resize(count); centerY.resize(count); centerZ.resize(count);
+        extentX.resize(count); extentY.resize(count); extentZ.resize(count);
+    }
+
+    void Set(size_t i, const AABB& box) {
+        glm::vec3 c = box.Center();
+        glm::vec3 e = box.Extents();
+        centerX[i] = c.x; centerY[i] = c.y; centerZ[i] = c.z;
+        extentX[i] = e.x; extentY[i] = e.y; extentZ[i] = e.z;
+    }
+
+    size_t Size() const { return centerX.size(); }
+};
+
+struct CullingStats {
+    uint32_t tested = 0;
+    uint32_t visible = 0;
+    uint32_t culled = 0;
+};
+
+/**
+ * @brief Culling de AABBs contra el frustum de la cámara, 4 cajas por iteración con SSE2
+ * (con ruta escalar equivalente si no hay SIMD disponible).
+ */
+class FrustumCuller {
+public:
+    /**
+     * @brief Escribe 1 en visibility[i] si la caja i intersecta el frustum y 0 si no, para i en
+     * [begin, end) (por defecto todas). Rangos disjuntos se pueden cullear desde hilos distintos.
+     * @return Estadísticas de cajas testeadas, visibles y descartadas.
+     */
+    static CullingStats CullAABBs(const Frustum& frustum, const AABBSoA& boxes, uint8_t* visibility,
+                                  size_t begin = 0, size_t end = SIZE_MAX);
+
+    // Misma operación sin SIMD; se usa para el resto de cajas y como referencia en tests.
+    static CullingStats CullAABBsScalar(const Frustum& frustum, const AABBSoA& boxes, uint8_t* visibility,
+                                        size_t begin = 0, size_t end = SIZE_MAX);
+};
\ No newline at end of file
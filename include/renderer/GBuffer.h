@@ -0,0 +1,108 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <string>
+#include "utils/GLDebug.h"
+#include "utils/Logger.h"
+
+/**
+ * @brief G-buffer del camino diferido (gbuffer_fragment.glsl escribe, deferred_lighting_fragment.glsl lee):
+ *   0: GL_SRGB8_ALPHA8      rgb: albedo, a: metallic
+ *   1: GL_RGB10_A2          rg: normal en codificación octaédrica, b: roughness
+ *   2: GL_R11F_G11F_B10F    emisivo
+ *   depth: GL_DEPTH24_STENCIL8 (la posición se reconstruye con la inversa de viewProj)
+ */
+class GBuffer {
+public:
+    static constexpr int ColorTargets = 3;
+
+    GBuffer() = default;
+    ~GBuffer() { Release(); }
+
+    GBuffer(const GBuffer&) = delete;
+    GBuffer& operator=(const GBuffer&) = delete;
+
+    // Crea o redimensiona los targets. No hace nada si el tamaño no cambió.
+    void Resize(int w, int h) {
+        if (w == width && h == height && fbo != 0)
+            return;
+        Release();
+        width = w;
+        height = h;
+
+        GLCall(glGenFramebuffers(1, &fbo));
+        GLCall(glBindFramebuffer(GL_FRAMEBUFFER, fbo));
+        const GLenum formats[ColorTargets] = { GL_SRGB8_ALPHA8, GL_RGB10_A2, GL_R11F_G11F_B10F };
+        GLCall(glGenTextures(ColorTargets, colorTextures));
+        GLenum attachments[ColorTargets];
+        for (int i = 0; i < ColorTargets; ++i) {
+            GLCall(glBindTexture(GL_TEXTURE_2D, colorTextures[i]));
+            GLCall(glTexStorage2D(GL_TEXTURE_2D, 1, formats[i], width, height));
+            GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+            GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+            GLCall(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, colorTextures[i], 0));
+            attachments[i] = GL_COLOR_ATTACHMENT0 + i;
+        }
+        GLCall(glDrawBuffers(ColorTargets, attachments));
+
+        GLCall(glGenTextures(1, &depthTexture));
+        GLCall(glBindTexture(GL_TEXTURE_2D, depthTexture));
+        GLCall(glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH24_STENCIL8, width, height));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+        GLCall(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0));
+
+        GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        if (status != GL_FRAMEBUFFER_COMPLETE)
+            Logger::Error("[GBuffer] Framebuffer incomplete: " + std::to_string(status));
+        else
+            Logger::Info("[GBuffer] Created " + std::to_string(width) + "x" + std::to_string(height) + " (" +
+                         std::to_string(width * height * 16 / 1024) + " KB)");
+        GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+        GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    }
+
+    void BindForWriting() { GLCall(glBindFramebuffer(GL_FRAMEBUFFER, fbo)); }
+
+    // Enlaza los targets a las unidades firstUnit .. firstUnit + ColorTargets (la última es la profundidad).
+    // Deben quedar fuera de las unidades de material: Submesh::Draw cachea lo que enlazó en ellas.
+    void BindTextures(GLuint firstUnit) {
+        for (int i = 0; i < ColorTargets; ++i) {
+            GLCall(glActiveTexture(GL_TEXTURE0 + firstUnit + i));
+            GLCall(glBindTexture(GL_TEXTURE_2D, colorTextures[i]));
+        }
+        GLCall(glActiveTexture(GL_TEXTURE0 + firstUnit + ColorTargets));
+        GLCall(glBindTexture(GL_TEXTURE_2D, depthTexture));
+        GLCall(glActiveTexture(GL_TEXTURE0));
+    }
+
+    // Copia la profundidad al framebuffer por defecto para la pasada forward de transparentes.
+    void BlitDepthToDefault() {
+        GLCall(glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo));
+        GLCall(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0));
+        GLCall(glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_DEPTH_BUFFER_BIT, GL_NEAREST));
+        GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    }
+
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+
+private:
+    void Release() {
+        if (fbo != 0) {
+            GLCall(glDeleteFramebuffers(1, &fbo));
+            GLCall(glDeleteTextures(ColorTargets, colorTextures));
+            GLCall(glDeleteTextures(1, &depthTexture));
+        }
+        fbo = 0;
+        depthTexture = 0;
+        for (auto& texture : colorTextures)
+            texture = 0;
+    }
+
+    GLuint fbo = 0;
+    GLuint colorTextures[ColorTargets] = {};
+    GLuint depthTexture = 0;
+    int width = 0;
+    int height = 0;
+};
\ No newline at end of file
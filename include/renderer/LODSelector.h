@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <glm/glm.hpp>
+#include "renderer/Bounds.h"
+
+/**
+ * @brief Selección de LOD por tamaño proyectado en pantalla, con histéresis para evitar popping.
+ *
+ * El tamaño en pantalla es la fracción de la altura del viewport que ocupa el diámetro de la
+ * esfera envolvente. El LOD i (i >= 1) se usa cuando ese tamaño, multiplicado por el bias, cae
+ * por debajo de Thresholds[i - 1]. Un bias > 1 mantiene más detalle; < 1 baja antes de LOD.
+ */
+struct LODSettings {
+    static constexpr size_t MaxLevels = 4;
+    static constexpr float Thresholds[MaxLevels - 1] = { 0.25f, 0.12f, 0.05f };
+
+    float bias = 1.0f;
+    float hysteresis = 0.15f; // Margen relativo alrededor de cada umbral
+};
+
+class LODSelector {
+public:
+    // Esfera en espacio de modelo transformada a mundo (radio escalado por la mayor escala del transform).
+    static BoundingSphere TransformSphere(const BoundingSphere& sphere, const glm::mat4& transform) {
+        BoundingSphere world;
+        world.center = glm::vec3(transform * glm::vec4(sphere.center, 1.0f));
+        float scale = std::max({ glm::length(glm::vec3(transform[0])), glm::length(glm::vec3(transform[1])),
+                                 glm::length(glm::vec3(transform[2])) });
+        world.radius = sphere.radius * scale;
+        return world;
+    }
+
+    static float ScreenSize(const BoundingSphere& worldSphere, const glm::vec3& cameraPos, float fovYDegrees) {
+        float distance = glm::length(worldSphere.center - cameraPos);
+        if (distance <= worldSphere.radius)
+            return 1.0f;
+        float halfHeight = distance * std::tan(glm::radians(fovYDegrees) * 0.5f);
+        return worldSphere.radius / halfHeight;
+    }
+
+    // Devuelve el LOD a usar partiendo del actual: solo cambia al cruzar el umbral más el margen.
+    static size_t Select(float screenSize, size_t current, size_t lodCount, const LODSettings& settings) {
+        if (lodCount <= 1)
+            return 0;
+        const float size = screenSize * settings.bias;
+        const size_t levels = std::min(lodCount, LODSettings::MaxLevels);
+        size_t coarser = 0, finer = 0;
+        for (size_t i = 0; i + 1 < levels; ++i) {
+            if (size < LODSettings::Thresholds[i] * (1.0f - settings.hysteresis))
+                coarser = i + 1;
+            if (size < LODSettings::Thresholds[i] * (1.0f + settings.hysteresis))
+                finer = i + 1;
+        }
+        current = std::min(current, levels - 1);
+        if (current < coarser)
+            return coarser;
+        if (current > finer)
+            return finer;
+        return current;
+    }
+};
\ No newline at end of file
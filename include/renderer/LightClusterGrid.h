@@ -0,0 +1,80 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "engine/Light.h"
+#include "renderer/Bounds.h"
+
+class ThreadPool;
+
+// Rango de un cluster dentro de la lista compacta de índices de luz (uvec2 en el shader).
+struct ClusterRange {
+    uint32_t offset = 0;
+    uint32_t count = 0;
+};
+
+// Parámetros de la rejilla para el shader (bloque std140 "LightBlock").
+struct ClusterGridParams {
+    glm::uvec4 gridSize;   // xyz: clusters por eje, w: luces sin rango (al principio de la lista de índices)
+    glm::vec4 depthParams; // x: escala, y: bias del slice logarítmico (slice = log(z) * x + y)
+};
+
+struct ClusterStats {
+    uint32_t lights = 0;        // Luces con rango dentro del frustum
+    uint32_t globalLights = 0;  // Luces sin rango (afectan a todos los clusters)
+    uint32_t references = 0;    // Entradas en la lista de índices de los clusters
+    uint32_t maxPerCluster = 0;
+};
+
+/**
+ * @brief Clustered forward: divide el frustum de la cámara en TilesX x TilesY tiles de pantalla
+ * y Slices cortes de profundidad exponenciales, y asigna a cada cluster las luces cuya esfera
+ * de influencia (posición, rango) toca su AABB en espacio de vista.
+ *
+ * Las luces con rango <= 0 no se cullean: van al principio de la lista de índices para todos
+ * los fragmentos. Build reparte los slices entre los hilos del ThreadPool.
+ */
+class LightClusterGrid {
+public:
+    static constexpr uint32_t TilesX = 16;
+    static constexpr uint32_t TilesY = 9;
+    static constexpr uint32_t Slices = 24;
+    static constexpr uint32_t ClusterCount = TilesX * TilesY * Slices;
+
+    // Recalcula las AABB de los clusters si cambió la proyección (fov vertical en grados).
+    void SetProjection(float fovY, float aspect, float nearPlane, float farPlane);
+
+    void Build(const std::vector<Light>& lights, const glm::mat4& view, ThreadPool* pool = nullptr);
+
+    const std::vector<ClusterRange>& GetClusters() const { return clusters; }
+    const std::vector<uint32_t>& GetLightIndices() const { return lightIndices; }
+    ClusterGridParams GetParams() const;
+    const ClusterStats& GetStats() const { return stats; }
+
+    static uint32_t ClusterIndex(uint32_t x, uint32_t y, uint32_t z) { return (z * TilesY + y) * TilesX + x; }
+    // Cluster de un punto en espacio de vista (misma fórmula que pbr_fragment.glsl).
+    uint32_t FindCluster(const glm::vec3& viewPos) const;
+    const AABB& GetClusterBounds(uint32_t cluster) const { return clusterBounds[cluster]; }
+
+private:
+    struct CulledLight {
+        glm::vec3 center; // Espacio de vista
+        float radius;
+        uint32_t index;
+        uint32_t minX, maxX, minY, maxY;
+    };
+
+    float SliceDepth(uint32_t slice) const;
+
+    float fovY = 0.0f, aspect = 0.0f, nearPlane = 0.0f, farPlane = 0.0f;
+    float tanHalfX = 0.0f, tanHalfY = 0.0f;
+    std::vector<AABB> clusterBounds;
+
+    std::vector<CulledLight> culled;
+    std::vector<std::vector<uint32_t>> sliceLights;   // Luces (índice en culled) que tocan cada slice
+    std::vector<std::vector<uint32_t>> clusterLights; // Listas por cluster antes de compactar
+    std::vector<ClusterRange> clusters;
+    std::vector<uint32_t> lightIndices;
+    ClusterStats stats;
+};
\ No newline at end of file
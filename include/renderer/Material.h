@@ -2,9 +2,23 @@
 #include <memory>
 #include "Texture2D.h"
 #include <glm/glm.hpp>
+#include <cstdint>
+
+// Bits de textureFlags: indican qué mapas tiene el material (deben coincidir con pbr_fragment.glsl).
+enum MaterialTextureFlags : uint32_t
+{
+    MATERIAL_HAS_ALBEDO_MAP = 1u << 0,
+    MATERIAL_HAS_METALLIC_ROUGHNESS_MAP = 1u << 1,
+    MATERIAL_HAS_NORMAL_MAP = 1u << 2,
+    MATERIAL_HAS_OCCLUSION_MAP = 1u << 3,
+    MATERIAL_HAS_EMISSIVE_MAP = 1u << 4
+};
 
 struct Material
 {
+    // Índice del material en la MaterialTable (se asigna al registrarlo).
+    uint32_t id = 0;
+
     // Texturas utilizadas en el material
     std::shared_ptr<Texture2D> albedo;
     std::shared_ptr<Texture2D> metallicRoughness;
@@ -25,4 +39,24 @@ struct Material
     // Propiedades para transmission (KHR_materials_transmission)
     float transmissionFactor = 0.0f;          // Por defecto 0: no transmite luz.
     float ior = 1.45f;                        // Índice de refracción (valor típico para vidrio)
+
+    // alphaMode BLEND de glTF: se dibuja en la pasada forward de transparentes.
+    bool alphaBlend = false;
+
+    uint32_t GetTextureFlags() const
+    {
+        uint32_t flags = 0;
+        if (albedo) flags |= MATERIAL_HAS_ALBEDO_MAP;
+        if (metallicRoughness) flags |= MATERIAL_HAS_METALLIC_ROUGHNESS_MAP;
+        if (normal) flags |= MATERIAL_HAS_NORMAL_MAP;
+        if (occlusion) flags |= MATERIAL_HAS_OCCLUSION_MAP;
+        if (emissive) flags |= MATERIAL_HAS_EMISSIVE_MAP;
+        return flags;
+    }
+
+    // No cabe en el G-buffer (un único valor por píxel): va a la pasada forward tras la iluminación diferida.
+    bool IsTransparent() const { return alphaBlend || baseColorFactor.a < 1.0f || transmissionFactor > 0.0f; }
+
+    // Material solo de parámetros: no requiere bindear ninguna textura.
+    bool HasTextures() const { return GetTextureFlags() != 0; }
 };
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "renderer/Material.h"
+#include "utils/ShaderStorageBuffer.h"
+#include "utils/Logger.h"
+
+/**
+ * @brief Parámetros de un material tal como los lee pbr_fragment.glsl (layout std430, 64 bytes).
+ */
+struct GPUMaterial
+{
+    glm::vec4 baseColorFactor;
+    glm::vec4 emissiveFactor;   // rgb: emisivo, a: ior
+    glm::vec4 pbrParams;        // x: metallic, y: roughness, z: clearcoat, w: clearcoatRoughness
+    float transmissionFactor;
+    uint32_t textureFlags;      // MaterialTextureFlags
+    uint32_t padding[2];
+};
+static_assert(sizeof(GPUMaterial) == 64, "GPUMaterial must match the std430 layout in pbr_fragment.glsl");
+
+/**
+ * @brief Tabla global de materiales. Cada material registrado recibe un ID compacto que
+ * se usa para indexar el SSBO "MaterialBlock" desde el shader y para agrupar draws.
+ * Los materiales se guardan en un deque: los submeshes referencian su entrada sin copiarla.
+ */
+class MaterialTable
+{
+public:
+    static constexpr GLuint BindingPoint = 2;
+
+    static MaterialTable &GetInstance()
+    {
+        static MaterialTable instance;
+        return instance;
+    }
+
+    // Registra el material, le asigna su ID y devuelve la entrada de la tabla (dirección estable hasta Clear).
+    const Material &Register(Material material)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        material.id = static_cast<uint32_t>(materials.size());
+        materials.push_back(std::move(material));
+        const Material &stored = materials.back();
+
+        GPUMaterial gpu{};
+        gpu.baseColorFactor = stored.baseColorFactor;
+        gpu.emissiveFactor = glm::vec4(stored.emissiveFactor, stored.ior);
+        gpu.pbrParams = glm::vec4(stored.metallicFactor, stored.roughnessFactor,
+                                  stored.clearcoatFactor, stored.clearcoatRoughnessFactor);
+        gpu.transmissionFactor = stored.transmissionFactor;
+        gpu.textureFlags = stored.GetTextureFlags();
+        gpuMaterials.push_back(gpu);
+
+        dirty = true;
+        return stored;
+    }
+
+    const Material &Get(uint32_t id) const { return materials[id]; }
+    size_t Size() const { return materials.size(); }
+
+    // Sube la tabla al SSBO si cambió desde la última subida y la enlaza a BindingPoint.
+    void UploadAndBind()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!ssbo)
+            ssbo = std::make_unique<ShaderStorageBuffer>();
+        if (dirty && !gpuMaterials.empty())
+        {
+            ssbo->SetData(static_cast<GLsizeiptr>(gpuMaterials.size() * sizeof(GPUMaterial)),
+                          gpuMaterials.data(), GL_STATIC_DRAW);
+            Logger::Info("[MaterialTable] Uploaded " + std::to_string(gpuMaterials.size()) + " materials");
+            dirty = false;
+        }
+        ssbo->BindToPoint(BindingPoint);
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        materials.clear();
+        gpuMaterials.clear();
+        ssbo.reset();
+        dirty = true;
+    }
+
+private:
+    MaterialTable() = default;
+    MaterialTable(const MaterialTable &) = delete;
+    MaterialTable &operator=(const MaterialTable &) = delete;
+
+    std::deque<Material> materials;
+    std::vector<GPUMaterial> gpuMaterials;
+    std::unique_ptr<ShaderStorageBuffer> ssbo;
+    bool dirty = true;
+    std::mutex mutex;
+};
\ No newline at end of file
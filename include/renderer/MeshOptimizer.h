@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+// Estadísticas de la caché post-transform simulada (FIFO).
+struct VertexCacheStats {
+    float acmr = 0.0f; // Average Cache Miss Ratio: vértices transformados por triángulo (óptimo ~0.5, peor 3)
+    float atvr = 0.0f; // Average Transformed Vertex Ratio: vértices transformados / vértices únicos (óptimo 1)
+};
+
+/**
+ * @brief Optimizaciones de malla al importar (todas trabajan sobre índices uint32):
+ *
+ * 1. GenerateVertexRemap: suelda vértices idénticos byte a byte.
+ * 2. OptimizeVertexCache: reordena triángulos para la caché post-transform (algoritmo de Forsyth).
+ * 3. OptimizeOverdraw: reordena clusters de triángulos de fuera hacia dentro para reducir overdraw
+ *    sin empeorar el ACMR más allá de un umbral.
+ * 4. OptimizeVertexFetch: reordena los vértices en orden de primer uso para mejorar la localidad.
+ */
+class MeshOptimizer {
+public:
+    /**
+     * @brief remap[i] = índice del vértice único que sustituye al vértice i.
+     * @return Número de vértices únicos.
+     */
+    static size_t GenerateVertexRemap(std::vector<uint32_t>& remap, const void* vertices, size_t vertexCount,
+                                      size_t vertexSize);
+
+    // Aplica un remap (de GenerateVertexRemap u OptimizeVertexFetch) a un vector de vértices.
+    template <typename T>
+    static std::vector<T> RemapVertices(const std::vector<T>& vertices, const std::vector<uint32_t>& remap,
+                                        size_t uniqueCount) {
+        std::vector<T> result(uniqueCount);
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            if (remap[i] != UINT32_MAX)
+                result[remap[i]] = vertices[i];
+        }
+        return result;
+    }
+
+    static void RemapIndices(std::vector<uint32_t>& indices, const std::vector<uint32_t>& remap);
+
+    static void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+    /**
+     * @param threshold Máximo empeoramiento permitido del ACMR (1.05 = 5%).
+     */
+    static void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions,
+                                 float threshold = 1.05f);
+
+    /**
+     * @brief Calcula el remap de vértices en orden de primer uso (los no referenciados quedan en UINT32_MAX).
+     * @return Número de vértices referenciados.
+     */
+    static size_t OptimizeVertexFetchRemap(std::vector<uint32_t>& remap, const std::vector<uint32_t>& indices,
+                                           size_t vertexCount);
+
+    static VertexCacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+                                               size_t cacheSize = 16);
+};
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+/**
+ * @brief Simplificación de mallas por colapso de aristas con métrica de error cuádrica (Garland-Heckbert).
+ *
+ * Los vértices no se mueven: cada colapso lleva un vértice sobre uno de sus vecinos, así que el
+ * resultado es un nuevo index buffer sobre el mismo vertex buffer (los LODs comparten VBO).
+ * Los vértices de borde y de costura (misma posición con distintos atributos, p. ej. UVs) quedan
+ * bloqueados para no abrir agujeros ni romper el mapeado.
+ */
+class MeshSimplifier {
+public:
+    /**
+     * @param targetIndexCount Número de índices objetivo (se detiene antes si se supera maxError).
+     * @param maxError Error máximo permitido, relativo a la diagonal de la AABB de la malla.
+     * @param outError Si no es nulo, recibe el error alcanzado (también relativo).
+     */
+    static std::vector<uint32_t> Simplify(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices,
+                                          size_t targetIndexCount, float maxError, float* outError = nullptr);
+};
\ No newline at end of file
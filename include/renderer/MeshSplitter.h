@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Trozo de una malla direccionable con índices de 16 bits.
+ * vertexRemap[local] = índice del vértice en la malla original.
+ */
+struct MeshChunk {
+    std::vector<uint32_t> vertexRemap;
+    std::vector<uint32_t> indices; // Locales al trozo
+};
+
+/**
+ * @brief Divide mallas con más de 65536 vértices en trozos indexables con uint16.
+ *
+ * Recorre los triángulos en orden y abre un trozo nuevo cuando el siguiente triángulo haría
+ * superar maxVertices vértices únicos; con un index buffer coherente los trozos salen compactos.
+ */
+class MeshSplitter {
+public:
+    static constexpr size_t Max16BitVertices = 65536;
+
+    static bool NeedsSplit(size_t vertexCount, size_t maxVertices = Max16BitVertices) {
+        return vertexCount > maxVertices;
+    }
+
+    static std::vector<MeshChunk> Split(size_t vertexCount, const std::vector<uint32_t>& indices,
+                                        size_t maxVertices = Max16BitVertices);
+};
\ No newline at end of file
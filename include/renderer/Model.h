@@ -2,7 +2,11 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include "renderer/Submesh.h"
+#include "renderer/Bounds.h"
+#include "renderer/OcclusionCuller.h"
+#include "renderer/VertexFormat.h"
 #include "utils/Logger.h"
 #include <assimp/scene.h>
 #include <glm/glm.hpp>
@@ -17,21 +21,79 @@ inline glm::mat4 aiMatrix4x4ToGlm(const aiMatrix4x4 &from) {
     return to;
 }
 
+// Opciones de importación por modelo (p. ej. "vertexFormat: compact" en el YAML de entidades).
+struct ModelImportOptions {
+    VertexFormat vertexFormat = VertexFormat::Full;
+    // Soldado de vértices, orden para la caché post-transform, overdraw y fetch (ver MeshOptimizer).
+    bool optimizeMeshes = true;
+    // Conservar vertices/indices en CPU tras subirlos a GPU (colisiones, picking...). Si no, se liberan al cargar.
+    bool keepCPUGeometry = false;
+};
+
+// Nodo de la jerarquía que referencia un submesh: la malla se guarda una vez y se dibuja instanciada.
+struct MeshInstance {
+    uint32_t submesh = 0;
+    glm::mat4 transform{1.0f}; // Transformación acumulada del nodo (espacio del modelo)
+    AABB bounds;               // AABB del submesh con esa transformación
+    glm::mat3 normalMatrix{1.0f}; // Inversa traspuesta de transform (constante: se calcula al importar)
+};
+
+// Oclusor colocado en el modelo (occluder = índice en Model::occluders).
+struct OccluderInstance {
+    uint32_t occluder = 0;
+    glm::mat4 transform{1.0f};
+    AABB bounds;
+};
+
 class Model {
 public:
     // Constructor: carga el modelo desde el archivo especificado
-    Model(const std::string &path);
-
-    // Método para dibujar el modelo
-    void Draw();
+    Model(const std::string &path, const ModelImportOptions &options = ModelImportOptions());
 
-    // Vector de submeshes
+    // Vector de submeshes (mallas únicas en su propio espacio; un aiMesh referenciado por varios nodos aparece una vez)
     std::vector<Submesh> submeshes;
 
+    // Instancias de los submeshes en la jerarquía de nodos, ordenadas por submesh (y por tanto por material).
+    std::vector<MeshInstance> instances;
+
+    // AABB de todo el modelo en espacio local (unión de las de sus instancias).
+    AABB bounds;
+
+    // Submeshes de bajo poligonado copiados como oclusores para el occlusion culling por software.
+    std::vector<OccluderMesh> occluders;
+    std::vector<OccluderInstance> occluderInstances;
+
+    ModelImportOptions importOptions;
+
+    // Memoria de CPU de la geometría residente (copias de submeshes y oclusores).
+    size_t GetResidentCPUBytes() const;
+
 private:
     // Método para cargar el modelo
     void loadModel(const std::string &path);
 
     // Función recursiva para procesar la jerarquía de nodos
     void processNode(aiNode* node, const aiScene* scene, const glm::mat4& parentTransform, const std::string &modelDir);
+
+    // Importa un aiMesh (vértices en su propio espacio) y devuelve los submeshes creados (varios si se divide).
+    std::vector<uint32_t> importMesh(aiMesh* mesh, const aiScene* scene, const std::string &modelDir);
+
+    // Genera LODs, sube a GPU y añade el submesh (ya con índices aptos para 16 bits si procede). Devuelve su índice.
+    uint32_t addSubmesh(Submesh &&submesh);
+
+    // Selecciona los oclusores entre los submeshes ya cargados.
+    void buildOccluders();
+
+    // Estado de la importación: submeshes ya creados por aiMesh y materiales ya cargados por aiMaterial.
+    std::unordered_map<unsigned int, std::vector<uint32_t>> meshSubmeshes;
+    std::unordered_map<unsigned int, const Material*> loadedMaterials;
+
+    // Acumulados de la importación para el informe de ACMR/ATVR antes y después de optimizar.
+    struct OptimizationReport {
+        double missesBefore = 0.0;
+        double missesAfter = 0.0;
+        size_t triangles = 0;
+        size_t verticesBefore = 0;
+        size_t verticesAfter = 0;
+    } optimizationReport;
 };
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include "renderer/Bounds.h"
+
+/**
+ * @brief Geometría simplificada de un oclusor (solo posiciones e índices, en espacio del modelo).
+ * Se copia al importar para no depender de los vértices completos del submesh.
+ */
+struct OccluderMesh {
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    AABB bounds;
+
+    size_t TriangleCount() const { return indices.size() / 3; }
+};
+
+struct OcclusionStats {
+    uint32_t occluders = 0;         // Oclusores rasterizados este frame
+    uint32_t occluderTriangles = 0; // Triángulos rasterizados (tras recorte)
+    uint32_t tested = 0;
+    uint32_t occluded = 0;
+};
+
+/**
+ * @brief Occlusion culling por software en CPU.
+ *
+ * Cada frame se rasterizan unos pocos oclusores de baja resolución en un buffer de profundidad
+ * pequeño (4 píxeles por iteración con SSE2) y después se comprueban las AABB de los objetos
+ * contra él antes de enviarlos a la GPU. La profundidad se guarda como 1/w (mayor = más cerca),
+ * que es lineal en espacio de pantalla y tiene mejor precisión que z/w.
+ *
+ * El test es conservador: un objeto solo se descarta si todo su rectángulo en pantalla está
+ * cubierto por oclusores más cercanos que el punto más cercano de su caja.
+ */
+class OcclusionCuller {
+public:
+    static constexpr int DefaultWidth = 256;
+    static constexpr int DefaultHeight = 144;
+    // Los submeshes con más triángulos no se usan como oclusores.
+    static constexpr size_t MaxOccluderTriangles = 1024;
+
+    OcclusionCuller(int width = DefaultWidth, int height = DefaultHeight);
+
+    // Limpia el buffer y fija la matriz view-projection del frame.
+    void BeginFrame(const glm::mat4& viewProj);
+    // Rasteriza un oclusor con la transformación de modelo dada.
+    void RasterizeOccluder(const OccluderMesh& occluder, const glm::mat4& model);
+    void RasterizeTriangles(const glm::vec3* positions, size_t vertexCount, const uint32_t* indices,
+                            size_t indexCount, const glm::mat4& model);
+    // false si la caja (en mundo) queda completamente oculta por lo ya rasterizado.
+    bool IsVisible(const AABB& worldBox);
+    // Mismo test sin tocar las estadísticas: se puede llamar desde varios hilos tras rasterizar.
+    // Quien lo use suma sus resultados con AddTestStats.
+    bool TestAABB(const AABB& worldBox) const;
+    void AddTestStats(uint32_t tested, uint32_t occluded) {
+        stats.tested += tested;
+        stats.occluded += occluded;
+    }
+
+    const OcclusionStats& GetStats() const { return stats; }
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+    // Profundidad (1/w) por píxel, fila 0 abajo; 0 = vacío.
+    const std::vector<float>& GetDepthBuffer() const { return depth; }
+
+    // Copia como oclusor un submesh si es de bajo poligonado y suficientemente grande respecto al modelo.
+    static bool BuildOccluder(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices,
+                              const AABB& modelBounds, OccluderMesh& out);
+
+private:
+    struct ScreenVertex {
+        float x, y; // Píxeles
+        float invW;
+    };
+
+    int width;
+    int height;
+    std::vector<float> depth;
+    glm::mat4 viewProj{1.0f};
+    OcclusionStats stats;
+    std::vector<glm::vec4> clipScratch;
+
+    void RasterizeClipTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+    void RasterizeScreenTriangle(ScreenVertex v0, ScreenVertex v1, ScreenVertex v2);
+    ScreenVertex ToScreen(const glm::vec4& clip) const;
+};
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstring>
+#include <string>
+#include "utils/Logger.h"
+
+// GL_KHR_parallel_shader_compile / GL_ARB_parallel_shader_compile (no incluidas en el loader de glad).
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+/**
+ * @brief Compilación de shaders en hilos del driver.
+ *
+ * Con la extensión, glGetProgramiv(GL_COMPLETION_STATUS_KHR) indica sin esperar si un programa enviado
+ * con Shader::Submit ha terminado; sin ella, cualquier consulta de estado bloquea hasta que acabe.
+ */
+class ParallelShaderCompile {
+public:
+    // Requiere contexto GL. loader: el mismo que recibe gladLoadGLLoader.
+    static void Configure(GLADloadproc loader) {
+        bool khr = false, arb = false;
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i) {
+            const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+            if (!name)
+                continue;
+            khr |= std::strcmp(name, "GL_KHR_parallel_shader_compile") == 0;
+            arb |= std::strcmp(name, "GL_ARB_parallel_shader_compile") == 0;
+        }
+        supported = khr || arb;
+        if (!supported) {
+            Logger::Info("[ParallelShaderCompile] Not supported: programs finish synchronously");
+            return;
+        }
+        // 0xFFFFFFFF: el driver decide el número de hilos.
+        using MaxShaderCompilerThreadsProc = void (APIENTRYP)(GLuint);
+        auto maxThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(
+            loader(khr ? "glMaxShaderCompilerThreadsKHR" : "glMaxShaderCompilerThreadsARB"));
+        if (maxThreads)
+            maxThreads(0xFFFFFFFFu);
+        Logger::Info(std::string("[ParallelShaderCompile] Enabled (") + (khr ? "KHR" : "ARB") + ")");
+    }
+
+    static bool IsSupported() { return supported; }
+
+private:
+    static inline bool supported = false;
+};
\ No newline at end of file
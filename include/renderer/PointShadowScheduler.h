@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "renderer/Bounds.h"
+
+struct PointShadowSettings {
+    uint32_t slotCount = 8;       // Cubos en el atlas (luces con sombra a la vez)
+    uint32_t resolution = 512;    // Texels por lado de cada cara
+    uint32_t faceBudget = 12;     // Caras renderizadas por frame como máximo
+    float nearPlane = 0.05f;
+    float defaultRange = 50.0f;   // Alcance de la sombra de luces sin rango
+};
+
+// Luz candidata a sombra: índice en el LightBuffer, posición y alcance de la sombra.
+struct ShadowLight {
+    uint32_t light;
+    glm::vec3 position;
+    float range;
+};
+
+// Caras (bit i: cara i en el orden de GL, +X -X +Y -Y +Z -Z) a renderizar de un slot del atlas.
+struct PointShadowRequest {
+    uint32_t light;
+    uint32_t slot;
+    uint8_t faces;
+};
+
+struct PointShadowStats {
+    uint32_t shadowedLights = 0; // Luces con slot
+    uint32_t dirtyLights = 0;    // Con alguna cara pendiente antes de aplicar el presupuesto
+    uint32_t renderedFaces = 0;
+    uint32_t pendingFaces = 0;   // Aplazadas por el presupuesto (se usa el mapa anterior)
+};
+
+/**
+ * @brief Reparte los slots del atlas de sombras de luces puntuales y decide qué caras refrescar.
+ *
+ * Una cara solo se marca como sucia cuando una caja que se movió (posición anterior o nueva)
+ * entra en su pirámide dentro del radio de la luz, o cuando la luz cambia o recibe slot.
+ * Cada frame se renderizan como mucho faceBudget caras, primero las de las luces que más
+ * llevan esperando y luego las más cercanas a la cámara; el resto reutiliza su mapa anterior.
+ */
+class PointShadowScheduler {
+public:
+    static constexpr uint8_t AllFaces = 0x3F;
+
+    void SetSettings(const PointShadowSettings& settings);
+    const PointShadowSettings& GetSettings() const { return settings; }
+
+    // movedBounds: AABB en mundo (antes y después) de los oclusores que cambiaron este frame.
+    void Schedule(const std::vector<ShadowLight>& lights, const std::vector<AABB>& movedBounds,
+                  const glm::vec3& cameraPos, std::vector<PointShadowRequest>& out);
+
+    // Slot del atlas de una luz (índice en el LightBuffer), o -1 si no tiene sombra.
+    int GetSlot(uint32_t light) const;
+    const PointShadowStats& GetStats() const { return stats; }
+
+    // Caras del cubo centrado en lightPos cuya pirámide toca la caja (conservador).
+    static uint8_t FacesTouched(const glm::vec3& lightPos, float range, const AABB& box);
+
+private:
+    struct LightState {
+        uint32_t light = 0;
+        glm::vec3 position{0.0f};
+        float range = 0.0f;
+        uint8_t pendingFaces = 0;
+        uint32_t waitFrames = 0;
+        float priority = 0.0f; // Distancia de la esfera de la luz a la cámara
+    };
+
+    PointShadowSettings settings;
+    std::vector<LightState> slots;     // Un estado por slot
+    std::vector<uint8_t> slotUsed;
+    std::vector<uint32_t> order;
+    PointShadowStats stats;
+};
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "utils/Logger.h"
+
+/**
+ * @brief Caché en disco de programas enlazados (glGetProgramBinary / glProgramBinary).
+ *
+ * La clave es un FNV-1a de los fuentes ya preprocesados (con los defines de la variante) y de las
+ * cadenas GL_VENDOR / GL_RENDERER / GL_VERSION: un cambio de shader o de driver da otra clave. Si el
+ * driver rechaza un binario (actualización con la misma versión, formato distinto) se compila desde
+ * el fuente y se sobrescribe la entrada.
+ */
+class ProgramBinaryCache {
+public:
+    static ProgramBinaryCache& GetInstance() {
+        static ProgramBinaryCache instance;
+        return instance;
+    }
+
+    // Requiere contexto GL. Directorio vacío o driver sin formatos binarios: caché desactivada.
+    void Configure(const std::string& cacheDirectory) {
+        directory = cacheDirectory;
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        enabled = !directory.empty() && formats > 0;
+        if (!enabled) {
+            Logger::Info("[ProgramBinaryCache] Disabled (" + std::string(directory.empty() ? "no directory" : "no binary formats") + ")");
+            return;
+        }
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (error) {
+            Logger::Warning("[ProgramBinaryCache] Cannot create " + directory + ": " + error.message());
+            enabled = false;
+            return;
+        }
+        driverHash = Fnv1a(reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+        driverHash = Fnv1a(reinterpret_cast<const char*>(glGetString(GL_RENDERER)), driverHash);
+        driverHash = Fnv1a(reinterpret_cast<const char*>(glGetString(GL_VERSION)), driverHash);
+        Logger::Info("[ProgramBinaryCache] Using " + directory + " (" + std::to_string(formats) + " binary formats)");
+    }
+
+    bool IsEnabled() const { return enabled; }
+
+    static uint64_t Fnv1a(const std::string& data, uint64_t hash = 14695981039346656037ull) {
+        for (unsigned char c : data) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        // Separador: ("ab", "c") y ("a", "bc") no deben dar la misma clave.
+        hash ^= 0xFFu;
+        hash *= 1099511628211ull;
+        return hash;
+    }
+
+    uint64_t Key(const std::string& vertexCode, const std::string& fragmentCode) const {
+        return Fnv1a(fragmentCode, Fnv1a(vertexCode, driverHash));
+    }
+
+    // Carga el binario en program. false si no hay entrada o el driver la rechaza (el programa queda sin enlazar).
+    bool Load(GLuint program, uint64_t key) {
+        if (!enabled)
+            return false;
+        std::ifstream file(PathFor(key), std::ios::binary);
+        if (!file)
+            return false;
+        Header header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || header.magic != Magic || header.key != key) {
+            Logger::Warning("[ProgramBinaryCache] Ignoring invalid entry " + PathFor(key));
+            return false;
+        }
+        std::vector<char> binary((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+        GLint linked = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            Logger::Info("[ProgramBinaryCache] Driver rejected " + PathFor(key) + ", recompiling from source");
+            return false;
+        }
+        return true;
+    }
+
+    // Guarda el programa enlazado (creado con GL_PROGRAM_BINARY_RETRIEVABLE_HINT).
+    void Store(GLuint program, uint64_t key) {
+        if (!enabled)
+            return;
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+            return;
+        std::vector<char> binary(static_cast<size_t>(length));
+        Header header{ Magic, 0, key };
+        glGetProgramBinary(program, length, nullptr, &header.format, binary.data());
+        // Escribir a un temporal y renombrar: un cierre a medias no deja una entrada truncada.
+        std::string path = PathFor(key);
+        std::string temp = path + ".tmp";
+        {
+            std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+            if (!file) {
+                Logger::Warning("[ProgramBinaryCache] Failed to write " + temp);
+                return;
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(temp, path, error);
+        if (error)
+            Logger::Warning("[ProgramBinaryCache] Failed to store " + path + ": " + error.message());
+    }
+
+private:
+    struct Header {
+        uint32_t magic;
+        GLenum format;
+        uint64_t key;
+    };
+    static constexpr uint32_t Magic = 0x31425054; // "TPB1"
+
+    ProgramBinaryCache() = default;
+
+    std::string PathFor(uint64_t key) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+        return (std::filesystem::path(directory) / name).generic_string();
+    }
+
+    std::string directory;
+    bool enabled = false;
+    uint64_t driverHash = 14695981039346656037ull;
+};
\ No newline at end of file
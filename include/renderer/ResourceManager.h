@@ -17,15 +17,21 @@ public:
     static std::shared_ptr<Shader> LoadShaderWithFragment(const std::string& fragmentShaderName, const std::string& key);
 
     static std::shared_ptr<Texture2D> LoadTexture(const char* file, bool alpha, std::string name);
-    static std::shared_ptr<Model> LoadModel(const char* file, std::string name);
+    static std::shared_ptr<Model> LoadModel(const char* file, std::string name,
+                                            const ModelImportOptions& options = ModelImportOptions());
 
     // Funciones asíncronas
     static std::future<std::shared_ptr<Texture2D>> LoadTextureAsync(const char* file, bool alpha, std::string name);
-    static std::future<std::shared_ptr<Model>> LoadModelAsync(const char* file, std::string name);
+    static std::future<std::shared_ptr<Model>> LoadModelAsync(const char* file, std::string name,
+                                                              const ModelImportOptions& options = ModelImportOptions());
 
     static std::shared_ptr<Shader> GetShader(const std::string& name);
     static std::shared_ptr<Texture2D> GetTexture(const std::string& name);
-    static std::shared_ptr<Model> GetModel(const std::string& name);
+    static std::shared_ptr<Model> GetModel(const std::string& name,
+                                           const ModelImportOptions& options = ModelImportOptions());
+    // Clave de la caché de modelos: el mismo archivo importado con otras opciones es otro modelo.
+    // Con las opciones por defecto es name tal cual.
+    static std::string ModelKey(const std::string& name, const ModelImportOptions& options);
 
     static const Config& GetConfig() { return m_Config; }
 
@@ -4,6 +4,9 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <unordered_map>
+#include "renderer/ParallelShaderCompile.h"
+#include "renderer/ProgramBinaryCache.h"
 #include "utils/Logger.h"
 
 class Shader {
@@ -12,7 +15,16 @@ public:
     
     Shader() = default;
     
-    void Compile(const char* vertexPath, const char* fragmentPath) {
+    // defines: líneas "#define ..." que se insertan tras el #version de ambos shaders (variantes).
+    // Bloqueante: equivale a Submit seguido de Finish.
+    void Compile(const char* vertexPath, const char* fragmentPath, const std::string& defines = "") {
+        Submit(vertexPath, fragmentPath, defines);
+        Finish();
+    }
+    
+    // Envía compilación y enlazado al driver sin consultar su estado (consultarlo obliga a esperar).
+    // El programa no se puede usar hasta que Poll o Finish lo den por terminado.
+    void Submit(const char* vertexPath, const char* fragmentPath, const std::string& defines = "") {
         std::string vertexCode, fragmentCode;
         std::ifstream vShaderFile, fShaderFile;
         vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
@@ -26,62 +38,177 @@ public:
             std::stringstream vShaderStream, fShaderStream;
             vShaderStream << vShaderFile.rdbuf();
             fShaderStream << fShaderFile.rdbuf();
-            vertexCode = vShaderStream.str();
-            fragmentCode = fShaderStream.str();
+            vertexCode = InjectDefines(vShaderStream.str(), defines);
+            fragmentCode = InjectDefines(fShaderStream.str(), defines);
             vShaderFile.close();
             fShaderFile.close();
         } catch (std::ifstream::failure&) {
             Logger::Error("[Shader] ERROR: Failed to read shader files");
         }
         
+        // Programa enlazado en una ejecución anterior con los mismos fuentes y driver: sin compilar.
+        ProgramBinaryCache& binaryCache = ProgramBinaryCache::GetInstance();
+        binaryKey = binaryCache.Key(vertexCode, fragmentCode);
+        if (binaryCache.IsEnabled()) {
+            ID = glCreateProgram();
+            if (binaryCache.Load(ID, binaryKey)) {
+                Logger::Info("[Shader] Program loaded from binary cache. ID: " + std::to_string(ID));
+                ReflectUniforms();
+                ready = true;
+                linked = true;
+                return;
+            }
+            glDeleteProgram(ID);
+        }
+        
         const char* vShaderCode = vertexCode.c_str();
         const char* fShaderCode = fragmentCode.c_str();
-        unsigned int vertex, fragment;
+        pendingVertex = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(pendingVertex, 1, &vShaderCode, nullptr);
+        glCompileShader(pendingVertex);
+        pendingFragment = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(pendingFragment, 1, &fShaderCode, nullptr);
+        glCompileShader(pendingFragment);
+        
+        // El enlazado se encola tras las compilaciones; los errores se recogen en Finish.
+        ID = glCreateProgram();
+        glAttachShader(ID, pendingVertex);
+        glAttachShader(ID, pendingFragment);
+        glProgramParameteri(ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        glLinkProgram(ID);
+        ready = false;
+        linked = false;
+    }
+    
+    // Sin bloquear: true si el programa está listo (terminándolo si el driver acabó). Sin
+    // KHR_parallel_shader_compile no hay forma de saberlo sin esperar, así que termina siempre.
+    bool Poll() {
+        if (ready)
+            return true;
+        if (ParallelShaderCompile::IsSupported()) {
+            GLint completed = GL_FALSE;
+            glGetProgramiv(ID, GL_COMPLETION_STATUS_KHR, &completed);
+            if (!completed)
+                return false;
+        }
+        Finish();
+        return true;
+    }
+    
+    // Espera al driver, registra los errores de compilación/enlazado y deja el programa listo para usar.
+    bool Finish() {
+        if (ready)
+            return linked;
         int success;
         char infoLog[512];
-        
-        // Vertex shader
-        vertex = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(vertex, 1, &vShaderCode, nullptr);
-        glCompileShader(vertex);
-        glGetShaderiv(vertex, GL_COMPILE_STATUS, &success);
+        glGetShaderiv(pendingVertex, GL_COMPILE_STATUS, &success);
         if (!success) {
-            glGetShaderInfoLog(vertex, 512, nullptr, infoLog);
+            glGetShaderInfoLog(pendingVertex, 512, nullptr, infoLog);
             Logger::Error("[Shader] Vertex compilation failed:\n" + std::string(infoLog));
-        } else {
-            Logger::Info("[Shader] Vertex shader compiled");
         }
-        
-        // Fragment shader
-        fragment = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragment, 1, &fShaderCode, nullptr);
-        glCompileShader(fragment);
-        glGetShaderiv(fragment, GL_COMPILE_STATUS, &success);
+        glGetShaderiv(pendingFragment, GL_COMPILE_STATUS, &success);
         if (!success) {
-            glGetShaderInfoLog(fragment, 512, nullptr, infoLog);
+            glGetShaderInfoLog(pendingFragment, 512, nullptr, infoLog);
             Logger::Error("[Shader] Fragment compilation failed:\n" + std::string(infoLog));
-        } else {
-            Logger::Info("[Shader] Fragment shader compiled");
         }
-        
-        // Shader program
-        ID = glCreateProgram();
-        glAttachShader(ID, vertex);
-        glAttachShader(ID, fragment);
-        glLinkProgram(ID);
         glGetProgramiv(ID, GL_LINK_STATUS, &success);
         if (!success) {
             glGetProgramInfoLog(ID, 512, nullptr, infoLog);
             Logger::Error("[Shader] Linking failed:\n" + std::string(infoLog));
         } else {
             Logger::Info("[Shader] Program linked. ID: " + std::to_string(ID));
+            ReflectUniforms();
+            ProgramBinaryCache::GetInstance().Store(ID, binaryKey);
         }
         
-        glDeleteShader(vertex);
-        glDeleteShader(fragment);
+        glDeleteShader(pendingVertex);
+        glDeleteShader(pendingFragment);
+        pendingVertex = 0;
+        pendingFragment = 0;
+        ready = true;
+        linked = success != 0;
+        return linked;
     }
     
+    bool IsReady() const { return ready; }
+    // Terminado y enlazado sin errores: un programa listo que falló no se debe usar.
+    bool IsLinked() const { return ready && linked; }
+    
     void Use() {
         glUseProgram(ID);
     }
+
+    // Inserta defines justo después de la línea #version (que debe seguir siendo la primera).
+    static std::string InjectDefines(const std::string& source, const std::string& defines) {
+        if (defines.empty())
+            return source;
+        size_t version = source.find("#version");
+        if (version == std::string::npos)
+            return defines + source;
+        size_t lineEnd = source.find('\n', version);
+        if (lineEnd == std::string::npos)
+            return source + "\n" + defines;
+        return source.substr(0, lineEnd + 1) + defines + source.substr(lineEnd + 1);
+    }
+
+    // Devuelve la ubicación cacheada de una uniform (-1 si no existe o fue eliminada por el compilador).
+    // Pensado para usarse al inicializar; el código por frame debe guardar el entero devuelto.
+    int GetUniformLocation(const std::string& name) const {
+        auto it = uniformLocations.find(name);
+        return it != uniformLocations.end() ? it->second : -1;
+    }
+
+    // Asocia un uniform block del programa a un binding point. Devuelve false si el bloque no existe.
+    bool BindUniformBlock(const char* blockName, GLuint bindingPoint) {
+        GLuint blockIndex = glGetUniformBlockIndex(ID, blockName);
+        if (blockIndex == GL_INVALID_INDEX)
+            return false;
+        glUniformBlockBinding(ID, blockIndex, bindingPoint);
+        return true;
+    }
+
+    // Asocia un shader storage block del programa a un binding point. Devuelve false si no existe.
+    bool BindStorageBlock(const char* blockName, GLuint bindingPoint) {
+        GLuint blockIndex = glGetProgramResourceIndex(ID, GL_SHADER_STORAGE_BLOCK, blockName);
+        if (blockIndex == GL_INVALID_INDEX)
+            return false;
+        glShaderStorageBlockBinding(ID, blockIndex, bindingPoint);
+        return true;
+    }
+
+private:
+    std::unordered_map<std::string, int> uniformLocations;
+    // Estado entre Submit y Finish.
+    GLuint pendingVertex = 0;
+    GLuint pendingFragment = 0;
+    uint64_t binaryKey = 0;
+    bool ready = false;
+    bool linked = false;
+
+    // Recorre las uniforms activas tras el linkado y cachea sus ubicaciones.
+    // Las uniforms que viven dentro de un uniform block no tienen ubicación y se omiten.
+    void ReflectUniforms() {
+        uniformLocations.clear();
+        GLint count = 0, maxLength = 0;
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+        std::string name(static_cast<size_t>(maxLength > 0 ? maxLength : 1), '\0');
+        for (GLint i = 0; i < count; ++i) {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(ID, static_cast<GLuint>(i), maxLength, &length, &size, &type, &name[0]);
+            std::string uniformName(name.c_str(), static_cast<size_t>(length));
+            GLint location = glGetUniformLocation(ID, uniformName.c_str());
+            if (location < 0)
+                continue;
+            uniformLocations[uniformName] = location;
+            // Los arrays se exponen como "nombre[0]"; se registra también el nombre base.
+            size_t bracket = uniformName.find("[0]");
+            if (bracket != std::string::npos)
+                uniformLocations[uniformName.substr(0, bracket)] = location;
+        }
+        Logger::Debug("[Shader] Reflected " + std::to_string(uniformLocations.size()) +
+                      " uniform locations for program " + std::to_string(ID));
+    }
 };
\ No newline at end of file
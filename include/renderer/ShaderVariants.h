@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "renderer/Shader.h"
+#include "renderer/Material.h"
+#include "utils/GLDebug.h"
+#include "utils/Logger.h"
+
+// Features de una variante de pbr_fragment.glsl / gbuffer_fragment.glsl (cada una es un #define).
+enum ShaderVariantFeature : uint32_t
+{
+    VARIANT_ALBEDO_MAP = 1u << 0,   // HAS_ALBEDO_MAP
+    VARIANT_MR_MAP = 1u << 1,       // HAS_MR_MAP
+    VARIANT_NORMAL_MAP = 1u << 2,   // HAS_NORMAL_MAP
+    VARIANT_EMISSIVE_MAP = 1u << 3, // HAS_EMISSIVE_MAP
+    VARIANT_ALPHA_BLEND = 1u << 4   // ALPHA_MODE = ALPHA_MODE_BLEND (si no, ALPHA_MODE_OPAQUE)
+};
+
+/**
+ * @brief Clave de una variante: features del material y máximo de luces por cluster (MAX_LIGHTS).
+ */
+struct ShaderVariantKey {
+    uint32_t features = 0;
+    uint32_t maxLights = 0;
+
+    // La variante más ligera que cubre el material: solo los mapas que tiene y blending si es transparente.
+    static ShaderVariantKey ForMaterial(const Material& material, uint32_t maxLights) {
+        ShaderVariantKey key;
+        uint32_t flags = material.GetTextureFlags();
+        if (flags & MATERIAL_HAS_ALBEDO_MAP)
+            key.features |= VARIANT_ALBEDO_MAP;
+        if (flags & MATERIAL_HAS_METALLIC_ROUGHNESS_MAP)
+            key.features |= VARIANT_MR_MAP;
+        if (flags & MATERIAL_HAS_NORMAL_MAP)
+            key.features |= VARIANT_NORMAL_MAP;
+        if (flags & MATERIAL_HAS_EMISSIVE_MAP)
+            key.features |= VARIANT_EMISSIVE_MAP;
+        if (material.IsTransparent())
+            key.features |= VARIANT_ALPHA_BLEND;
+        key.maxLights = maxLights;
+        return key;
+    }
+
+    uint64_t Hash() const { return (static_cast<uint64_t>(maxLights) << 32) | features; }
+    bool operator==(const ShaderVariantKey& other) const { return Hash() == other.Hash(); }
+
+    std::string Defines() const {
+        std::string defines = "#define SHADER_VARIANT\n";
+        if (features & VARIANT_ALBEDO_MAP)
+            defines += "#define HAS_ALBEDO_MAP\n";
+        if (features & VARIANT_MR_MAP)
+            defines += "#define HAS_MR_MAP\n";
+        if (features & VARIANT_NORMAL_MAP)
+            defines += "#define HAS_NORMAL_MAP\n";
+        if (features & VARIANT_EMISSIVE_MAP)
+            defines += "#define HAS_EMISSIVE_MAP\n";
+        defines += (features & VARIANT_ALPHA_BLEND) ? "#define ALPHA_MODE ALPHA_MODE_BLEND\n"
+                                                     : "#define ALPHA_MODE ALPHA_MODE_OPAQUE\n";
+        defines += "#define MAX_LIGHTS " + std::to_string(maxLights) + "u\n";
+        return defines;
+    }
+
+    // Nombre legible para logs, p. ej. "albedo+mr+normal/opaque/64".
+    std::string Name() const {
+        std::string name;
+        const char* names[] = { "albedo", "mr", "normal", "emissive" };
+        for (int i = 0; i < 4; ++i) {
+            if (features & (1u << i))
+                name += (name.empty() ? "" : "+") + std::string(names[i]);
+        }
+        if (name.empty())
+            name = "factors";
+        name += (features & VARIANT_ALPHA_BLEND) ? "/blend/" : "/opaque/";
+        return name + std::to_string(maxLights);
+    }
+};
+
+/**
+ * @brief Variantes de un par vertex/fragment compiladas bajo demanda y cacheadas por clave.
+ *
+ * Request envía la compilación sin esperar y Update recoge las terminadas (ver ParallelShaderCompile);
+ * TryGetVariant no bloquea nunca, GetVariant sí. Una variante que no compila o no enlaza no se devuelve
+ * nunca (se registra una vez): quien dibuja sigue con el ubershader. Los callbacks de AddSetup (bindings de bloques,
+ * samplers...) se aplican a cada variante al terminarla, y a las ya terminadas al registrarlos.
+ */
+class ShaderVariantCache {
+public:
+    ShaderVariantCache(std::string vertex, std::string fragment, std::string cacheName, uint32_t lightsPerCluster)
+        : vertexPath(std::move(vertex)), fragmentPath(std::move(fragment)), name(std::move(cacheName)),
+          maxLights(lightsPerCluster) { }
+
+    ShaderVariantCache(const ShaderVariantCache&) = delete;
+    ShaderVariantCache& operator=(const ShaderVariantCache&) = delete;
+
+    void AddSetup(std::function<void(Shader&)> setup) {
+        for (auto& [hash, shader] : variants) {
+            if (shader->IsLinked())
+                setup(*shader);
+        }
+        setups.push_back(std::move(setup));
+    }
+
+    ShaderVariantKey KeyFor(const Material& material) const { return ShaderVariantKey::ForMaterial(material, maxLights); }
+
+    // Envía la compilación de la variante si aún no existe.
+    void Request(const ShaderVariantKey& key) {
+        if (variants.count(key.Hash()))
+            return;
+        auto shader = std::make_shared<Shader>();
+        shader->Submit(vertexPath.c_str(), fragmentPath.c_str(), key.Defines());
+        variants.emplace(key.Hash(), shader);
+        if (shader->IsReady())
+            FinishVariant(*shader, key); // Cargada de la caché de binarios
+        else
+            pending.push_back({ key, shader });
+    }
+
+    // La variante si ya está lista y enlazada; si no, la pide y devuelve nullptr.
+    Shader* TryGetVariant(const ShaderVariantKey& key) {
+        auto it = variants.find(key.Hash());
+        if (it == variants.end()) {
+            Request(key);
+            it = variants.find(key.Hash());
+        }
+        return it->second->IsLinked() ? it->second.get() : nullptr;
+    }
+
+    // Bloqueante: termina la variante si hace falta. nullptr si falló.
+    Shader* GetVariant(const ShaderVariantKey& key) {
+        Request(key);
+        for (size_t i = 0; i < pending.size(); ++i) {
+            if (pending[i].key == key) {
+                pending[i].shader->Finish();
+                FinishVariant(*pending[i].shader, key);
+                pending.erase(pending.begin() + static_cast<std::ptrdiff_t>(i));
+                break;
+            }
+        }
+        Shader* shader = variants.at(key.Hash()).get();
+        return shader->IsLinked() ? shader : nullptr;
+    }
+
+    // Una vez por frame: recoge las variantes que el driver terminó. Sin compilación paralela cada
+    // consulta bloquea, así que se termina como mucho una por llamada para repartir el coste.
+    void Update() {
+        size_t kept = 0;
+        bool finishedOne = false;
+        for (size_t i = 0; i < pending.size(); ++i) {
+            PendingVariant& entry = pending[i];
+            bool mayBlock = !ParallelShaderCompile::IsSupported();
+            if ((!mayBlock || !finishedOne) && entry.shader->Poll()) {
+                FinishVariant(*entry.shader, entry.key);
+                finishedOne = true;
+                continue;
+            }
+            pending[kept++] = entry;
+        }
+        pending.resize(kept);
+    }
+
+    Shader* GetVariant(const Material& material) { return GetVariant(KeyFor(material)); }
+
+    size_t GetVariantCount() const { return variants.size(); }
+    size_t GetPendingCount() const { return pending.size(); }
+    uint32_t GetMaxLights() const { return maxLights; }
+
+    // Borra los programas (SceneResources::Clear). Las pendientes se terminan para liberar sus shaders.
+    void Clear() {
+        for (auto& entry : pending)
+            entry.shader->Finish();
+        for (auto& [hash, shader] : variants)
+            GLCall(glDeleteProgram(shader->ID));
+        variants.clear();
+        pending.clear();
+    }
+
+private:
+    struct PendingVariant {
+        ShaderVariantKey key;
+        std::shared_ptr<Shader> shader;
+    };
+
+    // Se llama una vez por variante: también es donde se avisa de las que fallaron.
+    void FinishVariant(Shader& shader, const ShaderVariantKey& key) {
+        if (!shader.IsLinked()) {
+            Logger::Error("[ShaderVariantCache] " + name + ": variant " + key.Name() +
+                          " failed to compile or link, drawing its materials with the fallback shader");
+            return;
+        }
+        for (auto& setup : setups)
+            setup(shader);
+        Logger::Info("[ShaderVariantCache] " + name + ": variant " + key.Name() + " ready (ID: " +
+                     std::to_string(shader.ID) + ", " + std::to_string(pending.size()) + " pending)");
+    }
+
+    std::string vertexPath;
+    std::string fragmentPath;
+    std::string name;
+    uint32_t maxLights;
+    std::unordered_map<uint64_t, std::shared_ptr<Shader>> variants;
+    std::vector<PendingVariant> pending;
+    std::vector<std::function<void(Shader&)>> setups;
+};
\ No newline at end of file
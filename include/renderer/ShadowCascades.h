@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+struct ShadowCascadeSettings {
+    uint32_t cascadeCount = 4;
+    uint32_t resolution = 2048;   // Texels por lado de cada cascada
+    float maxDistance = 100.0f;   // Profundidad de vista máxima con sombras
+    float splitLambda = 0.75f;    // Mezcla entre reparto logarítmico (1) y uniforme (0)
+    float coverageMargin = 1.25f; // Radio colocado / radio del slice: holgura para reutilizar la caché estática
+};
+
+struct ShadowCascade {
+    glm::mat4 viewProj{1.0f};     // Render y muestreo (profundidad ajustada a la esfera; con GL_DEPTH_CLAMP)
+    glm::mat4 cullViewProj{1.0f}; // Igual pero extendida hacia la luz: oclusores fuera de la vista
+    glm::vec3 center{0.0f};       // Centro colocado en espacio de luz (ajustado a texel)
+    float radius = 0.0f;          // Semilado de la proyección ortográfica
+    float splitNear = 0.0f;       // Rango de profundidad de vista que cubre
+    float splitFar = 0.0f;
+    uint32_t version = 0;         // Cambia en cada recolocación (invalida la caché estática)
+};
+
+/**
+ * @brief Cascadas de sombra de una luz direccional.
+ *
+ * Cada slice del frustum de la cámara se envuelve en una esfera (radio independiente de la
+ * orientación) y la cascada se coloca sobre ella ampliada por coverageMargin, con el centro
+ * ajustado a texels en espacio de luz. La colocación se conserva mientras la esfera del slice
+ * siga dentro: ni parpadeo al mover la cámara ni re-render de los oclusores estáticos.
+ */
+class ShadowCascades {
+public:
+    static constexpr uint32_t MaxCascades = 4;
+
+    void SetSettings(const ShadowCascadeSettings& settings);
+    const ShadowCascadeSettings& GetSettings() const { return settings; }
+
+    // Devuelve una máscara (bit i: cascada i) de las cascadas recolocadas en esta llamada.
+    uint32_t Update(const glm::mat4& view, float fovY, float aspect, float nearPlane, float farPlane,
+                    const glm::vec3& lightDirection);
+
+    uint32_t GetCascadeCount() const { return settings.cascadeCount; }
+    const ShadowCascade& GetCascade(uint32_t index) const { return cascades[index]; }
+    // Primera cascada cuyo splitFar alcanza la profundidad (misma regla que el shader); -1 si ninguna.
+    int FindCascade(float viewDepth) const;
+    float GetTexelSize(uint32_t index) const { return 2.0f * cascades[index].radius / settings.resolution; }
+
+private:
+    ShadowCascadeSettings settings;
+    ShadowCascade cascades[MaxCascades];
+    bool placed[MaxCascades] = {};
+    glm::mat4 lightRotation{1.0f};
+    glm::vec3 lightDirection{0.0f};
+};
\ No newline at end of file
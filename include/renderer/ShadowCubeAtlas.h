@@ -0,0 +1,77 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <string>
+#include "utils/GLDebug.h"
+#include "utils/Logger.h"
+
+/**
+ * @brief Atlas de sombras de luces puntuales: un cube map array de profundidad con un cubo por slot
+ * (capa slot * 6 + cara). Se muestrea como samplerCubeArrayShadow.
+ */
+class ShadowCubeAtlas {
+public:
+    ShadowCubeAtlas() = default;
+    ~ShadowCubeAtlas() { Release(); }
+
+    ShadowCubeAtlas(const ShadowCubeAtlas&) = delete;
+    ShadowCubeAtlas& operator=(const ShadowCubeAtlas&) = delete;
+
+    // Crea o recrea el atlas si cambió el tamaño. Devuelve true si se recreó (todo su contenido se pierde).
+    bool Resize(int size, int slotCount) {
+        if (size == resolution && slotCount == slots && fbo != 0)
+            return false;
+        Release();
+        resolution = size;
+        slots = slotCount;
+
+        GLCall(glGenTextures(1, &texture));
+        GLCall(glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, texture));
+        GLCall(glTexStorage3D(GL_TEXTURE_CUBE_MAP_ARRAY, 1, GL_DEPTH_COMPONENT16, resolution, resolution, slots * 6));
+        GLCall(glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+        GLCall(glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+        GLCall(glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE));
+        GLCall(glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL));
+        GLCall(glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, 0));
+
+        GLCall(glGenFramebuffers(1, &fbo));
+        GLCall(glBindFramebuffer(GL_FRAMEBUFFER, fbo));
+        GLCall(glDrawBuffer(GL_NONE));
+        GLCall(glReadBuffer(GL_NONE));
+        GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+        Logger::Info("[ShadowCubeAtlas] Created " + std::to_string(slots) + " cubes of " + std::to_string(resolution) +
+                     "x" + std::to_string(resolution) + " (" +
+                     std::to_string(2ull * resolution * resolution * slots * 6 / (1024 * 1024)) + " MB)");
+        return true;
+    }
+
+    // Enlaza una cara de un slot como destino de profundidad y la limpia.
+    void BeginFace(int slot, int face) {
+        GLCall(glBindFramebuffer(GL_FRAMEBUFFER, fbo));
+        GLCall(glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, texture, 0, slot * 6 + face));
+        GLCall(glClear(GL_DEPTH_BUFFER_BIT));
+    }
+
+    void Bind(GLuint unit) {
+        GLCall(glActiveTexture(GL_TEXTURE0 + unit));
+        GLCall(glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, texture));
+        GLCall(glActiveTexture(GL_TEXTURE0));
+    }
+
+    int GetResolution() const { return resolution; }
+
+private:
+    void Release() {
+        if (fbo != 0) {
+            GLCall(glDeleteFramebuffers(1, &fbo));
+            GLCall(glDeleteTextures(1, &texture));
+        }
+        fbo = texture = 0;
+        resolution = slots = 0;
+    }
+
+    GLuint fbo = 0;
+    GLuint texture = 0;
+    int resolution = 0;
+    int slots = 0;
+};
\ No newline at end of file
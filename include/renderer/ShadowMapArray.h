@@ -0,0 +1,92 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <string>
+#include "utils/GLDebug.h"
+#include "utils/Logger.h"
+
+/**
+ * @brief Mapas de sombra de las cascadas: dos arrays de profundidad con una capa por cascada.
+ *   - staticCache: solo oclusores estáticos; se re-renderiza cuando la cascada se recoloca o cambia el conjunto estático.
+ *   - live: copia de la caché más los oclusores dinámicos; es el que muestrean los shaders (sampler2DArrayShadow).
+ */
+class ShadowMapArray {
+public:
+    ShadowMapArray() = default;
+    ~ShadowMapArray() { Release(); }
+
+    ShadowMapArray(const ShadowMapArray&) = delete;
+    ShadowMapArray& operator=(const ShadowMapArray&) = delete;
+
+    // Crea o recrea los arrays si cambió el tamaño. Devuelve true si se recrearon (la caché se pierde).
+    bool Resize(int size, int layerCount) {
+        if (size == resolution && layerCount == layers && fbo != 0)
+            return false;
+        Release();
+        resolution = size;
+        layers = layerCount;
+
+        GLuint textures[2];
+        GLCall(glGenTextures(2, textures));
+        staticCache = textures[0];
+        live = textures[1];
+        for (GLuint texture : textures) {
+            GLCall(glBindTexture(GL_TEXTURE_2D_ARRAY, texture));
+            GLCall(glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_DEPTH_COMPONENT32F, resolution, resolution, layers));
+            GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+            GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+            GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+            GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+            GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE));
+            GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL));
+        }
+        GLCall(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+
+        GLCall(glGenFramebuffers(1, &fbo));
+        GLCall(glBindFramebuffer(GL_FRAMEBUFFER, fbo));
+        GLCall(glDrawBuffer(GL_NONE));
+        GLCall(glReadBuffer(GL_NONE));
+        GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+        Logger::Info("[ShadowMapArray] Created " + std::to_string(layers) + " layers of " + std::to_string(resolution) +
+                     "x" + std::to_string(resolution) + " (" +
+                     std::to_string(2ull * resolution * resolution * layers * 4 / (1024 * 1024)) + " MB)");
+        return true;
+    }
+
+    // Enlaza una capa como destino de profundidad (de la caché estática o del mapa final).
+    void BindLayer(bool toStaticCache, int layer) {
+        GLCall(glBindFramebuffer(GL_FRAMEBUFFER, fbo));
+        GLCall(glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, toStaticCache ? staticCache : live, 0, layer));
+    }
+
+    // live[layer] = staticCache[layer] (copia en GPU, sin pasar por el pipeline).
+    void CopyStaticToLive(int layer) {
+        GLCall(glCopyImageSubData(staticCache, GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer,
+                                  live, GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, resolution, resolution, 1));
+    }
+
+    void BindLive(GLuint unit) {
+        GLCall(glActiveTexture(GL_TEXTURE0 + unit));
+        GLCall(glBindTexture(GL_TEXTURE_2D_ARRAY, live));
+        GLCall(glActiveTexture(GL_TEXTURE0));
+    }
+
+    int GetResolution() const { return resolution; }
+
+private:
+    void Release() {
+        if (fbo != 0) {
+            GLCall(glDeleteFramebuffers(1, &fbo));
+            GLuint textures[2] = { staticCache, live };
+            GLCall(glDeleteTextures(2, textures));
+        }
+        fbo = staticCache = live = 0;
+        resolution = layers = 0;
+    }
+
+    GLuint fbo = 0;
+    GLuint staticCache = 0;
+    GLuint live = 0;
+    int resolution = 0;
+    int layers = 0;
+};
\ No newline at end of file
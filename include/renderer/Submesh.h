@@ -5,17 +5,42 @@
 #include <glad/glad.h>
 #include "core/ModelLoader.h"
 #include "renderer/Material.h"
+#include "renderer/Bounds.h"
+#include "renderer/VertexFormat.h"
 #include "utils/Logger.h"
 #include "utils/GLDebug.h"   // Para GLCall, etc.
 #include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+// Nivel de detalle: rango dentro del index buffer del submesh (todos los LODs comparten vértices y EBO).
+struct SubmeshLOD {
+    uint32_t indexOffset = 0;
+    uint32_t indexCount = 0;
+    float error = 0.0f; // Error de simplificación relativo a la diagonal de la malla
+};
 
 struct Submesh {
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
+    // lods[0] es la malla completa; los siguientes se generan al importar y van concatenados en indices.
+    std::vector<SubmeshLOD> lods;
     unsigned int VAO = 0;
     unsigned int VBO = 0;
     unsigned int EBO = 0;
-    Material material;
+    // Entrada de la MaterialTable (compartida por todos los submeshes del mismo aiMaterial).
+    const Material* material = nullptr;
+    // Volúmenes envolventes en espacio del modelo (calculados al importar).
+    AABB bounds;
+    BoundingSphere sphere;
+    // Formato de los vértices en GPU. Con Compact, quantization reconstruye la posición en el shader.
+    VertexFormat vertexFormat = VertexFormat::Full;
+    VertexQuantization quantization;
+    // Tipo de índice en GPU: GL_UNSIGNED_SHORT si los vértices caben en 16 bits (se decide en setupMesh).
+    GLenum indexType = GL_UNSIGNED_INT;
+    // Tamaños subidos a GPU (siguen siendo válidos tras ReleaseCPUData).
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
 
     // Constructor por defecto
     Submesh() = default;
@@ -28,10 +53,18 @@ struct Submesh {
     Submesh(Submesh&& other) noexcept {
         vertices = std::move(other.vertices);
         indices = std::move(other.indices);
+        lods = std::move(other.lods);
         VAO = other.VAO;
         VBO = other.VBO;
         EBO = other.EBO;
-        material = std::move(other.material);
+        material = other.material;
+        bounds = other.bounds;
+        sphere = other.sphere;
+        vertexFormat = other.vertexFormat;
+        quantization = other.quantization;
+        indexType = other.indexType;
+        vertexCount = other.vertexCount;
+        indexCount = other.indexCount;
         other.VAO = 0;
         other.VBO = 0;
         other.EBO = 0;
@@ -46,10 +79,18 @@ struct Submesh {
 
             vertices = std::move(other.vertices);
             indices = std::move(other.indices);
+            lods = std::move(other.lods);
             VAO = other.VAO;
             VBO = other.VBO;
             EBO = other.EBO;
-            material = std::move(other.material);
+            material = other.material;
+            bounds = other.bounds;
+            sphere = other.sphere;
+            vertexFormat = other.vertexFormat;
+            quantization = other.quantization;
+            indexType = other.indexType;
+            vertexCount = other.vertexCount;
+            indexCount = other.indexCount;
 
             other.VAO = 0;
             other.VBO = 0;
@@ -71,11 +112,30 @@ struct Submesh {
         }
     }
     
+    // Calcula la AABB y la esfera envolvente a partir de los vértices.
+    void computeBounds() {
+        bounds = AABB();
+        for (const auto& v : vertices)
+            bounds.Expand(v.Position);
+        sphere.center = bounds.IsValid() ? bounds.Center() : glm::vec3(0.0f);
+        float radius2 = 0.0f;
+        for (const auto& v : vertices) {
+            glm::vec3 d = v.Position - sphere.center;
+            radius2 = std::max(radius2, glm::dot(d, d));
+        }
+        sphere.radius = std::sqrt(radius2);
+    }
+    
     void setupMesh() {
         if (vertices.empty() || indices.empty()) {
             Logger::Warning("[Submesh] No vertices or indices to setup");
             return;
         }
+        computeBounds();
+        vertexCount = vertices.size();
+        indexCount = indices.size();
+        if (lods.empty())
+            lods.push_back({ 0, static_cast<uint32_t>(indices.size()), 0.0f });
         
         GLCall(glGenVertexArrays(1, &VAO));
         GLCall(glGenBuffers(1, &VBO));
@@ -83,60 +143,136 @@ struct Submesh {
         
         GLCall(glBindVertexArray(VAO));
         
-        GLCall(glBindBuffer(GL_ARRAY_BUFFER, VBO));
-        GLCall(glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW));
-        
         GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO));
-        GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW));
+        if (vertices.size() <= 65536) {
+            // Índices de 16 bits: la mitad de memoria y de ancho de banda que uint32.
+            indexType = GL_UNSIGNED_SHORT;
+            std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+            GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, shortIndices.size() * sizeof(uint16_t), shortIndices.data(), GL_STATIC_DRAW));
+        } else {
+            indexType = GL_UNSIGNED_INT;
+            GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW));
+        }
         
-        // Atributos de vértice:
-        GLCall(glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0));
-        GLCall(glEnableVertexAttribArray(0));
-        GLCall(glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal)));
-        GLCall(glEnableVertexAttribArray(1));
-        GLCall(glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords)));
-        GLCall(glEnableVertexAttribArray(2));
-        // Segundo set de UV (ubicación 4)
-        GLCall(glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords2)));
-        GLCall(glEnableVertexAttribArray(4));
-        GLCall(glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Tangent)));
-        GLCall(glEnableVertexAttribArray(3));
+        GLCall(glBindBuffer(GL_ARRAY_BUFFER, VBO));
+        if (vertexFormat == VertexFormat::Compact) {
+            // Posiciones cuantizadas a la AABB del submesh; normal/tangente octaédricas; UV en half.
+            quantization = VertexPacking::QuantizationForBounds(bounds.min, bounds.max);
+            std::vector<CompactVertex> packed;
+            packed.reserve(vertices.size());
+            for (const auto& v : vertices)
+                packed.push_back(VertexPacking::Pack(v.Position, v.Normal, v.Tangent, v.TexCoords, quantization));
+            GLCall(glBufferData(GL_ARRAY_BUFFER, packed.size() * sizeof(CompactVertex), packed.data(), GL_STATIC_DRAW));
+            
+            GLCall(glVertexAttribPointer(0, 4, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, position)));
+            GLCall(glEnableVertexAttribArray(0));
+            GLCall(glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, normal)));
+            GLCall(glEnableVertexAttribArray(1));
+            GLCall(glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, texCoords)));
+            GLCall(glEnableVertexAttribArray(2));
+            GLCall(glVertexAttribPointer(3, 2, GL_SHORT, GL_TRUE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, tangent)));
+            GLCall(glEnableVertexAttribArray(3));
+        } else {
+            quantization = VertexQuantization();
+            GLCall(glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW));
+            
+            // Atributos de vértice:
+            GLCall(glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0));
+            GLCall(glEnableVertexAttribArray(0));
+            GLCall(glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal)));
+            GLCall(glEnableVertexAttribArray(1));
+            GLCall(glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords)));
+            GLCall(glEnableVertexAttribArray(2));
+            // Segundo set de UV (ubicación 4)
+            GLCall(glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords2)));
+            GLCall(glEnableVertexAttribArray(4));
+            GLCall(glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Tangent)));
+            GLCall(glEnableVertexAttribArray(3));
+        }
         
         GLCall(glBindVertexArray(0));
         Logger::Info("[Submesh] Setup complete (" + std::to_string(vertices.size()) + " vertices, " +
-                     std::to_string(indices.size()) + " indices)");
+                     std::to_string(GetVertexBufferBytes()) + " bytes, " +
+                     std::to_string(GetIndexBufferBytes()) + " index bytes, " +
+                     std::to_string(indices.size()) + " indices, " + std::to_string(lods.size()) + " LODs)");
+    }
+    
+    size_t GetLODCount() const { return lods.size(); }
+    
+    uint32_t GetMaterialId() const { return material ? material->id : 0; }
+    
+    size_t GetIndexSize() const { return indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(unsigned int); }
+    size_t GetIndexBufferBytes() const { return indexCount * GetIndexSize(); }
+    
+    // Tamaño del vertex buffer en GPU según el formato.
+    size_t GetVertexBufferBytes() const {
+        return vertexCount * (vertexFormat == VertexFormat::Compact ? sizeof(CompactVertex) : sizeof(Vertex));
+    }
+    
+    // Memoria de CPU ocupada por la copia de la geometría.
+    size_t GetCPUBytes() const { return vertices.capacity() * sizeof(Vertex) + indices.capacity() * sizeof(unsigned int); }
+    bool HasCPUData() const { return !vertices.empty(); }
+    
+    // Libera la copia de CPU una vez subida a GPU (Draw solo usa VAO, lods e indexType).
+    void ReleaseCPUData() {
+        std::vector<Vertex>().swap(vertices);
+        std::vector<unsigned int>().swap(indices);
     }
     
-    void Draw() {
+    // instanceCount > 1: draw instanciado (el shader lee la matriz de cada instancia con gl_InstanceID).
+    void Draw(int materialIdLoc = -1, size_t lod = 0, GLsizei instanceCount = 1) {
         // Optimización: cacheo de binding de texturas para evitar rebinds innecesarios
         static unsigned int lastBoundTex0 = 0;
         static unsigned int lastBoundTex1 = 0;
         static unsigned int lastBoundTex2 = 0;
+        static unsigned int lastBoundTex3 = 0;
         
-        if (material.albedo) {
-            GLCall(glActiveTexture(GL_TEXTURE0));
-            if(lastBoundTex0 != material.albedo->ID) {
-                GLCall(glBindTexture(GL_TEXTURE_2D, material.albedo->ID));
-                lastBoundTex0 = material.albedo->ID;
-            }
+        // Los parámetros del material viven en el SSBO de la MaterialTable; solo se indica el índice.
+        if (materialIdLoc >= 0) {
+            GLCall(glUniform1i(materialIdLoc, static_cast<GLint>(GetMaterialId())));
         }
-        if (material.metallicRoughness) {
-            GLCall(glActiveTexture(GL_TEXTURE1));
-            if(lastBoundTex1 != material.metallicRoughness->ID) {
-                GLCall(glBindTexture(GL_TEXTURE_2D, material.metallicRoughness->ID));
-                lastBoundTex1 = material.metallicRoughness->ID;
+        
+        // Materiales solo de parámetros: no se toca ninguna unidad de textura.
+        if (material && material->HasTextures()) {
+            if (material->albedo) {
+                GLCall(glActiveTexture(GL_TEXTURE0));
+                if(lastBoundTex0 != material->albedo->ID) {
+                    GLCall(glBindTexture(GL_TEXTURE_2D, material->albedo->ID));
+                    lastBoundTex0 = material->albedo->ID;
+                }
             }
-        }
-        if (material.normal) {
-            GLCall(glActiveTexture(GL_TEXTURE2));
-            if(lastBoundTex2 != material.normal->ID) {
-                GLCall(glBindTexture(GL_TEXTURE_2D, material.normal->ID));
-                lastBoundTex2 = material.normal->ID;
+            if (material->metallicRoughness) {
+                GLCall(glActiveTexture(GL_TEXTURE1));
+                if(lastBoundTex1 != material->metallicRoughness->ID) {
+                    GLCall(glBindTexture(GL_TEXTURE_2D, material->metallicRoughness->ID));
+                    lastBoundTex1 = material->metallicRoughness->ID;
+                }
+            }
+            if (material->normal) {
+                GLCall(glActiveTexture(GL_TEXTURE2));
+                if(lastBoundTex2 != material->normal->ID) {
+                    GLCall(glBindTexture(GL_TEXTURE_2D, material->normal->ID));
+                    lastBoundTex2 = material->normal->ID;
+                }
+            }
+            if (material->emissive) {
+                GLCall(glActiveTexture(GL_TEXTURE3));
+                if(lastBoundTex3 != material->emissive->ID) {
+                    GLCall(glBindTexture(GL_TEXTURE_2D, material->emissive->ID));
+                    lastBoundTex3 = material->emissive->ID;
+                }
             }
         }
         
+        DrawGeometry(lod, instanceCount);
+    }
+
+    // Solo la geometría, sin material (pre-pasada de profundidad).
+    void DrawGeometry(size_t lod = 0, GLsizei instanceCount = 1) const {
         GLCall(glBindVertexArray(VAO));
-        GLCall(glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, nullptr));
+        const SubmeshLOD& level = lods[std::min(lod, lods.size() - 1)];
+        GLCall(glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(level.indexCount), indexType,
+                                       (void*)(static_cast<size_t>(level.indexOffset) * GetIndexSize()), instanceCount));
         GLCall(glBindVertexArray(0));
     }
 };
\ No newline at end of file
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+
+/**
+ * @brief Formatos de vértice en GPU.
+ *
+ * - Full: el struct Vertex tal cual (floats, 56 bytes).
+ * - Compact: 20 bytes por vértice:
+ *     position  4 x unorm16  (xyz cuantizadas a la AABB del submesh; w = signo de la bitangente)
+ *     normal    2 x snorm16  (codificación octaédrica)
+ *     tangent   2 x snorm16  (codificación octaédrica)
+ *     uv        2 x half
+ *   El segundo set de UV no se sube (los shaders no lo usan).
+ */
+enum class VertexFormat {
+    Full,
+    Compact
+};
+
+struct CompactVertex {
+    uint16_t position[4];
+    int16_t normal[2];
+    int16_t tangent[2];
+    uint16_t texCoords[2];
+};
+static_assert(sizeof(CompactVertex) == 20, "CompactVertex debe ocupar 20 bytes");
+
+// Posición en modelo = offset + scale * unorm16(position.xyz).
+struct VertexQuantization {
+    glm::vec3 offset{0.0f};
+    glm::vec3 scale{1.0f};
+};
+
+namespace VertexPacking {
+
+    inline glm::vec2 OctEncode(glm::vec3 n) {
+        n /= (std::abs(n.x) + std::abs(n.y) + std::abs(n.z));
+        glm::vec2 e(n.x, n.y);
+        if (n.z < 0.0f) {
+            e = glm::vec2((1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+                          (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f));
+        }
+        return e;
+    }
+
+    // Misma decodificación que el vertex shader.
+    inline glm::vec3 OctDecode(const glm::vec2& e) {
+        glm::vec3 v(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+        if (v.z < 0.0f) {
+            v.x = (1.0f - std::abs(e.y)) * (e.x >= 0.0f ? 1.0f : -1.0f);
+            v.y = (1.0f - std::abs(e.x)) * (e.y >= 0.0f ? 1.0f : -1.0f);
+        }
+        return glm::normalize(v);
+    }
+
+    inline int16_t ToSnorm16(float v) {
+        return static_cast<int16_t>(std::lround(std::clamp(v, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    inline float FromSnorm16(int16_t v) {
+        return std::max(static_cast<float>(v) / 32767.0f, -1.0f);
+    }
+
+    inline uint16_t ToUnorm16(float v) {
+        return static_cast<uint16_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    // Cuantización que cubre la caja dada (los ejes planos usan escala 1 para evitar divisiones por 0).
+    inline VertexQuantization QuantizationForBounds(const glm::vec3& minPoint, const glm::vec3& maxPoint) {
+        VertexQuantization q;
+        q.offset = minPoint;
+        q.scale = maxPoint - minPoint;
+        for (int i = 0; i < 3; ++i) {
+            if (q.scale[i] <= 0.0f)
+                q.scale[i] = 1.0f;
+        }
+        return q;
+    }
+
+    /**
+     * @brief Empaqueta un vértice. tangent.w es el signo de la bitangente (B = cross(N, T) * w).
+     */
+    inline CompactVertex Pack(const glm::vec3& position, const glm::vec3& normal, const glm::vec4& tangent,
+                              const glm::vec2& texCoords, const VertexQuantization& quantization) {
+        CompactVertex v;
+        glm::vec3 unit = (position - quantization.offset) / quantization.scale;
+        v.position[0] = ToUnorm16(unit.x);
+        v.position[1] = ToUnorm16(unit.y);
+        v.position[2] = ToUnorm16(unit.z);
+        v.position[3] = tangent.w < 0.0f ? 0 : 65535;
+
+        glm::vec3 n = glm::length(normal) > 1e-6f ? glm::normalize(normal) : glm::vec3(0.0f, 0.0f, 1.0f);
+        glm::vec3 t(tangent);
+        if (glm::length(t) <= 1e-6f) {
+            // Sin tangente: cualquier perpendicular a la normal.
+            t = std::abs(n.x) < 0.9f ? glm::cross(n, glm::vec3(1.0f, 0.0f, 0.0f)) : glm::cross(n, glm::vec3(0.0f, 1.0f, 0.0f));
+        }
+        glm::vec2 ne = OctEncode(n);
+        glm::vec2 te = OctEncode(glm::normalize(t));
+        v.normal[0] = ToSnorm16(ne.x);
+        v.normal[1] = ToSnorm16(ne.y);
+        v.tangent[0] = ToSnorm16(te.x);
+        v.tangent[1] = ToSnorm16(te.y);
+        v.texCoords[0] = glm::packHalf1x16(texCoords.x);
+        v.texCoords[1] = glm::packHalf1x16(texCoords.y);
+        return v;
+    }
+
+    inline glm::vec3 UnpackPosition(const CompactVertex& v, const VertexQuantization& quantization) {
+        return quantization.offset + quantization.scale * glm::vec3(v.position[0] / 65535.0f, v.position[1] / 65535.0f,
+                                                                    v.position[2] / 65535.0f);
+    }
+
+    inline glm::vec3 UnpackNormal(const CompactVertex& v) {
+        return OctDecode(glm::vec2(FromSnorm16(v.normal[0]), FromSnorm16(v.normal[1])));
+    }
+
+    inline glm::vec4 UnpackTangent(const CompactVertex& v) {
+        glm::vec3 t = OctDecode(glm::vec2(FromSnorm16(v.tangent[0]), FromSnorm16(v.tangent[1])));
+        return glm::vec4(t, v.position[3] > 32767 ? 1.0f : -1.0f);
+    }
+
+    inline glm::vec2 UnpackTexCoords(const CompactVertex& v) {
+        return glm::vec2(glm::unpackHalf1x16(v.texCoords[0]), glm::unpackHalf1x16(v.texCoords[1]));
+    }
+}
\ No newline at end of file
@@ -6,22 +6,395 @@
 #include "components/RenderComponent.h"
 #include "core/Coordinator.h"
 #include "renderer/Shader.h"
+#include "renderer/ShaderVariants.h"
+#include "renderer/FrustumCuller.h"
+#include "renderer/DrawListBuilder.h"
+#include "renderer/AABBTree.h"
+#include "renderer/OcclusionCuller.h"
+#include "renderer/LODSelector.h"
+#include "renderer/GBuffer.h"
+#include "renderer/ShadowCascades.h"
+#include "renderer/ShadowMapArray.h"
+#include "renderer/ShadowCubeAtlas.h"
+#include "renderer/PointShadowScheduler.h"
+#include "engine/Light.h"
+#include "engine/RenderThread.h"
+#include "utils/FrameRingBuffer.h"
 #include "engine/Camera.h"
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <vector>
+#include <unordered_map>
+#include <memory>
 #include <algorithm>
 
+class SceneResources;
+class Config;
+class LightManager;
+
+// Forward: un shader PBR por draw. Deferred: G-buffer de opacos, pasada de iluminación y forward de transparentes.
+enum class RenderPath {
+    Forward,
+    Deferred
+};
+
+// Fragmentos sombreados por la pasada opaca (GL_SAMPLES_PASSED) frente a los píxeles del viewport.
+struct OverdrawStats {
+    uint64_t shadedSamples = 0;
+    uint64_t pixels = 0;
+    float overdraw = 0.0f; // shadedSamples / pixels (1.0: cada píxel se sombrea una vez)
+};
+
+// Coste del último frame de sombras: lo estático solo se redibuja al invalidarse la caché.
+struct ShadowStats {
+    uint32_t staticCascadesRendered = 0; // Cascadas cuya caché estática se regeneró
+    uint32_t cascadesRefreshed = 0;      // Cascadas cuyo mapa final se rehízo (copia de la caché + dinámicos)
+    uint32_t staticCasters = 0;
+    uint32_t dynamicCasters = 0;
+};
+
+// Bloque std140 "ShadowBlock" de los shaders de iluminación.
+struct ShadowBlockData {
+    glm::mat4 cascadeViewProj[ShadowCascades::MaxCascades];
+    glm::vec4 cascadeSplits; // Profundidad de vista donde termina cada cascada
+    glm::vec4 shadowParams;  // x: cascadas (0: sin sombras), y: índice de la luz, z: bias de profundidad, w: tamaño de texel
+};
+
+// Estrategia de culling: test SIMD sobre todas las cajas o consulta jerárquica al BVH.
+enum class CullingMode {
+    Flat,
+    BVH
+};
+
 class RenderSystem : public System {
 public:
-    RenderSystem() : mCoordinator(nullptr), mShader(nullptr), mCamera(nullptr), mModelLoc(-1) { }
+    // Binding point del SSBO "InstanceBlock" con las matrices de modelo de los draws visibles.
+    static constexpr GLuint InstanceBindingPoint = 3;
+    // SSBO "NormalMatrixBlock": matrices normales de los mismos draws (solo los shaders que sombrean).
+    static constexpr GLuint NormalMatrixBindingPoint = 9;
+    // Primera unidad de textura del G-buffer en la pasada de iluminación (las 0-3 son de material).
+    static constexpr GLuint GBufferFirstUnit = 4;
+    // Bloque "ShadowBlock" y unidad del sampler2DArrayShadow "shadowMap".
+    static constexpr GLuint ShadowBindingPoint = 7;
+    static constexpr GLuint ShadowMapUnit = 8;
+    // SSBO "PointShadowBlock" (slot del atlas por luz) y unidad del samplerCubeArrayShadow "pointShadowMap".
+    static constexpr GLuint PointShadowBindingPoint = 8;
+    static constexpr GLuint PointShadowMapUnit = 9;
+
+    RenderSystem() : mCoordinator(nullptr), mShader(nullptr), mCamera(nullptr) { }
+    ~RenderSystem() { Release(); }
+    RenderSystem(const RenderSystem&) = delete;
+    RenderSystem& operator=(const RenderSystem&) = delete;
     
     void Init(Coordinator* coordinator, Shader* shader, Camera* camera);
+    // Tras Init, lo que config.yaml decide del render de una escena, con lights como sus luces. Los shaders
+    // se cargan en resources con prefix delante del nombre ("scene1" -> "scene1ShaderVariants"...) y viven
+    // lo que la escena.
+    void ConfigureFromConfig(SceneResources& resources, const Config& config, const std::string& prefix,
+                             LightManager& lights);
+    // Shaders del camino diferido: gbuffer (pbr_vertex + gbuffer_fragment) y pasada de iluminación a pantalla completa.
+    // El shader de Init se sigue usando para los transparentes.
+    void SetDeferredShaders(Shader* gbufferShader, Shader* lightingShader);
+    // Deferred sin shaders configurados vuelve a forward.
+    void SetRenderPath(RenderPath path);
+    RenderPath GetRenderPath() const { return mRenderPath; }
+    // Pre-pasada de profundidad de los opacos (depth_vertex/depth_fragment); la pasada de sombreado usa GL_EQUAL.
+    // nullptr la desactiva.
+    void SetDepthPrepass(Shader* depthShader);
+    bool IsDepthPrepassEnabled() const { return mDepthShader != nullptr; }
+    // Medida con un frame de retraso para no esperar a la GPU.
+    const OverdrawStats& GetOverdrawStats() const { return mOverdrawStats; }
+    // Sombras en cascada de la luz direccional lightIndex (índice en el LightBuffer). nullptr las desactiva.
+    void SetDirectionalShadows(Shader* shadowShader, int lightIndex, const glm::vec3& direction,
+                               const ShadowCascadeSettings& settings);
+    const ShadowStats& GetShadowStats() const { return mShadowStats; }
+    // Sombras de luces puntuales en un atlas de cubos. lights: buffer de luces de la escena (debe seguir vivo);
+    // shadowedLights: índices de las candidatas. nullptr como shader las desactiva.
+    void SetPointShadows(Shader* shadowShader, const std::vector<Light>* lights, std::vector<uint32_t> shadowedLights,
+                         const PointShadowSettings& settings);
+    const PointShadowStats& GetPointShadowStats() const { return mPointShadowScheduler.GetStats(); }
+    // Variantes por material de los shaders forward (pbr) y G-buffer; cada draw usa la más ligera que cubre
+    // su material en lugar del shader de Init / SetDeferredShaders. nullptr vuelve al ubershader.
+    void SetShaderVariants(ShaderVariantCache* forward, ShaderVariantCache* gbuffer);
+    // Envía la compilación de las variantes de todos los materiales de la MaterialTable (tras cargar la
+    // escena). Se dibuja con el ubershader hasta que cada variante termina, sin detener el bucle.
+    void PrepareShaderVariants();
+    // Simulación: actualiza transforms y bounds en mundo, descarta los submeshes fuera del frustum de la
+    // cámara, decide las sombras del frame y deja todo en el paquete del frame (sin llamadas GL).
     void Update(float dt);
+    // Hilo de GL: dibuja el paquete publicado (un draw instanciado por submesh y LOD) mientras Update
+    // prepara el siguiente. No toca componentes ni estado de la simulación.
+    void Render();
+    // Hilo de GL: borra los objetos GL propios del sistema (Scene::Destroy; también al destruirlo).
+    void Release();
+    // Draw calls emitidos en el último Render.
+    size_t GetDrawCallCount() const { return mDrawCalls; }
+
+    const CullingStats& GetCullingStats() const { return mCullingStats; }
+    void SetCullingMode(CullingMode mode) { mCullingMode = mode; }
+    CullingMode GetCullingMode() const { return mCullingMode; }
+    // Occlusion culling por software tras el frustum culling (triangleBudget: máximo de triángulos de oclusores por frame).
+    void SetOcclusionCulling(bool enabled, size_t triangleBudget) {
+        mOcclusionEnabled = enabled;
+        mOccluderTriangleBudget = triangleBudget;
+    }
+    const OcclusionStats& GetOcclusionStats() const { return mOcclusionCuller.GetStats(); }
+    // Bias de LOD (>1 mantiene más detalle a distancia).
+    void SetLODBias(float bias) { mLODSettings.bias = bias; }
+    // BVH con las AABB en mundo de las instancias (userData = índice del DrawRecord). Válido en modo BVH.
+    const AABBTree& GetBVH() const { return mBVH; }
     
 private:
+    // Ubicaciones de las uniforms por draw de un programa que usa pbr_vertex.glsl.
+    struct DrawUniforms {
+        int instanceOffset = -1;
+        int materialId = -1;
+        int compactVertices = -1; // Uniforms del formato de vértice compacto
+        int posOffset = -1;
+        int posScale = -1;
+    };
+
+    // Un registro por instancia de submesh de cada entidad.
+    struct DrawRecord {
+        Submesh* submesh;
+        const glm::mat4* transform;   // Transformación de la entidad
+        const glm::mat3* normalMatrix; // Matriz normal de la entidad (TransformComponent::normalMatrix)
+        const MeshInstance* instance; // Nodo del modelo (transformación relativa a la entidad)
+        ECS::Entity entity;
+        uint32_t submeshOrder; // Submesh en la clave de orden (ver SubmeshOrderBase)
+        uint32_t lod;
+    };
+
+    // Estado por entidad para el BVH: sus registros y la última transformación vista.
+    struct TrackedEntity {
+        Model* model = nullptr;
+        size_t firstRecord = 0;
+        size_t recordCount = 0;
+        glm::mat4 lastTransform{1.0f};
+    };
+
+    // Lo único que el hilo de GL necesita de un draw.
+    struct DrawItem {
+        Submesh* submesh;
+        uint32_t lod;
+    };
+
+    // Draws de una pasada en orden de dibujo con su matriz de modelo en mundo (mismo índice), ya
+    // calculada: el paquete no apunta a componentes que la simulación sigue modificando.
+    struct DrawList {
+        std::vector<DrawItem> items;
+        std::vector<glm::mat4> transforms;
+
+        void Clear() {
+            items.clear();
+            transforms.clear();
+        }
+        void Push(const DrawRecord& draw, uint32_t lod) {
+            items.push_back({ draw.submesh, lod });
+            transforms.push_back(WorldTransform(draw));
+        }
+        // Resize + Set: cada hilo rellena su tramo de índices.
+        void Resize(size_t count) {
+            items.resize(count);
+            transforms.resize(count);
+        }
+        void Set(size_t i, const DrawRecord& draw, uint32_t lod) {
+            items[i] = { draw.submesh, lod };
+            transforms[i] = WorldTransform(draw);
+        }
+        size_t Size() const { return items.size(); }
+    };
+
+    // Qué hacer con una cascada: los rangos indexan FramePacket::shadowDraws.
+    struct CascadePass {
+        glm::mat4 viewProj{1.0f};
+        size_t staticBegin = 0, staticEnd = 0;
+        size_t dynamicBegin = 0, dynamicEnd = 0;
+        bool refreshStatic = false; // Regenerar la caché estática
+        bool refreshLive = false;   // Rehacer el mapa final (copia de la caché + dinámicos)
+    };
+
+    struct FaceDraws {
+        uint32_t slot;
+        int face;
+        glm::mat4 viewProj;
+        size_t begin, end;
+    };
+
+    // Todo lo que Render lee de un frame (ver RenderThread). Los vectores conservan su capacidad.
+    struct FramePacket {
+        DrawList visible; // Opacos primero; los transparentes desde firstTransparent
+        std::vector<glm::mat3x4> normalMatrices; // De visible, en std430 (columnas con padding de vec4)
+        size_t firstTransparent = 0;
+        glm::mat4 invViewProj{1.0f};
+
+        uint32_t cascadeCount = 0; // 0: sin pasada de sombras este frame
+        uint32_t shadowResolution = 0;
+        CascadePass cascades[ShadowCascades::MaxCascades];
+        DrawList shadowDraws;
+        ShadowBlockData shadowBlock{};
+
+        uint32_t pointShadowSlots = 0; // 0: sin pasada de sombras puntuales este frame
+        uint32_t pointShadowResolution = 0;
+        std::vector<FaceDraws> pointShadowFaces;
+        DrawList pointShadowDraws;
+        std::vector<glm::vec4> pointShadowInfo;
+    };
+
+    // Modo flat: componentes de una entidad con modelo, buscados una vez por frame.
+    struct FlatEntity {
+        ECS::Entity entity;
+        TransformComponent* transform;
+        RenderComponent* render;
+    };
+
+    struct OccluderRecord {
+        const OccluderMesh* mesh;
+        glm::mat4 transform;
+        float distance;
+    };
+
+    static glm::mat4 WorldTransform(const DrawRecord& draw) { return *draw.transform * draw.instance->transform; }
+    // (A * B)^-T = A^-T * B^-T: la de la entidad se calcula al cambiar su transform y la del nodo al importar.
+    static glm::mat3 WorldNormalMatrix(const DrawRecord& draw) { return *draw.normalMatrix * draw.instance->normalMatrix; }
+
+    // Modo flat: registros de todas las instancias y sus AABB en mundo; el test del frustum lo hace
+    // mDrawListBuilder.
+    void GatherFlat(ThreadPool& pool);
+    // Rasteriza los oclusores más cercanos. false si no hay ninguno (no hace falta testear los draws).
+    bool RasterizeOccluders(const Frustum& frustum, const glm::mat4& viewProj);
+    // Filtro de mDrawListBuilder para un registro dentro del frustum: oclusión, LOD por tamaño en pantalla
+    // (recordando el del frame anterior) y clave de orden. Corre en varios hilos: solo escribe mLODState[record].
+    bool ClassifyDraw(uint32_t record, bool occlusion, DrawSortEntry& entry);
+    // Modo BVH: refit de lo que se movió y consulta; deja en mQueryResults los registros dentro del frustum.
+    void CullBVH(const Frustum& frustum);
+    // Primer índice de orden de los submeshes de model (los demás siguen consecutivos).
+    uint32_t SubmeshOrderBase(const Model& model);
+    // Recrea registros y proxies si cambió el conjunto de entidades o sus modelos.
+    bool SyncTrackedEntities();
+    static DrawUniforms QueryDrawUniforms(Shader& shader);
+    // Emite los draws [first, end) agrupando instancias consecutivas del mismo submesh y LOD.
+    // Con variants, cada grupo usa la variante de su material (y sus uniforms) en lugar del shader activo;
+    // si aún no está compilada, fallback (el ubershader, con uniforms).
+    void DrawRange(const DrawList& draws, size_t first, size_t end, const DrawUniforms& uniforms,
+                   bool depthOnly = false, ShaderVariantCache* variants = nullptr, Shader* fallback = nullptr);
+    // Bloques y samplers de sombras e instancias de un shader de iluminación forward.
+    static void BindLightingResources(Shader& shader);
+    // Unidades fijas de las texturas de material (albedo, metallic-roughness, normal, emisiva).
+    static void BindMaterialSamplers(Shader& shader);
+    // Clave de variante de un submesh (0 sin variantes): agrupa los draws que comparten programa.
+    uint32_t VariantFeatures(const Submesh& submesh) const;
+    // Copia las matrices de modelo de draws al FrameRingBuffer y enlaza el rango a InstanceBindingPoint.
+    void UploadInstances(const DrawList& draws);
+    // Sube las matrices normales del paquete (mismo orden que visible) y las enlaza a NormalMatrixBindingPoint.
+    void UploadNormalMatrices(const FramePacket& packet);
+    void RenderDeferred(const FramePacket& packet);
+    // Opacos [0, firstTransparent) con el shader activo, precedidos de la pre-pasada si está activa.
+    void DrawOpaque(const FramePacket& packet, Shader& shader, const DrawUniforms& uniforms,
+                    ShaderVariantCache* variants = nullptr);
+    void BeginOverdrawQuery();
+    void EndOverdrawQuery();
+    // Simulación: actualiza las cascadas y decide qué se redibuja (lo estático invalidado y los dinámicos).
+    void PrepareShadows(bool staticSetChanged, FramePacket& packet);
+    // Hilo de GL: renderiza las cascadas según el paquete.
+    void RenderShadows(const FramePacket& packet);
+    // Simulación: planifica las caras del atlas de cubos a refrescar y recoge sus oclusores.
+    void PreparePointShadows(FramePacket& packet);
+    // Hilo de GL: refresca las caras planificadas.
+    void RenderPointShadows(const FramePacket& packet);
+    // Marca entidades que se han movido alguna vez como dinámicas y recoge en mMovedBounds sus AABB
+    // antes y después. Devuelve true si cambió el conjunto estático.
+    bool UpdateCasterMotion();
+    // Registros de mDrawRecords cuya AABB toca el volumen de culling de una cascada.
+    void CollectCasters(const Frustum& frustum, std::vector<uint32_t>& out);
+    // Rellena mShadowBlockData con las cascadas actuales (viaja en el paquete; Render lo sube).
+    void UpdateShadowBlock();
+
     Coordinator* mCoordinator;
     Shader* mShader;
     Camera* mCamera;
-    int mModelLoc; // Ubicación cacheada de la uniform "model"
+    DrawUniforms mForwardUniforms;
+
+    RenderPath mRenderPath = RenderPath::Forward;
+    Shader* mGBufferShader = nullptr;
+    Shader* mLightingShader = nullptr;
+    DrawUniforms mGBufferUniforms;
+    int mInvViewProjLoc = -1;
+    GBuffer mGBuffer;
+    GLuint mFullscreenVAO = 0; // VAO vacío: el triángulo a pantalla completa sale de gl_VertexID
+
+    ShaderVariantCache* mForwardVariants = nullptr;
+    ShaderVariantCache* mGBufferVariants = nullptr;
+    std::unordered_map<const Shader*, DrawUniforms> mVariantUniforms;
+
+    Shader* mDepthShader = nullptr;
+    DrawUniforms mDepthUniforms;
+    GLuint mOverdrawQueries[2] = { 0, 0 }; // Alternan entre frames
+    int mOverdrawQueryFrame = 0;
+    bool mOverdrawQueryPending[2] = { false, false };
+    OverdrawStats mOverdrawStats;
+
+    // Sombras en cascada (luz direccional).
+    struct CasterMotion {
+        glm::mat4 lastTransform{1.0f};
+        AABB lastBounds;
+        bool dynamic = false; // Se ha movido alguna vez: nunca entra en la caché estática
+    };
+    Shader* mShadowShader = nullptr;
+    DrawUniforms mShadowUniforms;
+    int mShadowViewProjLoc = -1;
+    int mShadowLightIndex = -1;
+    glm::vec3 mShadowDirection{0.0f, -1.0f, 0.0f};
+    ShadowCascades mShadowCascades;
+    ShadowMapArray mShadowMaps;
+    ShadowBlockData mShadowBlockData{};
+    uint32_t mStaticCacheValid = 0;  // Bit por cascada
+    uint32_t mLiveHasDynamic = 0;    // Bit por cascada: el mapa final difiere de la caché
+    std::unordered_map<ECS::Entity, CasterMotion> mCasterMotion;
+    std::vector<AABB> mMovedBounds;
+    std::vector<DrawRecord> mShadowDraws; // Oclusores de todas las cascadas antes de pasar al paquete
+    std::vector<uint32_t> mCasterResults;
+    std::vector<uint8_t> mCasterVisibility;  // Modo flat: resultado del test SIMD contra cada cascada
+    ShadowStats mShadowStats;
+
+    // Sombras de luces puntuales.
+    Shader* mPointShadowShader = nullptr;
+    DrawUniforms mPointShadowUniforms;
+    int mPointShadowViewProjLoc = -1;
+    const std::vector<Light>* mPointShadowLightSource = nullptr;
+    std::vector<uint32_t> mPointShadowCandidates;
+    std::vector<ShadowLight> mShadowLights;
+    PointShadowScheduler mPointShadowScheduler;
+    std::vector<PointShadowRequest> mPointShadowRequests;
+    ShadowCubeAtlas mPointShadowAtlas;
+    std::vector<DrawRecord> mPointShadowDraws;
+    std::vector<glm::vec4> mPointShadowInfo; // Por luz: x: slot (< 0: sin sombra), y: near, z: far
+
+    // Escrito por Update, leído por Render un frame después (con hilo de GL, a la vez que el siguiente Update).
+    RenderPacket<FramePacket> mPackets;
+
+    std::vector<DrawRecord> mDrawRecords;   // Candidatos (un registro por instancia de cada entidad)
+    AABBSoA mWorldBounds;                   // AABB en mundo de cada candidato (SoA para el test SIMD)
+    std::vector<FlatEntity> mFlatEntities;
+    DrawListBuilder mDrawListBuilder;       // Visibles ordenados del frame (índices en mDrawRecords)
+    CullingStats mCullingStats;
+    // Índice del primer submesh de cada modelo en la clave de orden; se rehace con los registros.
+    std::unordered_map<const Model*, uint32_t> mSubmeshOrderBase;
+    uint32_t mNextSubmeshOrder = 0;
+
+    CullingMode mCullingMode = CullingMode::BVH;
+    AABBTree mBVH;
+    std::vector<int32_t> mProxies;          // Proxy del BVH de cada DrawRecord
+    std::vector<uint32_t> mQueryResults;
+    std::unordered_map<ECS::Entity, TrackedEntity> mTracked;
+
+    bool mOcclusionEnabled = true;
+    size_t mOccluderTriangleBudget = 20000;
+    OcclusionCuller mOcclusionCuller;
+    std::vector<OccluderRecord> mOccluders;
+
+    LODSettings mLODSettings;
+    std::vector<uint8_t> mLODState; // LOD actual de cada DrawRecord (vuelve a 0 si cambian los registros)
+
+    size_t mDrawCalls = 0;
 };
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Rango sucio [begin, end) de elementos por cada sección de un buffer persistente con
+ * Sections copias (una por frame en vuelo).
+ *
+ * Un cambio marca el rango en todas las secciones; cada frame solo reescribe lo pendiente de la suya
+ * (Take) y la deja limpia. Un elemento que cambia una vez se copia exactamente Sections veces.
+ */
+template <uint32_t Sections>
+class DirtyRangeTracker {
+public:
+    struct Range {
+        size_t begin = 0;
+        size_t end = 0;
+        bool Empty() const { return begin >= end; }
+        size_t Count() const { return Empty() ? 0 : end - begin; }
+    };
+
+    void Mark(size_t begin, size_t end) {
+        if (begin >= end)
+            return;
+        for (Range& range : ranges) {
+            if (range.Empty())
+                range = { begin, end };
+            else
+                range = { std::min(range.begin, begin), std::max(range.end, end) };
+        }
+    }
+
+    void MarkAll(size_t count) { Mark(0, count); }
+
+    // Lo pendiente de la sección, recortado a count (elementos borrados desde que se marcó), y la limpia.
+    Range Take(uint32_t section, size_t count) {
+        Range range = ranges[section];
+        ranges[section] = {};
+        range.end = std::min(range.end, count);
+        if (range.Empty())
+            return {};
+        return range;
+    }
+
+    const Range& Peek(uint32_t section) const { return ranges[section]; }
+
+    void Clear() {
+        for (Range& range : ranges)
+            range = {};
+    }
+
+private:
+    Range ranges[Sections] = {};
+};
\ No newline at end of file
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include "utils/RingAllocator.h"
+#include "utils/Logger.h"
+
+/**
+ * @brief Buffer persistente (glBufferStorage + GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT) para los
+ * datos que cambian cada frame: constantes, instancias, luces y clusters.
+ *
+ * Triple buffer: el frame N escribe en su sección mientras la GPU lee las de N-1 y N-2. BeginFrame
+ * espera el fence de la sección que se va a reutilizar (normalmente ya señalado), EndFrame deja uno
+ * nuevo. Sin glBufferData ni glBufferSubData: ni copias del driver ni stalls implícitos por renombrado.
+ *
+ * Si un frame no cabe, el buffer crece a mitad de frame; el anterior se borra FrameCount frames después,
+ * cuando ningún binding ni comando en vuelo lo referencia. El crecimiento no cambia el índice de frame
+ * ni descarta fences: quien indexa sus propios buffers con GetFrameIndex (LightManager) sigue protegido.
+ */
+class FrameRingBuffer {
+public:
+    // Región de un frame: data apunta a la memoria mapeada (escritura directa, sin copia intermedia).
+    struct Range {
+        GLuint buffer = 0;
+        GLintptr offset = 0;
+        GLsizeiptr size = 0;
+        void* data = nullptr;
+    };
+
+    struct Stats {
+        size_t bytesPerFrame = 0; // Capacidad de una sección
+        size_t peakBytes = 0;     // Máximo escrito en un frame
+        uint32_t stalls = 0;      // Frames en que BeginFrame tuvo que esperar a la GPU
+        uint32_t grows = 0;
+    };
+
+    static constexpr GLsizeiptr DefaultBytesPerFrame = 4 << 20;
+
+    static FrameRingBuffer& GetInstance() {
+        static FrameRingBuffer instance;
+        return instance;
+    }
+
+    void BeginFrame() {
+        if (!buffer) {
+            allocator.Reset(DefaultBytesPerFrame);
+            Create();
+        }
+        DeleteRetired();
+        GLsync& fence = fences[allocator.GetFrame()];
+        if (fence) {
+            if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+                stats.stalls++;
+                while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) { }
+            }
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+
+    void EndFrame() {
+        if (!buffer)
+            return;
+        fences[allocator.GetFrame()] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        stats.peakBytes = allocator.GetPeak();
+        allocator.NextFrame();
+        frameCounter++;
+    }
+
+    // target decide la alineación (GL_UNIFORM_BUFFER o GL_SHADER_STORAGE_BUFFER). Válido hasta EndFrame.
+    Range Allocate(GLenum target, GLsizeiptr size) {
+        if (!buffer) {
+            allocator.Reset(DefaultBytesPerFrame);
+            Create();
+        }
+        // Un rango de tamaño 0 no se puede enlazar.
+        size = std::max<GLsizeiptr>(size, 16);
+        size_t alignment = target == GL_UNIFORM_BUFFER ? uniformAlignment : storageAlignment;
+        size_t offset = allocator.Allocate(static_cast<size_t>(size), alignment);
+        if (offset == RingAllocator::InvalidOffset) {
+            Grow(static_cast<size_t>(size) + alignment);
+            offset = allocator.Allocate(static_cast<size_t>(size), alignment);
+        }
+        return { buffer, static_cast<GLintptr>(offset), size, mapped + offset };
+    }
+
+    Range Upload(GLenum target, const void* data, GLsizeiptr size) {
+        Range range = Allocate(target, size);
+        if (size > 0)
+            std::memcpy(range.data, data, static_cast<size_t>(size));
+        return range;
+    }
+
+    static void Bind(GLenum target, GLuint bindingPoint, const Range& range) {
+        glBindBufferRange(target, bindingPoint, range.buffer, range.offset, range.size);
+    }
+
+    const Stats& GetStats() const { return stats; }
+    // Sección del frame actual: tras BeginFrame la GPU ya no lee otros buffers indexados igual (ver LightManager).
+    uint32_t GetFrameIndex() const { return allocator.GetFrame(); }
+
+    // Al cerrar, con el contexto aún vivo.
+    void Release() {
+        for (GLsync& fence : fences) {
+            if (fence)
+                glDeleteSync(fence);
+            fence = nullptr;
+        }
+        for (auto& retiredBuffer : retired)
+            glDeleteBuffers(1, &retiredBuffer.first);
+        retired.clear();
+        if (buffer)
+            glDeleteBuffers(1, &buffer);
+        buffer = 0;
+        mapped = nullptr;
+    }
+
+private:
+    FrameRingBuffer() = default;
+
+    // Buffer para el tamaño de sección actual del allocator.
+    void Create() {
+        GLint alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        uniformAlignment = static_cast<size_t>(std::max(alignment, 1));
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        storageAlignment = static_cast<size_t>(std::max(alignment, 1));
+
+        const size_t bytesPerFrame = allocator.GetSectionSize();
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferStorage(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(allocator.GetTotalSize()), nullptr, flags);
+        mapped = static_cast<char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0,
+                                                     static_cast<GLsizeiptr>(allocator.GetTotalSize()), flags));
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        stats.bytesPerFrame = bytesPerFrame;
+        Logger::Info("[FrameRingBuffer] Created " + std::to_string(RingAllocator::FrameCount) + " x " +
+                     std::to_string(bytesPerFrame / 1024) + " KB persistent sections");
+    }
+
+    // Las secciones del buffer nuevo están libres, pero los fences de los frames en vuelo se conservan
+    // (y el índice de frame no cambia): también protegen las secciones de otros buffers indexados igual.
+    void Grow(size_t needed) {
+        size_t bytesPerFrame = std::max(allocator.GetSectionSize() * 2, (allocator.GetUsed() + needed) * 2);
+        retired.emplace_back(buffer, frameCounter + RingAllocator::FrameCount);
+        stats.grows++;
+        Logger::Warning("[FrameRingBuffer] Frame data exceeded " + std::to_string(allocator.GetSectionSize() / 1024) +
+                        " KB, growing");
+        allocator.Resize(bytesPerFrame);
+        Create();
+    }
+
+    void DeleteRetired() {
+        for (size_t i = 0; i < retired.size();) {
+            if (retired[i].second > frameCounter) {
+                ++i;
+                continue;
+            }
+            glDeleteBuffers(1, &retired[i].first);
+            retired[i] = retired.back();
+            retired.pop_back();
+        }
+    }
+
+    GLuint buffer = 0;
+    char* mapped = nullptr;
+    RingAllocator allocator;
+    GLsync fences[RingAllocator::FrameCount] = {};
+    size_t uniformAlignment = 256;
+    size_t storageAlignment = 256;
+    uint64_t frameCounter = 0;
+    std::vector<std::pair<GLuint, uint64_t>> retired; // Buffer y frame a partir del cual se puede borrar
+    Stats stats;
+};
\ No newline at end of file
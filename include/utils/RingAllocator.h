@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Reparto de un buffer en FrameCount secciones, una por frame en vuelo (ver FrameRingBuffer).
+ *
+ * Solo aritmética de offsets: cada frame sub-asigna linealmente dentro de su sección y NextFrame
+ * pasa a la siguiente. Que la GPU haya terminado de leer la sección es cosa de los fences del buffer.
+ */
+class RingAllocator {
+public:
+    static constexpr uint32_t FrameCount = 3;
+    static constexpr size_t InvalidOffset = static_cast<size_t>(-1);
+
+    void Reset(size_t bytesPerFrame) {
+        sectionSize = bytesPerFrame;
+        frame = 0;
+        head = 0;
+        peak = 0;
+    }
+
+    // Nuevo tamaño de sección (buffer más grande) sin cambiar de frame: la sección actual sigue siendo
+    // la misma, así que los fences por sección del buffer siguen valiendo. Empieza vacía.
+    void Resize(size_t bytesPerFrame) {
+        sectionSize = bytesPerFrame;
+        head = 0;
+        peak = 0;
+    }
+
+    // Offset en el buffer completo, alineado a alignment, o InvalidOffset si no cabe en la sección del frame.
+    size_t Allocate(size_t size, size_t alignment) {
+        size_t start = SectionOffset() + head;
+        if (alignment > 1)
+            start = (start + alignment - 1) / alignment * alignment;
+        if (start + size > SectionOffset() + sectionSize)
+            return InvalidOffset;
+        head = start + size - SectionOffset();
+        peak = std::max(peak, head);
+        return start;
+    }
+
+    void NextFrame() {
+        frame = (frame + 1) % FrameCount;
+        head = 0;
+    }
+
+    uint32_t GetFrame() const { return frame; }
+    size_t GetSectionSize() const { return sectionSize; }
+    size_t GetTotalSize() const { return sectionSize * FrameCount; }
+    size_t SectionOffset() const { return frame * sectionSize; }
+    // Bytes usados en el frame actual y máximo visto desde el último Reset.
+    size_t GetUsed() const { return head; }
+    size_t GetPeak() const { return peak; }
+
+private:
+    size_t sectionSize = 0;
+    uint32_t frame = 0;
+    size_t head = 0;
+    size_t peak = 0;
+};
\ No newline at end of file
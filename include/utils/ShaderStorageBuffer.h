@@ -0,0 +1,52 @@
+#pragma once
+
+#include <glad/glad.h>
+#include "utils/Logger.h"
+
+class ShaderStorageBuffer {
+public:
+    unsigned int ID = 0;
+    GLsizeiptr Size = 0;
+
+    ShaderStorageBuffer() {
+        glGenBuffers(1, &ID);
+        Logger::ThrottledLog("ShaderStorageBuffer_Generated", LogLevel::DEBUG,
+                             "[ShaderStorageBuffer] Generated ID: " + std::to_string(ID), 5.0);
+    }
+
+    ~ShaderStorageBuffer() {
+        if (ID != 0)
+            glDeleteBuffers(1, &ID);
+    }
+
+    ShaderStorageBuffer(const ShaderStorageBuffer&) = delete;
+    ShaderStorageBuffer& operator=(const ShaderStorageBuffer&) = delete;
+
+    void Bind() {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, ID);
+    }
+
+    void Unbind() {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+
+    void SetData(GLsizeiptr size, const void* data, GLenum usage) {
+        Bind();
+        glBufferData(GL_SHADER_STORAGE_BUFFER, size, data, usage);
+        Size = size;
+        Logger::Info("[ShaderStorageBuffer] Data set (" + std::to_string(size) + " bytes)");
+        Unbind();
+    }
+
+    void SetSubData(GLintptr offset, GLsizeiptr size, const void* data) {
+        Bind();
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, offset, size, data);
+        Unbind();
+    }
+
+    void BindToPoint(GLuint bindingPoint) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bindingPoint, ID);
+        Logger::ThrottledLog("ShaderStorageBuffer_BindToPoint", LogLevel::DEBUG,
+                             "[ShaderStorageBuffer] Bound to point " + std::to_string(bindingPoint), 5.0);
+    }
+};
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+
+/**
+ * @file Simd.h
+ * @brief Detección de SSE2 en tiempo de compilación (GCC/Clang y MSVC).
+ *
+ * Si TOXIC_SIMD_SSE2 está definido se pueden usar los intrínsecos de <emmintrin.h>;
+ * en caso contrario los módulos usan su ruta escalar equivalente.
+ */
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TOXIC_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
\ No newline at end of file
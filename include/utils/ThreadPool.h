@@ -0,0 +1,114 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <algorithm>
+#include "utils/Logger.h"
+
+/**
+ * @brief Pool de hilos de trabajo para tareas de CPU por frame (clustering de luces, listas de draws...).
+ *
+ * GetInstance() crea hardware_concurrency - 1 workers: el hilo que llama a ParallelFor también trabaja.
+ */
+class ThreadPool
+{
+public:
+    static ThreadPool &GetInstance()
+    {
+        static ThreadPool instance(std::max(1u, std::thread::hardware_concurrency()) - 1);
+        return instance;
+    }
+
+    explicit ThreadPool(size_t threadCount)
+    {
+        for (size_t i = 0; i < threadCount; ++i)
+            workers.emplace_back([this]() { WorkerLoop(); });
+        Logger::Info("[ThreadPool] Started " + std::to_string(threadCount) + " worker threads");
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        condition.notify_all();
+        for (auto &worker : workers)
+            worker.join();
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t GetThreadCount() const { return workers.size(); }
+
+    // Encola una tarea; el future se completa (o propaga la excepción) cuando termina.
+    std::future<void> Submit(std::function<void()> task)
+    {
+        auto packaged = std::make_shared<std::packaged_task<void()>>(std::move(task));
+        std::future<void> result = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push([packaged]() { (*packaged)(); });
+        }
+        condition.notify_one();
+        return result;
+    }
+
+    /**
+     * @brief Reparte [0, count) en bloques de al menos minBatch elementos entre los workers y el
+     * hilo llamante, y espera a que terminen todos. fn(begin, end) no debe llamar a ParallelFor.
+     */
+    void ParallelFor(size_t count, size_t minBatch, const std::function<void(size_t, size_t)> &fn)
+    {
+        if (count == 0)
+            return;
+        size_t batches = std::min(workers.size() + 1, (count + std::max<size_t>(minBatch, 1) - 1) / std::max<size_t>(minBatch, 1));
+        if (batches <= 1)
+        {
+            fn(0, count);
+            return;
+        }
+        size_t batchSize = (count + batches - 1) / batches;
+        std::vector<std::future<void>> pending;
+        pending.reserve(batches - 1);
+        for (size_t begin = batchSize; begin < count; begin += batchSize)
+        {
+            size_t end = std::min(count, begin + batchSize);
+            pending.push_back(Submit([&fn, begin, end]() { fn(begin, end); }));
+        }
+        fn(0, std::min(count, batchSize));
+        for (auto &future : pending)
+            future.get();
+    }
+
+private:
+    void WorkerLoop()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                if (stopping && tasks.empty())
+                    return;
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+};
\ No newline at end of file
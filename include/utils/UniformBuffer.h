@@ -12,6 +12,14 @@ public:
         Logger::ThrottledLog("UniformBuffer_Generated", LogLevel::DEBUG, 
                              "[UniformBuffer] Generated ID: " + std::to_string(ID), 5.0);
     }
+
+    ~UniformBuffer() {
+        if (ID != 0)
+            glDeleteBuffers(1, &ID);
+    }
+
+    UniformBuffer(const UniformBuffer&) = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
     
     void Bind() {
         glBindBuffer(GL_UNIFORM_BUFFER, ID);
@@ -27,6 +35,13 @@ public:
         Logger::Info("[UniformBuffer] Data set (" + std::to_string(size) + " bytes)");
         Unbind();
     }
+
+    // Actualiza una parte del buffer sin re-especificar su almacenamiento (uso por frame).
+    void SetSubData(GLintptr offset, GLsizeiptr size, const void* data) {
+        Bind();
+        glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+        Unbind();
+    }
     
     void BindToPoint(GLuint bindingPoint) {
         glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, ID);
@@ -46,24 +46,19 @@ void Scene1::Init() {
     // Configurar las luces usando la configuración global.
     const Config& config = ResourceManager::GetConfig();
     lightManager = std::make_unique<LightManager>();
-    for (const auto &lc : config.lights) {
-        Light light{};
-        if (lc.type == "point")
-            light.typeAndPadding = glm::vec4(0, 0, 0, 0);
-        light.position = glm::vec4(lc.position, 1.0f);
-        light.colorAndIntensity = glm::vec4(lc.color, 1.0f);
-        lightManager->AddLight(light);
-    }
-    unsigned int lightBlockIndex = glGetUniformBlockIndex(shader->ID, "LightBlock");
-    if (lightBlockIndex == GL_INVALID_INDEX) {
-        Logger::Error("[Scene1] 'LightBlock' uniform block not found in shader.");
-    } else {
-        GLCall(glUniformBlockBinding(shader->ID, lightBlockIndex, 1));
-        Logger::Info("[Scene1] LightBlock bound to binding point 1.");
-    }
+    
+    // Constantes por frame (view, projection, camPos, ambientColor) compartidas en un UBO.
+    frameUniforms = std::make_unique<FrameUniforms>();
+    // La proyección es constante: se calcula una sola vez.
+    projection = camera.GetProjectionMatrix();
+    
+    // El resto del render lo decide config.yaml (común a todas las escenas).
+    renderSystem->ConfigureFromConfig(sceneResources, config, "scene1", *lightManager);
     
     // Cargar las entidades específicas de Scene1.
     EntityLoader::LoadEntitiesFromYAML(coordinator.get(), "./config/entities_scene1.yaml");
+    // Con los materiales ya registrados, compilar sus variantes antes del primer frame.
+    renderSystem->PrepareShaderVariants();
     
     // Asumir que la primera entidad (ID 0) es el vehículo del jugador; crear el controlador.
     playerController = std::make_unique<ECSPlayerController>(coordinator.get(), 0);
@@ -79,6 +74,12 @@ void Scene1::Update(float dt) {
         playerController->Update(dt);
     }
     
+    // Cámara y clusters de luces del frame, para el hilo de GL.
+    cameraPacket.Write() = camera;
+    if (lightManager) {
+        lightManager->Update(camera);
+    }
+    
     if (renderSystem) {
         renderSystem->Update(dt);
     }
@@ -88,37 +89,30 @@ void Scene1::Render() {
     if (!shader) return;
     shader->Use();
 
-    // Configurar los samplers.
-    GLCall(glUniform1i(glGetUniformLocation(shader->ID, "albedoMap"), 0));
-    GLCall(glUniform1i(glGetUniformLocation(shader->ID, "metallicRoughnessMap"), 1));
-    GLCall(glUniform1i(glGetUniformLocation(shader->ID, "normalMap"), 2));
-    GLCall(glUniform1i(glGetUniformLocation(shader->ID, "useMaps"), 1));
-    
-    // Configurar los uniforms de la cámara.
-    glm::mat4 view = camera.GetViewMatrix();
-    GLCall(glUniformMatrix4fv(glGetUniformLocation(shader->ID, "view"), 1, GL_FALSE, glm::value_ptr(view)));
-    GLCall(glUniform3fv(glGetUniformLocation(shader->ID, "camPos"), 1, glm::value_ptr(camera.Position)));
-    
-    // Configurar la proyección.
-    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1920.0f/1080.0f, 0.1f, 100.0f);
-    GLCall(glUniformMatrix4fv(glGetUniformLocation(shader->ID, "projection"), 1, GL_FALSE, glm::value_ptr(projection)));
-    
-    // Actualizar y vincular el UBO de las luces.
+    // Actualizar el UBO de constantes por frame (una sola escritura por frame).
+    if (frameUniforms) {
+        frameUniforms->Update(cameraPacket.Read(), projection, ResourceManager::GetConfig().ambientColor);
+    }
+    
+    // Subir las luces y clusters que preparó Update y vincular sus buffers.
     if (lightManager) {
-        lightManager->UpdateUBO();
-        lightManager->lightUBO.BindToPoint(1);
-        const Config& config = ResourceManager::GetConfig();
-        GLCall(glUniform3fv(glGetUniformLocation(shader->ID, "ambientColor"), 1, glm::value_ptr(config.ambientColor)));
+        lightManager->Upload();
+        lightManager->Bind();
     }
     
     // Llamar al RenderSystem para renderizar las entidades.
     if (renderSystem) {
-        renderSystem->Update(currentDeltaTime);
+        renderSystem->Render();
     }
 }
 
 void Scene1::Destroy() {
     Logger::Info("[Scene1] Destruyendo escena 1");
+    // Objetos GL del sistema de render (Destroy corre en el hilo de GL).
+    if (renderSystem) {
+        renderSystem->Release();
+        renderSystem.reset();
+    }
     // Limpiar todas las entidades del ECS.
     if (coordinator) {
         coordinator->Clear();
@@ -130,6 +124,7 @@ void Scene1::Destroy() {
         lightManager->ClearLights();
         lightManager.reset();
     }
+    frameUniforms.reset();
     // (Opcional) Limpiar recursos globales si se desea:
     // ResourceManager::Clear();
     Logger::Info("[Scene1] Escena 1 destruida.");
@@ -6,7 +6,9 @@
 #include "systems/RenderSystem.h"
 #include "engine/LightManager.h"
 #include "renderer/Shader.h"
+#include "renderer/FrameConstants.h"
 #include "engine/Camera.h"
+#include "engine/RenderThread.h"
 #include "engine/ECSPlayerController.h"
 
 class Scene2 : public Scene {
@@ -25,9 +27,13 @@ private:
     SceneResources sceneResources;
     std::shared_ptr<RenderSystem> renderSystem;
     std::unique_ptr<LightManager> lightManager;
+    std::unique_ptr<FrameUniforms> frameUniforms;
+    glm::mat4 projection{1.0f};
     
     // Cámara propia para Scene2.
     Camera camera;
+    // La que usa Render: copia de camera hecha en cada Update.
+    RenderPacket<Camera> cameraPacket;
     float currentDeltaTime;
     
     // Controlador para mover el modelo (teclas W, A, S, D).
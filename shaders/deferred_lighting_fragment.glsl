@@ -0,0 +1,213 @@
+#version 430 core
+// Pasada de iluminación del camino diferido: un triángulo a pantalla completa que lee el G-buffer
+// (GBuffer.h) y evalúa las mismas luces por cluster que pbr_fragment.glsl.
+in vec2 ScreenUV;
+
+out vec4 FragColor;
+
+uniform sampler2D gAlbedoMetallic;
+uniform sampler2D gNormalRoughness;
+uniform sampler2D gEmissive;
+uniform sampler2D gDepth;
+uniform mat4 invViewProj;
+
+// Posición en mundo reconstruida desde la profundidad; la usan EvaluateLight y FindCluster.
+vec3 FragPos;
+
+layout(std140) uniform FrameConstants {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProj;
+    vec4 camPos;
+    vec4 ambientColor;
+} frame;
+
+const float PI = 3.14159265359;
+
+struct Light {
+    vec4 typeAndPadding;    // x: type (int), yzw: padding
+    vec4 position;          // xyz: position, w: range (<= 0: sin límite ni atenuación)
+    vec4 direction;         // xyz: direction, w: padding
+    vec4 colorAndIntensity; // rgb: color, a: intensity
+    vec4 spotParams;        // x: cutOff, y: outerCutOff, z,w: padding
+};
+
+// Clustered forward (ver LightClusterGrid): el fragmento solo evalúa las luces de su cluster.
+layout(std140) uniform LightBlock {
+    uvec4 clusterGrid;  // xyz: clusters por eje, w: luces sin rango al principio de lightIndices
+    vec4 clusterDepth;  // slice = log(profundidad) * x + y
+};
+
+layout(std430) readonly buffer LightBuffer {
+    Light lights[];
+};
+
+layout(std430) readonly buffer ClusterBlock {
+    uvec2 clusters[]; // x: offset en lightIndices, y: número de luces
+};
+
+layout(std430) readonly buffer LightIndexBlock {
+    uint lightIndices[];
+};
+
+// Sombras en cascada de una luz direccional (ver ShadowCascades y RenderSystem::RenderShadows).
+layout(std140) uniform ShadowBlock {
+    mat4 cascadeViewProj[4];
+    vec4 cascadeSplits;  // Profundidad de vista donde termina cada cascada
+    vec4 shadowParams;   // x: cascadas (0: sin sombras), y: índice de la luz, z: bias, w: tamaño de texel
+};
+uniform sampler2DArrayShadow shadowMap;
+
+// Atlas de sombras de luces puntuales (ver PointShadowScheduler): una entrada por luz del LightBuffer.
+layout(std430) readonly buffer PointShadowBlock {
+    vec4 pointShadows[]; // x: slot del atlas (< 0: sin sombra), y: near, z: far
+};
+uniform samplerCubeArrayShadow pointShadowMap;
+
+vec3 fresnelSchlick(float cosTheta, vec3 F0) {
+    return F0 + (1.0 - F0) * pow(1.0 - cosTheta, 5.0);
+}
+
+float DistributionGGX(vec3 N, vec3 H, float roughness) {
+    float a = roughness * roughness;
+    float a2 = a * a;
+    float NdotH = max(dot(N, H), 0.0);
+    float denom = PI * pow(NdotH * NdotH * (a2 - 1.0) + 1.0, 2.0);
+    return a2 / max(denom, 0.001);
+}
+
+float GeometrySchlickGGX(float NdotV, float roughness) {
+    float k = pow(roughness + 1.0, 2.0) / 8.0;
+    return NdotV / (NdotV * (1.0 - k) + k);
+}
+
+float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness) {
+    float ggx1 = GeometrySchlickGGX(max(dot(N, V), 0.0), roughness);
+    float ggx2 = GeometrySchlickGGX(max(dot(N, L), 0.0), roughness);
+    return ggx1 * ggx2;
+}
+
+vec3 EvaluateLight(Light light, vec3 N, vec3 V, vec3 F0, vec3 albedoColor, float metallic, float roughness) {
+    int lightType = int(light.typeAndPadding.x);
+    vec3 toLight = lightType == 2 ? -light.direction.xyz : light.position.xyz - FragPos;
+    vec3 L = normalize(toLight);
+    vec3 H = normalize(V + L);
+    float NdotL = max(dot(N, L), 0.0);
+    
+    float NDF = DistributionGGX(N, H, roughness);
+    float G = GeometrySmith(N, V, L, roughness);
+    vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
+    
+    vec3 specular = (NDF * G * F) / (4.0 * max(dot(N, V), 0.0) * NdotL + 0.001);
+    vec3 kS = F;
+    vec3 kD = (vec3(1.0) - kS) * (1.0 - metallic);
+    
+    // Con rango: cuadrática inversa con una ventana que llega a 0 en el rango (donde el clustering la descarta).
+    float attenuation = 1.0;
+    float range = light.position.w;
+    if (range > 0.0) {
+        float distance = length(toLight);
+        float window = clamp(1.0 - pow(distance / range, 4.0), 0.0, 1.0);
+        attenuation = window * window / (distance * distance + 1.0);
+    }
+    
+    vec3 radiance = light.colorAndIntensity.rgb * light.colorAndIntensity.a * attenuation;
+    if (lightType == 0 || lightType == 2) {
+        return (kD * albedoColor / PI + specular) * radiance * NdotL;
+    } else if (lightType == 1) {
+        float cutOff = light.spotParams.x;
+        float outerCutOff = light.spotParams.y;
+        float theta = dot(L, normalize(-light.direction.xyz));
+        float epsilon = cutOff - outerCutOff;
+        float intensity = clamp((theta - outerCutOff) / epsilon, 0.0, 1.0);
+        return intensity * ((kD * albedoColor / PI + specular) * radiance * NdotL);
+    }
+    return vec3(0.0);
+}
+
+// PCF 3x3 en la primera cascada que cubre la profundidad de vista del fragmento.
+float ShadowFactor(float viewDepth) {
+    int cascadeCount = int(shadowParams.x);
+    for (int c = 0; c < cascadeCount; ++c) {
+        if (viewDepth > cascadeSplits[c])
+            continue;
+        vec4 clip = cascadeViewProj[c] * vec4(FragPos, 1.0);
+        vec3 coord = clip.xyz / clip.w * 0.5 + 0.5;
+        float lit = 0.0;
+        for (int y = -1; y <= 1; ++y)
+            for (int x = -1; x <= 1; ++x)
+                lit += texture(shadowMap, vec4(coord.xy + vec2(x, y) * shadowParams.w, float(c), coord.z - shadowParams.z));
+        return lit / 9.0;
+    }
+    return 1.0;
+}
+
+// Profundidad de la cara del cubo que ve el fragmento, con la misma proyección de 90° con la que se renderizó.
+float PointShadowFactor(vec4 info, vec3 lightPos) {
+    vec3 L = FragPos - lightPos;
+    float z = max(max(abs(L.x), abs(L.y)), abs(L.z));
+    float n = info.y;
+    float f = info.z;
+    if (z >= f)
+        return 1.0;
+    float depth = ((f + n) / (f - n) - (2.0 * f * n) / ((f - n) * z)) * 0.5 + 0.5;
+    return texture(pointShadowMap, vec4(L, info.x), depth - 0.0005);
+}
+
+// Contribución de una luz con su sombra (cascadas para la direccional, atlas de cubos para las puntuales).
+vec3 ShadeLight(uint index, vec3 N, vec3 V, vec3 F0, vec3 albedoColor, float metallic, float roughness) {
+    Light light = lights[index];
+    vec3 contribution = EvaluateLight(light, N, V, F0, albedoColor, metallic, roughness);
+    if (shadowParams.x > 0.0 && index == uint(shadowParams.y))
+        contribution *= ShadowFactor(-(frame.view * vec4(FragPos, 1.0)).z);
+    else if (index < uint(pointShadows.length()) && pointShadows[index].x >= 0.0)
+        contribution *= PointShadowFactor(pointShadows[index], light.position.xyz);
+    return contribution;
+}
+
+uint FindCluster() {
+    vec4 clip = frame.viewProj * vec4(FragPos, 1.0);
+    vec2 ndc = clip.xy / clip.w;
+    float depth = max(-(frame.view * vec4(FragPos, 1.0)).z, 1e-4);
+    ivec3 cell;
+    cell.xy = clamp(ivec2(floor((ndc * 0.5 + 0.5) * vec2(clusterGrid.xy))), ivec2(0), ivec2(clusterGrid.xy) - 1);
+    cell.z = clamp(int(floor(log(depth) * clusterDepth.x + clusterDepth.y)), 0, int(clusterGrid.z) - 1);
+    return (uint(cell.z) * clusterGrid.y + uint(cell.y)) * clusterGrid.x + uint(cell.x);
+}
+
+vec3 OctDecode(vec2 e) {
+    vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (v.z < 0.0)
+        v.xy = (1.0 - abs(e.yx)) * vec2(e.x >= 0.0 ? 1.0 : -1.0, e.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(v);
+}
+
+void main() {
+    float depth = texture(gDepth, ScreenUV).r;
+    if (depth >= 1.0)
+        discard; // Fondo: se conserva el color de limpiado.
+    
+    vec4 worldPos = invViewProj * vec4(vec3(ScreenUV, depth) * 2.0 - 1.0, 1.0);
+    FragPos = worldPos.xyz / worldPos.w;
+    
+    vec4 albedoMetallic = texture(gAlbedoMetallic, ScreenUV);
+    vec4 normalRoughness = texture(gNormalRoughness, ScreenUV);
+    vec3 albedoColor = albedoMetallic.rgb;
+    float metallic = albedoMetallic.a;
+    float roughness = normalRoughness.b;
+    vec3 N = OctDecode(normalRoughness.rg * 2.0 - 1.0);
+    vec3 emissive = texture(gEmissive, ScreenUV).rgb;
+    
+    vec3 F0 = mix(vec3(0.04), albedoColor, metallic);
+    vec3 V = normalize(frame.camPos.xyz - FragPos);
+    
+    vec3 result = vec3(0.0);
+    for (uint i = 0u; i < clusterGrid.w; ++i)
+        result += ShadeLight(lightIndices[i], N, V, F0, albedoColor, metallic, roughness);
+    uvec2 cluster = clusters[FindCluster()];
+    for (uint i = 0u; i < cluster.y; ++i)
+        result += ShadeLight(lightIndices[cluster.x + i], N, V, F0, albedoColor, metallic, roughness);
+    
+    result += frame.ambientColor.rgb * albedoColor + emissive;
+    FragColor = vec4(result, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#version 430 core
+// Triángulo a pantalla completa sin buffers de vértices (se dibuja con un VAO vacío y 3 vértices).
+out vec2 ScreenUV;
+
+void main()
+{
+    vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    ScreenUV = corner;
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
\ No newline at end of file
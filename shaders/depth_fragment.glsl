@@ -0,0 +1,6 @@
+#version 430 core
+// Sin salidas de color: la pre-pasada solo escribe profundidad.
+
+void main()
+{
+}
\ No newline at end of file
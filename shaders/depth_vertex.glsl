@@ -0,0 +1,29 @@
+#version 430 core
+// Pre-pasada de profundidad: solo posición. Debe calcular gl_Position exactamente igual que
+// pbr_vertex.glsl para que la pasada PBR posterior pueda usar GL_EQUAL.
+layout (location = 0) in vec4 aPos;
+
+layout(std430) readonly buffer InstanceBlock {
+    mat4 instanceModels[];
+};
+uniform int instanceOffset;
+uniform bool compactVertices;
+uniform vec3 posOffset;
+uniform vec3 posScale;
+
+layout(std140) uniform FrameConstants {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProj;
+    vec4 camPos;
+    vec4 ambientColor;
+} frame;
+
+invariant gl_Position;
+
+void main()
+{
+    vec3 position = compactVertices ? posOffset + posScale * aPos.xyz : aPos.xyz;
+    mat4 model = instanceModels[instanceOffset + gl_InstanceID];
+    gl_Position = frame.viewProj * (model * vec4(position, 1.0));
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#version 430 core
+
+// Variantes (ver ShaderVariants.h): sin SHADER_VARIANT este es el ubershader, que tiene todas las
+// features y decide en runtime con textureFlags; una variante solo define las que usa su material.
+#define ALPHA_MODE_OPAQUE 0
+#define ALPHA_MODE_BLEND 2
+#ifndef SHADER_VARIANT
+#define HAS_ALBEDO_MAP
+#define HAS_MR_MAP
+#define HAS_NORMAL_MAP
+#define HAS_EMISSIVE_MAP
+#define ALPHA_MODE ALPHA_MODE_BLEND
+#define MATERIAL_HAS(flags, bit) (((flags) & (bit)) != 0u)
+#else
+#define MATERIAL_HAS(flags, bit) true
+#endif
+
+in vec3 FragPos;
+in vec2 TexCoords;
+in mat3 TBN;
+
+// Targets de GBuffer (ver GBuffer.h).
+layout(location = 0) out vec4 gAlbedoMetallic;   // rgb: albedo, a: metallic
+layout(location = 1) out vec4 gNormalRoughness;  // rg: normal octaédrica, b: roughness
+layout(location = 2) out vec3 gEmissive;
+
+uniform sampler2D albedoMap;           // sRGB
+uniform sampler2D metallicRoughnessMap;  // Red: metallic, Green: roughness
+uniform sampler2D normalMap;             // Normal map
+uniform sampler2D emissiveMap;           // sRGB
+uniform int materialID;                  // Índice en MaterialBlock
+
+layout(std140) uniform FrameConstants {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProj;
+    vec4 camPos;
+    vec4 ambientColor;
+} frame;
+
+// Debe coincidir con GPUMaterial (MaterialTable.h) y MaterialTextureFlags (Material.h).
+struct MaterialData {
+    vec4 baseColorFactor;
+    vec4 emissiveFactor;    // rgb: emisivo, a: ior
+    vec4 pbrParams;         // x: metallic, y: roughness, z: clearcoat, w: clearcoatRoughness
+    float transmissionFactor;
+    uint textureFlags;
+    uint padding0;
+    uint padding1;
+};
+
+const uint ALBEDO_MAP_FLAG = 1u;
+const uint METALLIC_ROUGHNESS_MAP_FLAG = 2u;
+const uint NORMAL_MAP_FLAG = 4u;
+const uint EMISSIVE_MAP_FLAG = 16u;
+
+layout(std430) readonly buffer MaterialBlock {
+    MaterialData materials[];
+};
+
+vec2 OctEncode(vec3 n) {
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    if (n.z < 0.0)
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return n.xy;
+}
+
+void main() {
+    MaterialData material = materials[materialID];
+    uint flags = material.textureFlags;
+    
+    vec4 baseColor = material.baseColorFactor;
+#ifdef HAS_ALBEDO_MAP
+    if (MATERIAL_HAS(flags, ALBEDO_MAP_FLAG))
+        baseColor *= texture(albedoMap, TexCoords);
+#endif
+    vec3 albedoColor = baseColor.rgb;
+    
+    float metallic = material.pbrParams.x;
+    float roughness = material.pbrParams.y;
+#ifdef HAS_MR_MAP
+    if (MATERIAL_HAS(flags, METALLIC_ROUGHNESS_MAP_FLAG)) {
+        vec2 metallicRoughness = texture(metallicRoughnessMap, TexCoords).rg;
+        metallic *= metallicRoughness.r;
+        roughness *= metallicRoughness.g;
+    }
+#endif
+    
+    vec3 N = normalize(TBN[2]);
+#ifdef HAS_NORMAL_MAP
+    if (MATERIAL_HAS(flags, NORMAL_MAP_FLAG)) {
+        vec3 tangentNormal = texture(normalMap, TexCoords).rgb * 2.0 - 1.0;
+        // Para modelos glTF no se invierte el canal verde:
+        // tangentNormal.y = -tangentNormal.y;
+        N = normalize(TBN * tangentNormal);
+    }
+#endif
+    
+    vec3 emissive = material.emissiveFactor.rgb;
+#ifdef HAS_EMISSIVE_MAP
+    if (MATERIAL_HAS(flags, EMISSIVE_MAP_FLAG))
+        emissive *= texture(emissiveMap, TexCoords).rgb;
+#endif
+    
+    gAlbedoMetallic = vec4(albedoColor, metallic);
+    gNormalRoughness = vec4(OctEncode(N) * 0.5 + 0.5, roughness, 0.0);
+    gEmissive = emissive;
+}
\ No newline at end of file
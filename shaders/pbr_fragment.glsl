@@ -1,4 +1,22 @@
-#version 330 core
+#version 430 core
+
+// Variantes (ver ShaderVariants.h): sin SHADER_VARIANT este es el ubershader, que tiene todas las
+// features y decide en runtime con textureFlags; una variante solo define las que usa su material.
+#define ALPHA_MODE_OPAQUE 0
+#define ALPHA_MODE_BLEND 2
+#ifndef SHADER_VARIANT
+#define HAS_ALBEDO_MAP
+#define HAS_MR_MAP
+#define HAS_NORMAL_MAP
+#define HAS_EMISSIVE_MAP
+#define ALPHA_MODE ALPHA_MODE_BLEND
+#define MATERIAL_HAS(flags, bit) (((flags) & (bit)) != 0u)
+#else
+#define MATERIAL_HAS(flags, bit) true
+#endif
+#ifndef MAX_LIGHTS
+#define MAX_LIGHTS 256u
+#endif
 
 in vec3 FragPos;
 in vec2 TexCoords;
@@ -9,24 +27,79 @@ out vec4 FragColor;
 uniform sampler2D albedoMap;           // sRGB
 uniform sampler2D metallicRoughnessMap;  // Red: metallic, Green: roughness
 uniform sampler2D normalMap;             // Normal map
-uniform bool useMaps;
-uniform vec3 camPos;
-uniform vec3 ambientColor;
+uniform sampler2D emissiveMap;           // sRGB
+uniform int materialID;                  // Índice en MaterialBlock
+
+layout(std140) uniform FrameConstants {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProj;
+    vec4 camPos;
+    vec4 ambientColor;
+} frame;
 
 const float PI = 3.14159265359;
 
+// Debe coincidir con GPUMaterial (MaterialTable.h) y MaterialTextureFlags (Material.h).
+struct MaterialData {
+    vec4 baseColorFactor;
+    vec4 emissiveFactor;    // rgb: emisivo, a: ior
+    vec4 pbrParams;         // x: metallic, y: roughness, z: clearcoat, w: clearcoatRoughness
+    float transmissionFactor;
+    uint textureFlags;
+    uint padding0;
+    uint padding1;
+};
+
+const uint ALBEDO_MAP_FLAG = 1u;
+const uint METALLIC_ROUGHNESS_MAP_FLAG = 2u;
+const uint NORMAL_MAP_FLAG = 4u;
+const uint EMISSIVE_MAP_FLAG = 16u;
+
+layout(std430) readonly buffer MaterialBlock {
+    MaterialData materials[];
+};
+
 struct Light {
     vec4 typeAndPadding;    // x: type (int), yzw: padding
-    vec4 position;          // xyz: position, w: padding
+    vec4 position;          // xyz: position, w: range (<= 0: sin límite ni atenuación)
     vec4 direction;         // xyz: direction, w: padding
     vec4 colorAndIntensity; // rgb: color, a: intensity
     vec4 spotParams;        // x: cutOff, y: outerCutOff, z,w: padding
 };
 
+// Clustered forward (ver LightClusterGrid): el fragmento solo evalúa las luces de su cluster.
 layout(std140) uniform LightBlock {
-    Light lights[10];
+    uvec4 clusterGrid;  // xyz: clusters por eje, w: luces sin rango al principio de lightIndices
+    vec4 clusterDepth;  // slice = log(profundidad) * x + y
+};
+
+layout(std430) readonly buffer LightBuffer {
+    Light lights[];
+};
+
+layout(std430) readonly buffer ClusterBlock {
+    uvec2 clusters[]; // x: offset en lightIndices, y: número de luces
 };
 
+layout(std430) readonly buffer LightIndexBlock {
+    uint lightIndices[];
+};
+
+// Sombras en cascada de una luz direccional (ver ShadowCascades y RenderSystem::RenderShadows).
+layout(std140) uniform ShadowBlock {
+    mat4 cascadeViewProj[4];
+    vec4 cascadeSplits;  // Profundidad de vista donde termina cada cascada
+    vec4 shadowParams;   // x: cascadas (0: sin sombras), y: índice de la luz, z: bias, w: tamaño de texel
+};
+uniform sampler2DArrayShadow shadowMap;
+
+// Atlas de sombras de luces puntuales (ver PointShadowScheduler): una entrada por luz del LightBuffer.
+layout(std430) readonly buffer PointShadowBlock {
+    vec4 pointShadows[]; // x: slot del atlas (< 0: sin sombra), y: near, z: far
+};
+uniform samplerCubeArrayShadow pointShadowMap;
+
 vec3 fresnelSchlick(float cosTheta, vec3 F0) {
     return F0 + (1.0 - F0) * pow(1.0 - cosTheta, 5.0);
 }
@@ -50,54 +123,146 @@ float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness) {
     return ggx1 * ggx2;
 }
 
+vec3 EvaluateLight(Light light, vec3 N, vec3 V, vec3 F0, vec3 albedoColor, float metallic, float roughness) {
+    int lightType = int(light.typeAndPadding.x);
+    vec3 toLight = lightType == 2 ? -light.direction.xyz : light.position.xyz - FragPos;
+    vec3 L = normalize(toLight);
+    vec3 H = normalize(V + L);
+    float NdotL = max(dot(N, L), 0.0);
+    
+    float NDF = DistributionGGX(N, H, roughness);
+    float G = GeometrySmith(N, V, L, roughness);
+    vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
+    
+    vec3 specular = (NDF * G * F) / (4.0 * max(dot(N, V), 0.0) * NdotL + 0.001);
+    vec3 kS = F;
+    vec3 kD = (vec3(1.0) - kS) * (1.0 - metallic);
+    
+    // Con rango: cuadrática inversa con una ventana que llega a 0 en el rango (donde el clustering la descarta).
+    float attenuation = 1.0;
+    float range = light.position.w;
+    if (range > 0.0) {
+        float distance = length(toLight);
+        float window = clamp(1.0 - pow(distance / range, 4.0), 0.0, 1.0);
+        attenuation = window * window / (distance * distance + 1.0);
+    }
+    
+    vec3 radiance = light.colorAndIntensity.rgb * light.colorAndIntensity.a * attenuation;
+    if (lightType == 0 || lightType == 2) {
+        return (kD * albedoColor / PI + specular) * radiance * NdotL;
+    } else if (lightType == 1) {
+        float cutOff = light.spotParams.x;
+        float outerCutOff = light.spotParams.y;
+        float theta = dot(L, normalize(-light.direction.xyz));
+        float epsilon = cutOff - outerCutOff;
+        float intensity = clamp((theta - outerCutOff) / epsilon, 0.0, 1.0);
+        return intensity * ((kD * albedoColor / PI + specular) * radiance * NdotL);
+    }
+    return vec3(0.0);
+}
+
+// PCF 3x3 en la primera cascada que cubre la profundidad de vista del fragmento.
+float ShadowFactor(float viewDepth) {
+    int cascadeCount = int(shadowParams.x);
+    for (int c = 0; c < cascadeCount; ++c) {
+        if (viewDepth > cascadeSplits[c])
+            continue;
+        vec4 clip = cascadeViewProj[c] * vec4(FragPos, 1.0);
+        vec3 coord = clip.xyz / clip.w * 0.5 + 0.5;
+        float lit = 0.0;
+        for (int y = -1; y <= 1; ++y)
+            for (int x = -1; x <= 1; ++x)
+                lit += texture(shadowMap, vec4(coord.xy + vec2(x, y) * shadowParams.w, float(c), coord.z - shadowParams.z));
+        return lit / 9.0;
+    }
+    return 1.0;
+}
+
+// Profundidad de la cara del cubo que ve el fragmento, con la misma proyección de 90° con la que se renderizó.
+float PointShadowFactor(vec4 info, vec3 lightPos) {
+    vec3 L = FragPos - lightPos;
+    float z = max(max(abs(L.x), abs(L.y)), abs(L.z));
+    float n = info.y;
+    float f = info.z;
+    if (z >= f)
+        return 1.0;
+    float depth = ((f + n) / (f - n) - (2.0 * f * n) / ((f - n) * z)) * 0.5 + 0.5;
+    return texture(pointShadowMap, vec4(L, info.x), depth - 0.0005);
+}
+
+// Contribución de una luz con su sombra (cascadas para la direccional, atlas de cubos para las puntuales).
+vec3 ShadeLight(uint index, vec3 N, vec3 V, vec3 F0, vec3 albedoColor, float metallic, float roughness) {
+    Light light = lights[index];
+    vec3 contribution = EvaluateLight(light, N, V, F0, albedoColor, metallic, roughness);
+    if (shadowParams.x > 0.0 && index == uint(shadowParams.y))
+        contribution *= ShadowFactor(-(frame.view * vec4(FragPos, 1.0)).z);
+    else if (index < uint(pointShadows.length()) && pointShadows[index].x >= 0.0)
+        contribution *= PointShadowFactor(pointShadows[index], light.position.xyz);
+    return contribution;
+}
+
+uint FindCluster() {
+    vec4 clip = frame.viewProj * vec4(FragPos, 1.0);
+    vec2 ndc = clip.xy / clip.w;
+    float depth = max(-(frame.view * vec4(FragPos, 1.0)).z, 1e-4);
+    ivec3 cell;
+    cell.xy = clamp(ivec2(floor((ndc * 0.5 + 0.5) * vec2(clusterGrid.xy))), ivec2(0), ivec2(clusterGrid.xy) - 1);
+    cell.z = clamp(int(floor(log(depth) * clusterDepth.x + clusterDepth.y)), 0, int(clusterGrid.z) - 1);
+    return (uint(cell.z) * clusterGrid.y + uint(cell.y)) * clusterGrid.x + uint(cell.x);
+}
+
 void main() {
-    vec4 albedoSample = texture(albedoMap, TexCoords);
-    vec3 albedoColor = albedoSample.rgb;
-    float alpha = albedoSample.a;
+    MaterialData material = materials[materialID];
+    uint flags = material.textureFlags;
+    
+    vec4 baseColor = material.baseColorFactor;
+#ifdef HAS_ALBEDO_MAP
+    if (MATERIAL_HAS(flags, ALBEDO_MAP_FLAG))
+        baseColor *= texture(albedoMap, TexCoords);
+#endif
+    vec3 albedoColor = baseColor.rgb;
+#if ALPHA_MODE == ALPHA_MODE_OPAQUE
+    float alpha = 1.0;
+#else
+    float alpha = baseColor.a;
+#endif
+    
+    float metallic = material.pbrParams.x;
+    float roughness = material.pbrParams.y;
+#ifdef HAS_MR_MAP
+    if (MATERIAL_HAS(flags, METALLIC_ROUGHNESS_MAP_FLAG)) {
+        vec2 metallicRoughness = texture(metallicRoughnessMap, TexCoords).rg;
+        metallic *= metallicRoughness.r;
+        roughness *= metallicRoughness.g;
+    }
+#endif
+    
+    vec3 N = normalize(TBN[2]);
+#ifdef HAS_NORMAL_MAP
+    if (MATERIAL_HAS(flags, NORMAL_MAP_FLAG)) {
+        vec3 tangentNormal = texture(normalMap, TexCoords).rgb * 2.0 - 1.0;
+        // Para modelos glTF no se invierte el canal verde:
+        // tangentNormal.y = -tangentNormal.y;
+        N = normalize(TBN * tangentNormal);
+    }
+#endif
     
-    float metallic = useMaps ? texture(metallicRoughnessMap, TexCoords).r : 0.0;
-    float roughness = useMaps ? texture(metallicRoughnessMap, TexCoords).g : 1.0;
-    vec3 tangentNormal = useMaps ? texture(normalMap, TexCoords).rgb : vec3(0.5, 0.5, 1.0);
-    tangentNormal = tangentNormal * 2.0 - 1.0;
-    // Para modelos glTF no se invierte el canal verde:
-    // tangentNormal.y = -tangentNormal.y;
-    vec3 N = normalize(TBN * tangentNormal);
+    vec3 emissive = material.emissiveFactor.rgb;
+#ifdef HAS_EMISSIVE_MAP
+    if (MATERIAL_HAS(flags, EMISSIVE_MAP_FLAG))
+        emissive *= texture(emissiveMap, TexCoords).rgb;
+#endif
     
     vec3 F0 = mix(vec3(0.04), albedoColor, metallic);
-    vec3 V = normalize(camPos - FragPos);
+    vec3 V = normalize(frame.camPos.xyz - FragPos);
     
     vec3 result = vec3(0.0);
-    for (int i = 0; i < 10; ++i) {
-        if (int(lights[i].typeAndPadding.x) == -1)
-            continue;
-        
-        vec3 lightPos = lights[i].position.xyz;
-        vec3 L = normalize(lightPos - FragPos);
-        vec3 H = normalize(V + L);
-        float NdotL = max(dot(N, L), 0.0);
-        
-        float NDF = DistributionGGX(N, H, roughness);
-        float G = GeometrySmith(N, V, L, roughness);
-        vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
-        
-        vec3 specular = (NDF * G * F) / (4.0 * max(dot(N, V), 0.0) * NdotL + 0.001);
-        vec3 kS = F;
-        vec3 kD = (vec3(1.0) - kS) * (1.0 - metallic);
-        
-        int lightType = int(lights[i].typeAndPadding.x);
-        if (lightType == 0) {
-            result += (kD * albedoColor / PI + specular) * lights[i].colorAndIntensity.rgb * lights[i].colorAndIntensity.a * NdotL;
-        } else if (lightType == 1) {
-            float cutOff = lights[i].spotParams.x;
-            float outerCutOff = lights[i].spotParams.y;
-            float theta = dot(L, normalize(-lights[i].direction.xyz));
-            float epsilon = cutOff - outerCutOff;
-            float intensity = clamp((theta - outerCutOff) / epsilon, 0.0, 1.0);
-            result += intensity * ((kD * albedoColor / PI + specular) *
-                      lights[i].colorAndIntensity.rgb * lights[i].colorAndIntensity.a * NdotL);
-        }
-    }
+    for (uint i = 0u; i < clusterGrid.w; ++i)
+        result += ShadeLight(lightIndices[i], N, V, F0, albedoColor, metallic, roughness);
+    uvec2 cluster = clusters[FindCluster()];
+    for (uint i = 0u; i < min(cluster.y, MAX_LIGHTS); ++i)
+        result += ShadeLight(lightIndices[cluster.x + i], N, V, F0, albedoColor, metallic, roughness);
     
-    result += ambientColor * albedoColor;
+    result += frame.ambientColor.rgb * albedoColor + emissive;
     FragColor = vec4(result, alpha);
 }
\ No newline at end of file
@@ -1,32 +1,80 @@
-#version 330 core
-layout (location = 0) in vec3 aPos;
+#version 430 core
+// Con el formato compacto: aPos = unorm16 (xyz cuantizadas, w = signo de la bitangente),
+// aNormal.xy / aTangent.xy = normal y tangente en codificación octaédrica (snorm16).
+layout (location = 0) in vec4 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
-layout (location = 3) in vec3 aTangent;
+layout (location = 3) in vec4 aTangent;    // w: signo de la bitangente
 layout (location = 4) in vec2 aTexCoords2; // Segundo conjunto de UV
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+// Matrices de modelo de los draws del frame; este draw usa instanceModels[instanceOffset + gl_InstanceID].
+layout(std430) readonly buffer InstanceBlock {
+    mat4 instanceModels[];
+};
+// Matrices normales de los mismos draws, calculadas en CPU (ver RenderSystem::UploadNormalMatrices).
+layout(std430) readonly buffer NormalMatrixBlock {
+    mat3 instanceNormals[];
+};
+uniform int instanceOffset;
+uniform bool compactVertices;
+// Posición en modelo = posOffset + posScale * aPos.xyz (solo formato compacto).
+uniform vec3 posOffset;
+uniform vec3 posScale;
+
+layout(std140) uniform FrameConstants {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProj;
+    vec4 camPos;
+    vec4 ambientColor;
+} frame;
 
 out vec3 FragPos;
 out vec2 TexCoords;
 out vec2 TexCoords2; // Se pasa el segundo conjunto de UV
 out mat3 TBN;
 
+// La pre-pasada de profundidad (depth_vertex.glsl) calcula la misma posición: necesario para GL_EQUAL.
+invariant gl_Position;
+
+vec3 OctDecode(vec2 e)
+{
+    vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (v.z < 0.0)
+        v.xy = (1.0 - abs(e.yx)) * vec2(e.x >= 0.0 ? 1.0 : -1.0, e.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(v);
+}
+
 void main()
 {
-    vec4 worldPos = model * vec4(aPos, 1.0);
+    vec3 position;
+    vec3 normal;
+    vec3 tangent;
+    float handedness;
+    if (compactVertices) {
+        position = posOffset + posScale * aPos.xyz;
+        normal = OctDecode(aNormal.xy);
+        tangent = OctDecode(aTangent.xy);
+        handedness = aPos.w > 0.5 ? 1.0 : -1.0;
+    } else {
+        position = aPos.xyz;
+        normal = aNormal;
+        tangent = aTangent.xyz;
+        handedness = aTangent.w < 0.0 ? -1.0 : 1.0;
+    }
+
+    int instance = instanceOffset + gl_InstanceID;
+    vec4 worldPos = instanceModels[instance] * vec4(position, 1.0);
     FragPos = worldPos.xyz;
     TexCoords = aTexCoords;
     TexCoords2 = aTexCoords2;
     
-    mat3 normalMatrix = transpose(inverse(mat3(model)));
-    vec3 N = normalize(normalMatrix * aNormal);
-    vec3 T = normalize(normalMatrix * aTangent);
+    mat3 normalMatrix = instanceNormals[instance];
+    vec3 N = normalize(normalMatrix * normal);
+    vec3 T = normalize(normalMatrix * tangent);
     T = normalize(T - N * dot(N, T));
-    vec3 B = cross(N, T);
+    vec3 B = cross(N, T) * handedness;
     TBN = mat3(T, B, N);
     
-    gl_Position = projection * view * worldPos;
+    gl_Position = frame.viewProj * worldPos;
 }
\ No newline at end of file
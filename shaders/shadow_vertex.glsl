@@ -0,0 +1,19 @@
+#version 430 core
+// Oclusores de una cascada de sombra: solo posición, con la matriz de la luz en lugar de la de la cámara.
+layout (location = 0) in vec4 aPos;
+
+layout(std430) readonly buffer InstanceBlock {
+    mat4 instanceModels[];
+};
+uniform int instanceOffset;
+uniform bool compactVertices;
+uniform vec3 posOffset;
+uniform vec3 posScale;
+uniform mat4 shadowViewProj;
+
+void main()
+{
+    vec3 position = compactVertices ? posOffset + posScale * aPos.xyz : aPos.xyz;
+    mat4 model = instanceModels[instanceOffset + gl_InstanceID];
+    gl_Position = shadowViewProj * (model * vec4(position, 1.0));
+}
\ No newline at end of file
@@ -0,0 +1,520 @@
+// AABBTree.cpp
+#include "renderer/AABBTree.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace
+{
+    AABB Union(const AABB& a, const AABB& b)
+    {
+        return AABB(glm::min(a.min, b.min), glm::max(a.max, b.max));
+    }
+}
+
+AABBTree::AABBTree(float fatMargin) : margin(fatMargin) {}
+
+int32_t AABBTree::AllocateNode() {
+    if (freeList == NullNode) {
+        nodes.emplace_back();
+        Node& node = nodes.back();
+        node.height = 0;
+        return static_cast<int32_t>(nodes.size() - 1);
+    }
+    int32_t index = freeList;
+    freeList = nodes[index].parent;
+    nodes[index] = Node();
+    nodes[index].height = 0;
+    return index;
+}
+
+void AABBTree::FreeNode(int32_t index) {
+    nodes[index].parent = freeList;
+    nodes[index].child1 = NullNode;
+    nodes[index].child2 = NullNode;
+    nodes[index].height = -1;
+    freeList = index;
+}
+
+int32_t AABBTree::CreateProxy(const AABB& box, uint32_t userData) {
+    int32_t proxy = AllocateNode();
+    glm::vec3 fat(margin);
+    nodes[proxy].box = AABB(box.min - fat, box.max + fat);
+    nodes[proxy].userData = userData;
+    nodes[proxy].height = 0;
+    InsertLeaf(proxy);
+    proxyCount++;
+    return proxy;
+}
+
+void AABBTree::DestroyProxy(int32_t proxy) {
+    assert(nodes[proxy].IsLeaf());
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    proxyCount--;
+}
+
+bool AABBTree::MoveProxy(int32_t proxy, const AABB& box) {
+    assert(nodes[proxy].IsLeaf());
+    // Mientras la caja siga dentro de la AABB engordada no hace falta tocar el árbol.
+    if (nodes[proxy].box.Contains(box))
+        return false;
+    RemoveLeaf(proxy);
+    glm::vec3 fat(margin);
+    nodes[proxy].box = AABB(box.min - fat, box.max + fat);
+    InsertLeaf(proxy);
+    return true;
+}
+
+void AABBTree::InsertLeaf(int32_t leaf) {
+    if (root == NullNode) {
+        root = leaf;
+        nodes[root].parent = NullNode;
+        return;
+    }
+
+    // Buscar el mejor hermano descendiendo por el hijo de menor coste (heurística de superficie).
+    AABB leafBox = nodes[leaf].box;
+    int32_t index = root;
+    while (!nodes[index].IsLeaf()) {
+        int32_t child1 = nodes[index].child1;
+        int32_t child2 = nodes[index].child2;
+
+        float area = nodes[index].box.SurfaceArea();
+        float combinedArea = Union(nodes[index].box, leafBox).SurfaceArea();
+        // Coste de crear un nuevo padre para este nodo y la hoja.
+        float cost = 2.0f * combinedArea;
+        // Coste mínimo de empujar la hoja más abajo.
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int32_t child) {
+            float newArea = Union(leafBox, nodes[child].box).SurfaceArea();
+            if (nodes[child].IsLeaf())
+                return newArea + inheritanceCost;
+            return (newArea - nodes[child].box.SurfaceArea()) + inheritanceCost;
+        };
+        float cost1 = descendCost(child1);
+        float cost2 = descendCost(child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+        index = (cost1 < cost2) ? child1 : child2;
+    }
+
+    int32_t sibling = index;
+    int32_t oldParent = nodes[sibling].parent;
+    int32_t newParent = AllocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].box = Union(leafBox, nodes[sibling].box);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent != NullNode) {
+        if (nodes[oldParent].child1 == sibling)
+            nodes[oldParent].child1 = newParent;
+        else
+            nodes[oldParent].child2 = newParent;
+    } else {
+        root = newParent;
+    }
+
+    // Subir corrigiendo alturas y cajas.
+    index = nodes[leaf].parent;
+    while (index != NullNode) {
+        index = Balance(index);
+        int32_t child1 = nodes[index].child1;
+        int32_t child2 = nodes[index].child2;
+        nodes[index].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+        nodes[index].box = Union(nodes[child1].box, nodes[child2].box);
+        index = nodes[index].parent;
+    }
+}
+
+void AABBTree::RemoveLeaf(int32_t leaf) {
+    if (leaf == root) {
+        root = NullNode;
+        return;
+    }
+
+    int32_t parent = nodes[leaf].parent;
+    int32_t grandParent = nodes[parent].parent;
+    int32_t sibling = (nodes[parent].child1 == leaf) ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grandParent != NullNode) {
+        // El hermano ocupa el lugar del padre.
+        if (nodes[grandParent].child1 == parent)
+            nodes[grandParent].child1 = sibling;
+        else
+            nodes[grandParent].child2 = sibling;
+        nodes[sibling].parent = grandParent;
+        FreeNode(parent);
+
+        int32_t index = grandParent;
+        while (index != NullNode) {
+            index = Balance(index);
+            int32_t child1 = nodes[index].child1;
+            int32_t child2 = nodes[index].child2;
+            nodes[index].box = Union(nodes[child1].box, nodes[child2].box);
+            nodes[index].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+            index = nodes[index].parent;
+        }
+    } else {
+        root = sibling;
+        nodes[sibling].parent = NullNode;
+        FreeNode(parent);
+    }
+}
+
+// Rota el subárbol si está desbalanceado. Devuelve la nueva raíz del subárbol.
+int32_t AABBTree::Balance(int32_t iA) {
+    Node& A = nodes[iA];
+    if (A.IsLeaf() || A.height < 2)
+        return iA;
+
+    int32_t iB = A.child1;
+    int32_t iC = A.child2;
+    int32_t balance = nodes[iC].height - nodes[iB].height;
+
+    // Rotar C hacia arriba.
+    if (balance > 1) {
+        int32_t iF = nodes[iC].child1;
+        int32_t iG = nodes[iC].child2;
+        Node& C = nodes[iC];
+
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+
+        if (C.parent != NullNode) {
+            if (nodes[C.parent].child1 == iA)
+                nodes[C.parent].child1 = iC;
+            else
+                nodes[C.parent].child2 = iC;
+        } else {
+            root = iC;
+        }
+
+        Node& B = nodes[iB];
+        Node& F = nodes[iF];
+        Node& G = nodes[iG];
+        if (F.height > G.height) {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.box = Union(B.box, G.box);
+            C.box = Union(A.box, F.box);
+            A.height = 1 + std::max(B.height, G.height);
+            C.height = 1 + std::max(A.height, F.height);
+        } else {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.box = Union(B.box, F.box);
+            C.box = Union(A.box, G.box);
+            A.height = 1 + std::max(B.height, F.height);
+            C.height = 1 + std::max(A.height, G.height);
+        }
+        return iC;
+    }
+
+    // Rotar B hacia arriba.
+    if (balance < -1) {
+        int32_t iD = nodes[iB].child1;
+        int32_t iE = nodes[iB].child2;
+        Node& B = nodes[iB];
+
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+
+        if (B.parent != NullNode) {
+            if (nodes[B.parent].child1 == iA)
+                nodes[B.parent].child1 = iB;
+            else
+                nodes[B.parent].child2 = iB;
+        } else {
+            root = iB;
+        }
+
+        Node& C = nodes[iC];
+        Node& D = nodes[iD];
+        Node& E = nodes[iE];
+        if (D.height > E.height) {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.box = Union(C.box, E.box);
+            B.box = Union(A.box, D.box);
+            A.height = 1 + std::max(C.height, E.height);
+            B.height = 1 + std::max(A.height, D.height);
+        } else {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.box = Union(C.box, D.box);
+            B.box = Union(A.box, E.box);
+            A.height = 1 + std::max(C.height, D.height);
+            B.height = 1 + std::max(A.height, E.height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+void AABBTree::Rebuild() {
+    std::vector<int32_t> leaves;
+    leaves.reserve(proxyCount);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].height < 0)
+            continue;
+        if (nodes[i].IsLeaf()) {
+            leaves.push_back(static_cast<int32_t>(i));
+        } else {
+            FreeNode(static_cast<int32_t>(i));
+        }
+    }
+    root = leaves.empty() ? NullNode : BuildRange(leaves, 0, leaves.size());
+    if (root != NullNode)
+        nodes[root].parent = NullNode;
+}
+
+// Construcción top-down: se parte por el eje de mayor extensión de los centroides
+// eligiendo el corte con menor coste SAH entre kBins candidatos.
+int32_t AABBTree::BuildRange(std::vector<int32_t>& leaves, size_t begin, size_t end) {
+    const size_t count = end - begin;
+    if (count == 1)
+        return leaves[begin];
+
+    AABB centroidBounds;
+    for (size_t i = begin; i < end; ++i)
+        centroidBounds.Expand(nodes[leaves[i]].box.Center());
+    glm::vec3 extent = centroidBounds.max - centroidBounds.min;
+    int axis = (extent.x > extent.y && extent.x > extent.z) ? 0 : (extent.y > extent.z ? 1 : 2);
+
+    size_t mid = begin + count / 2;
+    if (extent[axis] > 0.0f && count > 4) {
+        constexpr int kBins = 12;
+        AABB binBoxes[kBins];
+        size_t binCounts[kBins] = {};
+        float scale = kBins / extent[axis];
+        auto binOf = [&](int32_t leaf) {
+            int b = static_cast<int>((nodes[leaf].box.Center()[axis] - centroidBounds.min[axis]) * scale);
+            return std::min(std::max(b, 0), kBins - 1);
+        };
+        for (size_t i = begin; i < end; ++i) {
+            int b = binOf(leaves[i]);
+            binCounts[b]++;
+            binBoxes[b].Expand(nodes[leaves[i]].box);
+        }
+
+        // Barrido de izquierda a derecha y de derecha a izquierda para evaluar cada corte.
+        float leftArea[kBins - 1], rightArea[kBins - 1];
+        size_t leftCount[kBins - 1], rightCount[kBins - 1];
+        AABB accum;
+        size_t accumCount = 0;
+        for (int i = 0; i < kBins - 1; ++i) {
+            accum.Expand(binBoxes[i]);
+            accumCount += binCounts[i];
+            leftArea[i] = accum.IsValid() ? accum.SurfaceArea() : 0.0f;
+            leftCount[i] = accumCount;
+        }
+        accum = AABB();
+        accumCount = 0;
+        for (int i = kBins - 1; i > 0; --i) {
+            accum.Expand(binBoxes[i]);
+            accumCount += binCounts[i];
+            rightArea[i - 1] = accum.IsValid() ? accum.SurfaceArea() : 0.0f;
+            rightCount[i - 1] = accumCount;
+        }
+        int bestSplit = -1;
+        float bestCost = 0.0f;
+        for (int i = 0; i < kBins - 1; ++i) {
+            if (leftCount[i] == 0 || rightCount[i] == 0)
+                continue;
+            float cost = leftArea[i] * leftCount[i] + rightArea[i] * rightCount[i];
+            if (bestSplit < 0 || cost < bestCost) {
+                bestCost = cost;
+                bestSplit = i;
+            }
+        }
+        if (bestSplit >= 0) {
+            auto it = std::partition(leaves.begin() + begin, leaves.begin() + end,
+                                     [&](int32_t leaf) { return binOf(leaf) <= bestSplit; });
+            mid = static_cast<size_t>(it - leaves.begin());
+        }
+    }
+    if (mid == begin || mid == end) {
+        // Centroides coincidentes o SAH sin corte válido: partir por la mediana.
+        mid = begin + count / 2;
+        std::nth_element(leaves.begin() + begin, leaves.begin() + mid, leaves.begin() + end,
+                         [&](int32_t a, int32_t b) {
+                             return nodes[a].box.Center()[axis] < nodes[b].box.Center()[axis];
+                         });
+    }
+
+    int32_t child1 = BuildRange(leaves, begin, mid);
+    int32_t child2 = BuildRange(leaves, mid, end);
+    int32_t parent = AllocateNode();
+    Node& node = nodes[parent];
+    node.child1 = child1;
+    node.child2 = child2;
+    node.box = Union(nodes[child1].box, nodes[child2].box);
+    node.height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+    nodes[child1].parent = parent;
+    nodes[child2].parent = parent;
+    return parent;
+}
+
+void AABBTree::Clear() {
+    nodes.clear();
+    root = NullNode;
+    freeList = NullNode;
+    proxyCount = 0;
+}
+
+void AABBTree::CollectLeaves(int32_t index, std::vector<uint32_t>& out) const {
+    std::vector<int32_t> stack;
+    stack.push_back(index);
+    while (!stack.empty()) {
+        int32_t current = stack.back();
+        stack.pop_back();
+        const Node& node = nodes[current];
+        if (node.IsLeaf()) {
+            out.push_back(node.userData);
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+void AABBTree::QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& out, CullingStats* stats) const {
+    const size_t before = out.size();
+    if (root != NullNode) {
+        // Cada entrada lleva la máscara de planos que aún hay que comprobar: si un nodo está
+        // completamente dentro de un plano, sus descendientes ya no lo testean.
+        struct Entry {
+            int32_t index;
+            uint32_t planeMask;
+        };
+        std::vector<Entry> stack;
+        stack.reserve(64);
+        stack.push_back({ root, (1u << Frustum::Count) - 1u });
+        while (!stack.empty()) {
+            Entry entry = stack.back();
+            stack.pop_back();
+            const Node& node = nodes[entry.index];
+            glm::vec3 center = node.box.Center();
+            glm::vec3 extents = node.box.Extents();
+
+            uint32_t mask = entry.planeMask;
+            bool outside = false;
+            for (int p = 0; p < Frustum::Count && mask != 0; ++p) {
+                uint32_t bit = 1u << p;
+                if ((mask & bit) == 0)
+                    continue;
+                const glm::vec4& plane = frustum.planes[p];
+                float distance = glm::dot(glm::vec3(plane), center) + plane.w;
+                float radius = glm::dot(glm::abs(glm::vec3(plane)), extents);
+                if (distance + radius < 0.0f) {
+                    outside = true;
+                    break;
+                }
+                if (distance - radius >= 0.0f)
+                    mask &= ~bit;
+            }
+            if (outside)
+                continue;
+
+            if (node.IsLeaf()) {
+                out.push_back(node.userData);
+            } else if (mask == 0) {
+                CollectLeaves(entry.index, out);
+            } else {
+                stack.push_back({ node.child1, mask });
+                stack.push_back({ node.child2, mask });
+            }
+        }
+    }
+    if (stats) {
+        stats->tested = static_cast<uint32_t>(proxyCount);
+        stats->visible = static_cast<uint32_t>(out.size() - before);
+        stats->culled = stats->tested - stats->visible;
+    }
+}
+
+void AABBTree::QueryAABB(const AABB& box, std::vector<uint32_t>& out) const {
+    if (root == NullNode)
+        return;
+    std::vector<int32_t> stack;
+    stack.reserve(64);
+    stack.push_back(root);
+    while (!stack.empty()) {
+        int32_t index = stack.back();
+        stack.pop_back();
+        const Node& node = nodes[index];
+        if (!node.box.Overlaps(box))
+            continue;
+        if (node.IsLeaf()) {
+            out.push_back(node.userData);
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+void AABBTree::QueryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                        std::vector<RayHit>& out) const {
+    RayCast(origin, direction, maxDistance, [&](uint32_t userData, float distance) {
+        out.push_back({ userData, distance });
+        return maxDistance;
+    });
+}
+
+glm::vec3 AABBTree::SafeInverse(const glm::vec3& direction) {
+    const float big = 1e30f;
+    return glm::vec3(direction.x != 0.0f ? 1.0f / direction.x : big,
+                     direction.y != 0.0f ? 1.0f / direction.y : big,
+                     direction.z != 0.0f ? 1.0f / direction.z : big);
+}
+
+bool AABBTree::RayIntersects(const AABB& box, const glm::vec3& origin, const glm::vec3& invDir,
+                             float maxDistance, float& tEntry) {
+    // Test de slabs.
+    glm::vec3 t1 = (box.min - origin) * invDir;
+    glm::vec3 t2 = (box.max - origin) * invDir;
+    glm::vec3 tMinV = glm::min(t1, t2);
+    glm::vec3 tMaxV = glm::max(t1, t2);
+    float tMin = std::max(std::max(tMinV.x, tMinV.y), std::max(tMinV.z, 0.0f));
+    float tMax = std::min(std::min(tMaxV.x, tMaxV.y), std::min(tMaxV.z, maxDistance));
+    tEntry = tMin;
+    return tMin <= tMax;
+}
+
+bool AABBTree::Validate() const {
+    if (root == NullNode)
+        return proxyCount == 0;
+    if (nodes[root].parent != NullNode)
+        return false;
+    return ValidateNode(root);
+}
+
+bool AABBTree::ValidateNode(int32_t index) const {
+    const Node& node = nodes[index];
+    if (node.IsLeaf())
+        return node.height == 0;
+    const Node& c1 = nodes[node.child1];
+    const Node& c2 = nodes[node.child2];
+    if (c1.parent != index || c2.parent != index)
+        return false;
+    if (node.height != 1 + std::max(c1.height, c2.height))
+        return false;
+    if (!node.box.Contains(c1.box) || !node.box.Contains(c2.box))
+        return false;
+    return ValidateNode(node.child1) && ValidateNode(node.child2);
+}
\ No newline at end of file
@@ -26,6 +26,41 @@ Config Config::LoadFromFile(const std::string& configFilePath) {
             if (ac.size() >= 3)
                 config.ambientColor = glm::vec3(ac[0], ac[1], ac[2]);
         }
+        if (root["render"] && root["render"]["path"])
+            config.renderPath = root["render"]["path"].as<std::string>();
+        if (root["render"] && root["render"]["depthPrepass"])
+            config.depthPrepass = root["render"]["depthPrepass"].as<bool>();
+        if (root["render"] && root["render"]["shaderVariants"])
+            config.shaderVariants = root["render"]["shaderVariants"].as<bool>();
+        if (root["render"] && root["render"]["maxLightsPerCluster"])
+            config.maxLightsPerCluster = root["render"]["maxLightsPerCluster"].as<int>();
+        if (root["render"] && root["render"]["shaderCacheDir"])
+            config.shaderCacheDir = root["render"]["shaderCacheDir"].as<std::string>();
+        if (root["render"] && root["render"]["renderThread"])
+            config.renderThread = root["render"]["renderThread"].as<bool>();
+        if (root["render"] && root["render"]["culling"])
+            config.culling = root["render"]["culling"].as<std::string>();
+        if (root["render"] && root["render"]["occlusionCulling"])
+            config.occlusionCulling = root["render"]["occlusionCulling"].as<bool>();
+        if (root["render"] && root["render"]["occluderTriangleBudget"])
+            config.occluderTriangleBudget = root["render"]["occluderTriangleBudget"].as<int>();
+        if (root["render"] && root["render"]["lodBias"])
+            config.lodBias = root["render"]["lodBias"].as<float>();
+        if (root["render"] && root["render"]["shadows"]) {
+            const auto& shadows = root["render"]["shadows"];
+            if (shadows["cascades"])
+                config.shadowCascades = shadows["cascades"].as<int>();
+            if (shadows["resolution"])
+                config.shadowResolution = shadows["resolution"].as<int>();
+            if (shadows["distance"])
+                config.shadowDistance = shadows["distance"].as<float>();
+            if (shadows["pointSlots"])
+                config.pointShadowSlots = shadows["pointSlots"].as<int>();
+            if (shadows["pointResolution"])
+                config.pointShadowResolution = shadows["pointResolution"].as<int>();
+            if (shadows["pointFaceBudget"])
+                config.pointShadowFaceBudget = shadows["pointFaceBudget"].as<int>();
+        }
         if (root["lights"]) {
             for (const auto& lightNode : root["lights"]) {
                 LightConfig lc;
@@ -41,6 +76,15 @@ Config Config::LoadFromFile(const std::string& configFilePath) {
                     if (col.size() >= 3)
                         lc.color = glm::vec3(col[0], col[1], col[2]);
                 }
+                if (lightNode["direction"]) {
+                    auto dir = lightNode["direction"].as<std::vector<float>>();
+                    if (dir.size() >= 3)
+                        lc.direction = glm::vec3(dir[0], dir[1], dir[2]);
+                }
+                if (lightNode["castShadows"])
+                    lc.castShadows = lightNode["castShadows"].as<bool>();
+                if (lightNode["range"])
+                    lc.range = lightNode["range"].as<float>();
                 config.lights.push_back(lc);
             }
         }
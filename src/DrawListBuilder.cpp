@@ -0,0 +1,135 @@
+// DrawListBuilder.cpp
+#include "renderer/DrawListBuilder.h"
+#include "utils/ThreadPool.h"
+#include <algorithm>
+
+namespace
+{
+    // Una tarea por índice: count es pequeño (buckets o parejas de buckets).
+    void ForEach(ThreadPool* pool, size_t count, const std::function<void(size_t)>& fn)
+    {
+        if (!pool || count <= 1) {
+            for (size_t i = 0; i < count; ++i)
+                fn(i);
+            return;
+        }
+        pool->ParallelFor(count, 1, [&fn](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                fn(i);
+        });
+    }
+
+    uint64_t Field(uint32_t value, uint32_t bits, uint32_t shift)
+    {
+        return (static_cast<uint64_t>(value) & ((uint64_t{1} << bits) - 1)) << shift;
+    }
+}
+
+uint64_t DrawListBuilder::MakeKey(bool transparent, uint32_t variant, uint32_t material, uint32_t submesh,
+                                  uint32_t lod) {
+    constexpr uint32_t variantShift = 63 - VariantBits;
+    constexpr uint32_t materialShift = variantShift - MaterialBits;
+    constexpr uint32_t submeshShift = materialShift - SubmeshBits;
+    constexpr uint32_t lodShift = submeshShift - LODBits;
+    return (transparent ? uint64_t{1} << 63 : 0) | Field(variant, VariantBits, variantShift) |
+           Field(material, MaterialBits, materialShift) | Field(submesh, SubmeshBits, submeshShift) |
+           Field(lod, LODBits, lodShift);
+}
+
+size_t DrawListBuilder::GetFirstTransparent() const {
+    return std::partition_point(sorted.begin(), sorted.end(),
+                                [](const DrawSortEntry& entry) { return !IsTransparent(entry.key); }) -
+           sorted.begin();
+}
+
+void DrawListBuilder::Build(const Frustum& frustum, const AABBSoA& bounds, const Filter& filter, ThreadPool* pool) {
+    visibility.resize(bounds.Size());
+    Run(bounds.Size(), pool, [&](Bucket& bucket, size_t begin, size_t end) {
+        bucket.stats = FrustumCuller::CullAABBs(frustum, bounds, visibility.data(), begin, end);
+        for (size_t i = begin; i < end; ++i) {
+            if (!visibility[i])
+                continue;
+            DrawSortEntry entry;
+            entry.candidate = static_cast<uint32_t>(i);
+            if (filter(entry.candidate, entry))
+                bucket.entries.push_back(entry);
+            else
+                bucket.rejected++;
+        }
+    });
+}
+
+void DrawListBuilder::Build(const std::vector<uint32_t>& candidates, const Filter& filter, ThreadPool* pool) {
+    Run(candidates.size(), pool, [&](Bucket& bucket, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            DrawSortEntry entry;
+            entry.candidate = candidates[i];
+            if (filter(entry.candidate, entry))
+                bucket.entries.push_back(entry);
+            else
+                bucket.rejected++;
+        }
+    });
+}
+
+void DrawListBuilder::Run(size_t count, ThreadPool* pool, const std::function<void(Bucket&, size_t, size_t)>& visit) {
+    const size_t threads = pool ? pool->GetThreadCount() + 1 : 1;
+    bucketCount = std::max<size_t>(1, std::min(threads, (count + MinBatch - 1) / MinBatch));
+    if (buckets.size() < bucketCount)
+        buckets.resize(bucketCount);
+    const size_t batchSize = ((count + bucketCount - 1) / bucketCount + 3) & ~static_cast<size_t>(3);
+
+    ForEach(pool, bucketCount, [&](size_t b) {
+        Bucket& bucket = buckets[b];
+        bucket.entries.clear();
+        bucket.stats = {};
+        bucket.rejected = 0;
+        const size_t begin = std::min(count, b * batchSize);
+        visit(bucket, begin, std::min(count, begin + batchSize));
+        std::sort(bucket.entries.begin(), bucket.entries.end());
+    });
+
+    cullingStats = {};
+    rejected = 0;
+    for (size_t b = 0; b < bucketCount; ++b) {
+        cullingStats.tested += buckets[b].stats.tested;
+        cullingStats.visible += buckets[b].stats.visible;
+        cullingStats.culled += buckets[b].stats.culled;
+        rejected += buckets[b].rejected;
+    }
+    Merge(pool);
+}
+
+void DrawListBuilder::Merge(ThreadPool* pool) {
+    // Buckets uno tras otro en sorted; cada ronda mezcla los tramos de dos en dos hasta dejar uno.
+    runs.assign(1, 0);
+    for (size_t b = 0; b < bucketCount; ++b)
+        runs.push_back(runs.back() + buckets[b].entries.size());
+    sorted.resize(runs.back());
+    scratch.resize(runs.back());
+    ForEach(pool, bucketCount, [this](size_t b) {
+        std::copy(buckets[b].entries.begin(), buckets[b].entries.end(), sorted.begin() + runs[b]);
+    });
+
+    std::vector<DrawSortEntry>* source = &sorted;
+    std::vector<DrawSortEntry>* target = &scratch;
+    while (runs.size() > 2) {
+        const size_t runCount = runs.size() - 1;
+        ForEach(pool, (runCount + 1) / 2, [&](size_t pair) {
+            const size_t begin = runs[2 * pair];
+            const size_t middle = runs[std::min(2 * pair + 1, runCount)];
+            const size_t end = runs[std::min(2 * pair + 2, runCount)];
+            std::merge(source->begin() + begin, source->begin() + middle, source->begin() + middle,
+                       source->begin() + end, target->begin() + begin);
+        });
+        size_t kept = 0;
+        for (size_t i = 0; i < runs.size(); i += 2)
+            runs[kept++] = runs[i];
+        if (runCount % 2 == 1)
+            runs[kept++] = runs[runCount];
+        runs.resize(kept);
+        std::swap(source, target);
+    }
+    if (source != &sorted)
+        sorted.swap(scratch);
+}
\ No newline at end of file
@@ -88,7 +88,19 @@ void EntityLoader::LoadEntitiesFromYAML(Coordinator *coordinator, const std::str
             if (entityNode["render"]["model"])
             {
                 std::string modelPath = entityNode["render"]["model"].as<std::string>();
-                render.model = ResourceManager::LoadModel(modelPath.c_str(), modelPath);
+                ModelImportOptions options;
+                // Formato de vértice opcional: "full" (por defecto) o "compact" (cuantizado).
+                if (entityNode["render"]["vertexFormat"] &&
+                    entityNode["render"]["vertexFormat"].as<std::string>() == "compact")
+                {
+                    options.vertexFormat = VertexFormat::Compact;
+                }
+                // Conservar la geometría en CPU (por defecto se libera tras subirla a GPU).
+                if (entityNode["render"]["keepCPUGeometry"])
+                {
+                    options.keepCPUGeometry = entityNode["render"]["keepCPUGeometry"].as<bool>();
+                }
+                render.model = ResourceManager::LoadModel(modelPath.c_str(), modelPath, options);
             }
             coordinator->AddComponent<RenderComponent>(entity, render);
         }
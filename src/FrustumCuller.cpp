@@ -0,0 +1,96 @@
+// FrustumCuller.cpp
+#include "renderer/FrustumCuller.h"
+#include "utils/Simd.h"
+#include <algorithm>
+#include <cmath>
+
+CullingStats FrustumCuller::CullAABBsScalar(const Frustum& frustum, const AABBSoA& boxes, uint8_t* visibility,
+                                            size_t begin, size_t end) {
+    CullingStats stats;
+    const size_t count = std::min(end, boxes.Size());
+    for (size_t i = begin; i < count; ++i) {
+        bool inside = true;
+        for (const auto& plane : frustum.planes) {
+            float distance = plane.x * boxes.centerX[i] + plane.y * boxes.centerY[i] +
+                             plane.z * boxes.centerZ[i] + plane.w;
+            float radius = std::abs(plane.x) * boxes.extentX[i] + std::abs(plane.y) * boxes.extentY[i] +
+                           std::abs(plane.z) * boxes.extentZ[i];
+            if (distance + radius < 0.0f) {
+                inside = false;
+                break;
+            }
+        }
+        visibility[i] = inside ? 1 : 0;
+        stats.tested++;
+        if (inside)
+            stats.visible++;
+        else
+            stats.culled++;
+    }
+    return stats;
+}
+
+CullingStats FrustumCuller::CullAABBs(const Frustum& frustum, const AABBSoA& boxes, uint8_t* visibility,
+                                      size_t begin, size_t end) {
+#ifdef TOXIC_SIMD_SSE2
+    CullingStats stats;
+    const size_t count = std::min(end, boxes.Size());
+    if (begin >= count)
+        return stats;
+    const size_t simdCount = begin + ((count - begin) & ~static_cast<size_t>(3));
+
+    // Planos y valores absolutos de sus normales replicados en los 4 carriles.
+    __m128 px[Frustum::Count], py[Frustum::Count], pz[Frustum::Count], pw[Frustum::Count];
+    __m128 ax[Frustum::Count], ay[Frustum::Count], az[Frustum::Count];
+    for (int p = 0; p < Frustum::Count; ++p) {
+        const glm::vec4& plane = frustum.planes[p];
+        px[p] = _mm_set1_ps(plane.x);
+        py[p] = _mm_set1_ps(plane.y);
+        pz[p] = _mm_set1_ps(plane.z);
+        pw[p] = _mm_set1_ps(plane.w);
+        ax[p] = _mm_set1_ps(std::abs(plane.x));
+        ay[p] = _mm_set1_ps(std::abs(plane.y));
+        az[p] = _mm_set1_ps(std::abs(plane.z));
+    }
+    const __m128 zero = _mm_setzero_ps();
+
+    for (size_t i = begin; i < simdCount; i += 4) {
+        __m128 cx = _mm_loadu_ps(&boxes.centerX[i]);
+        __m128 cy = _mm_loadu_ps(&boxes.centerY[i]);
+        __m128 cz = _mm_loadu_ps(&boxes.centerZ[i]);
+        __m128 ex = _mm_loadu_ps(&boxes.extentX[i]);
+        __m128 ey = _mm_loadu_ps(&boxes.extentY[i]);
+        __m128 ez = _mm_loadu_ps(&boxes.extentZ[i]);
+
+        // Una caja queda fuera si para algún plano: dot(n, c) + d + dot(|n|, e) < 0.
+        __m128 outside = _mm_setzero_ps();
+        for (int p = 0; p < Frustum::Count; ++p) {
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px[p], cx), _mm_mul_ps(py[p], cy)),
+                                         _mm_add_ps(_mm_mul_ps(pz[p], cz), pw[p]));
+            __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax[p], ex), _mm_mul_ps(ay[p], ey)),
+                                       _mm_mul_ps(az[p], ez));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+        }
+
+        int outsideMask = _mm_movemask_ps(outside);
+        for (int lane = 0; lane < 4; ++lane) {
+            bool inside = (outsideMask & (1 << lane)) == 0;
+            visibility[i + lane] = inside ? 1 : 0;
+            if (inside)
+                stats.visible++;
+            else
+                stats.culled++;
+        }
+        stats.tested += 4;
+    }
+
+    // Cajas restantes (count no múltiplo de 4).
+    CullingStats tail = CullAABBsScalar(frustum, boxes, visibility, simdCount, count);
+    stats.tested += tail.tested;
+    stats.visible += tail.visible;
+    stats.culled += tail.culled;
+    return stats;
+#else
+    return CullAABBsScalar(frustum, boxes, visibility, begin, end);
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+// LightClusterGrid.cpp
+#include "renderer/LightClusterGrid.h"
+#include "utils/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    bool SphereIntersectsAABB(const glm::vec3& center, float radius, const AABB& box)
+    {
+        glm::vec3 closest = glm::clamp(center, box.min, box.max);
+        glm::vec3 d = closest - center;
+        return glm::dot(d, d) <= radius * radius;
+    }
+
+    uint32_t ToTile(float ndc, uint32_t tiles)
+    {
+        float t = std::floor((ndc * 0.5f + 0.5f) * tiles);
+        return static_cast<uint32_t>(std::clamp(t, 0.0f, static_cast<float>(tiles - 1)));
+    }
+}
+
+float LightClusterGrid::SliceDepth(uint32_t slice) const {
+    return nearPlane * std::pow(farPlane / nearPlane, static_cast<float>(slice) / Slices);
+}
+
+void LightClusterGrid::SetProjection(float fov, float aspectRatio, float nearZ, float farZ) {
+    if (fov == fovY && aspectRatio == aspect && nearZ == nearPlane && farZ == farPlane && !clusterBounds.empty())
+        return;
+    fovY = fov;
+    aspect = aspectRatio;
+    nearPlane = nearZ;
+    farPlane = farZ;
+    tanHalfY = std::tan(glm::radians(fovY) * 0.5f);
+    tanHalfX = tanHalfY * aspect;
+
+    // AABB en vista de cada cluster: las 8 esquinas del trozo de frustum entre dos profundidades.
+    clusterBounds.assign(ClusterCount, AABB());
+    for (uint32_t z = 0; z < Slices; ++z) {
+        float depths[2] = { SliceDepth(z), SliceDepth(z + 1) };
+        for (uint32_t y = 0; y < TilesY; ++y) {
+            float ndcY[2] = { -1.0f + 2.0f * y / TilesY, -1.0f + 2.0f * (y + 1) / TilesY };
+            for (uint32_t x = 0; x < TilesX; ++x) {
+                float ndcX[2] = { -1.0f + 2.0f * x / TilesX, -1.0f + 2.0f * (x + 1) / TilesX };
+                AABB& box = clusterBounds[ClusterIndex(x, y, z)];
+                for (float d : depths)
+                    for (float nx : ndcX)
+                        for (float ny : ndcY)
+                            box.Expand(glm::vec3(nx * d * tanHalfX, ny * d * tanHalfY, -d));
+            }
+        }
+    }
+}
+
+ClusterGridParams LightClusterGrid::GetParams() const {
+    ClusterGridParams params;
+    params.gridSize = glm::uvec4(TilesX, TilesY, Slices, stats.globalLights);
+    float logRatio = std::log(farPlane / nearPlane);
+    params.depthParams = glm::vec4(Slices / logRatio, -static_cast<float>(Slices) * std::log(nearPlane) / logRatio, 0.0f, 0.0f);
+    return params;
+}
+
+uint32_t LightClusterGrid::FindCluster(const glm::vec3& viewPos) const {
+    float depth = std::max(-viewPos.z, 1e-4f);
+    ClusterGridParams params = GetParams();
+    int slice = static_cast<int>(std::floor(std::log(depth) * params.depthParams.x + params.depthParams.y));
+    slice = std::clamp(slice, 0, static_cast<int>(Slices) - 1);
+    uint32_t x = ToTile(viewPos.x / (depth * tanHalfX), TilesX);
+    uint32_t y = ToTile(viewPos.y / (depth * tanHalfY), TilesY);
+    return ClusterIndex(x, y, static_cast<uint32_t>(slice));
+}
+
+void LightClusterGrid::Build(const std::vector<Light>& lights, const glm::mat4& view, ThreadPool* pool) {
+    stats = ClusterStats();
+    culled.clear();
+    lightIndices.clear();
+    if (sliceLights.size() != Slices)
+        sliceLights.resize(Slices);
+    for (auto& list : sliceLights)
+        list.clear();
+    if (clusterLights.size() != ClusterCount)
+        clusterLights.resize(ClusterCount);
+    clusters.assign(ClusterCount, ClusterRange());
+
+    // 1. Luces a espacio de vista; las que tienen rango se recortan al frustum y a su rango de tiles y slices.
+    const float logRatio = std::log(farPlane / nearPlane);
+    for (uint32_t i = 0; i < lights.size(); ++i) {
+        const Light& light = lights[i];
+        if (static_cast<int>(light.typeAndPadding.x) < 0)
+            continue;
+        float radius = light.position.w;
+        if (radius <= 0.0f) {
+            lightIndices.push_back(i);
+            stats.globalLights++;
+            continue;
+        }
+        glm::vec3 center = glm::vec3(view * glm::vec4(glm::vec3(light.position), 1.0f));
+        float depth = -center.z;
+        if (depth + radius < nearPlane || depth - radius > farPlane)
+            continue;
+
+        CulledLight entry;
+        entry.center = center;
+        entry.radius = radius;
+        entry.index = i;
+        // Tiles: proyección de la AABB de la esfera (los extremos de x/z están en sus esquinas).
+        float zMin = depth - radius;
+        float zMax = depth + radius;
+        if (zMin <= nearPlane) {
+            entry.minX = 0; entry.maxX = TilesX - 1;
+            entry.minY = 0; entry.maxY = TilesY - 1;
+        } else {
+            float x0 = std::min((center.x - radius) / (zMin * tanHalfX), (center.x - radius) / (zMax * tanHalfX));
+            float x1 = std::max((center.x + radius) / (zMin * tanHalfX), (center.x + radius) / (zMax * tanHalfX));
+            float y0 = std::min((center.y - radius) / (zMin * tanHalfY), (center.y - radius) / (zMax * tanHalfY));
+            float y1 = std::max((center.y + radius) / (zMin * tanHalfY), (center.y + radius) / (zMax * tanHalfY));
+            if (x0 > 1.0f || x1 < -1.0f || y0 > 1.0f || y1 < -1.0f)
+                continue;
+            entry.minX = ToTile(x0, TilesX); entry.maxX = ToTile(x1, TilesX);
+            entry.minY = ToTile(y0, TilesY); entry.maxY = ToTile(y1, TilesY);
+        }
+        int firstSlice = static_cast<int>(std::floor(std::log(std::max(zMin, nearPlane) / nearPlane) * Slices / logRatio));
+        int lastSlice = static_cast<int>(std::floor(std::log(std::min(zMax, farPlane) / nearPlane) * Slices / logRatio));
+        firstSlice = std::clamp(firstSlice, 0, static_cast<int>(Slices) - 1);
+        lastSlice = std::clamp(lastSlice, 0, static_cast<int>(Slices) - 1);
+        uint32_t culledIndex = static_cast<uint32_t>(culled.size());
+        culled.push_back(entry);
+        for (int s = firstSlice; s <= lastSlice; ++s)
+            sliceLights[s].push_back(culledIndex);
+    }
+    stats.lights = static_cast<uint32_t>(culled.size());
+
+    // 2. Asignación exacta esfera-AABB: cada slice solo escribe sus clusters, así que se reparten sin bloqueos.
+    auto assignSlices = [this](size_t begin, size_t end) {
+        for (size_t z = begin; z < end; ++z) {
+            for (uint32_t y = 0; y < TilesY; ++y)
+                for (uint32_t x = 0; x < TilesX; ++x)
+                    clusterLights[ClusterIndex(x, y, static_cast<uint32_t>(z))].clear();
+            for (uint32_t culledIndex : sliceLights[z]) {
+                const CulledLight& light = culled[culledIndex];
+                for (uint32_t y = light.minY; y <= light.maxY; ++y)
+                    for (uint32_t x = light.minX; x <= light.maxX; ++x) {
+                        uint32_t cluster = ClusterIndex(x, y, static_cast<uint32_t>(z));
+                        if (SphereIntersectsAABB(light.center, light.radius, clusterBounds[cluster]))
+                            clusterLights[cluster].push_back(light.index);
+                    }
+            }
+        }
+    };
+    if (pool)
+        pool->ParallelFor(Slices, 2, assignSlices);
+    else
+        assignSlices(0, Slices);
+
+    // 3. Compactar: [luces globales][cluster 0][cluster 1]...
+    for (uint32_t cluster = 0; cluster < ClusterCount; ++cluster) {
+        const auto& list = clusterLights[cluster];
+        clusters[cluster].offset = static_cast<uint32_t>(lightIndices.size());
+        clusters[cluster].count = static_cast<uint32_t>(list.size());
+        lightIndices.insert(lightIndices.end(), list.begin(), list.end());
+        stats.references += static_cast<uint32_t>(list.size());
+        stats.maxPerCluster = std::max(stats.maxPerCluster, static_cast<uint32_t>(list.size()));
+    }
+}
\ No newline at end of file
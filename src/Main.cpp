@@ -16,12 +16,17 @@
 #include <iostream>
 #include <sstream>
 #include <cassert>
+#include <atomic>
 #include <filesystem>
 #include "engine/Config.h"
 #include "utils/Logger.h"
 #include "utils/GLDebug.h"
 #include "renderer/ResourceManager.h"
+#include "renderer/ProgramBinaryCache.h"
+#include "renderer/ParallelShaderCompile.h"
+#include "utils/FrameRingBuffer.h"
 #include "engine/SceneManager.h"
+#include "engine/RenderThread.h"
 #include "../scenes/Scene1.h"
 #include "../scenes/Scene2.h"
 
@@ -31,6 +36,8 @@
 
 // Global variables for timing
 float deltaTime = 0.0f, lastFrame = 0.0f;
+// Framebuffer size (width << 32 | height) reported by GLFW on the main thread, applied on the GL thread.
+std::atomic<uint64_t> framebufferSize{0};
 
 // Callback for GLFW errors.
 void glfwErrorCallback(int error, const char *description)
@@ -38,16 +45,32 @@ void glfwErrorCallback(int error, const char *description)
     Logger::Error("[GLFW] Error (" + std::to_string(error) + "): " + std::string(description));
 }
 
-// Callback for resizing the framebuffer.
+// Callback for resizing the framebuffer (main thread: the viewport is set by the GL thread).
 void framebuffer_size_callback(GLFWwindow *window, int width, int height)
 {
-    GLCall(glViewport(0, 0, width, height));
+    framebufferSize = (static_cast<uint64_t>(width) << 32) | static_cast<uint32_t>(height);
     Logger::ThrottledLog("Main_FramebufferResize", LogLevel::DEBUG,
                          "Framebuffer resized: width = " + std::to_string(width) +
                              ", height = " + std::to_string(height),
                          0.5);
 }
 
+// Destroy the current scene on the GL thread while the context is still alive (its destructors release
+// GL objects), then take the context back from the GL thread.
+void ShutdownRendering()
+{
+    RenderThread &renderThread = RenderThread::GetInstance();
+    try
+    {
+        renderThread.Execute([] { SceneManager::GetInstance().SwitchScene(nullptr); });
+    }
+    catch (const std::exception &e)
+    {
+        Logger::Error(std::string("[Main] Exception caught destroying the current scene: ") + e.what());
+    }
+    renderThread.Stop();
+}
+
 // Set working directory to the executable path (Windows version).
 void SetWorkingDirectoryToExecutablePath()
 {
@@ -90,7 +113,7 @@ int main()
             return -1;
         }
         glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 4); // 4.4: glBufferStorage (FrameRingBuffer)
         glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
         glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
 
@@ -115,6 +138,11 @@ int main()
         // Setup OpenGL debug callback.
         SetupOpenGLDebugCallback();
 
+        // Caché de binarios de programas (necesita el contexto para el driver y los formatos).
+        ProgramBinaryCache::GetInstance().Configure(config.shaderCacheDir);
+        // Compilación de shaders en hilos del driver (las variantes se recogen sin bloquear el bucle).
+        ParallelShaderCompile::Configure((GLADloadproc)glfwGetProcAddress);
+
         // Enable OpenGL features.
         GLCall(glEnable(GL_DEPTH_TEST));
         GLCall(glEnable(GL_FRAMEBUFFER_SRGB));
@@ -124,34 +152,23 @@ int main()
         // Initialize the SceneManager with the initial scene (Scene1).
         SceneManager::GetInstance().SwitchScene(std::make_unique<Scene1>());
 
-        Logger::Info("Main: Entering main loop.");
-        // Main render loop.
-        while (!glfwWindowShouldClose(window))
+        // One frame on the GL thread: draws the scene packet published by the last Update and presents it.
+        auto renderFrame = [window, appliedFramebufferSize = uint64_t{0}]() mutable
         {
-            float currentFrame = static_cast<float>(glfwGetTime());
-            deltaTime = currentFrame - lastFrame;
-            lastFrame = currentFrame;
+            // Espera (si la GPU va atrasada) a la sección del FrameRingBuffer que este frame reescribe.
+            FrameRingBuffer::GetInstance().BeginFrame();
+
+            uint64_t size = framebufferSize.load();
+            if (size != appliedFramebufferSize)
+            {
+                GLCall(glViewport(0, 0, static_cast<GLsizei>(size >> 32), static_cast<GLsizei>(size & 0xffffffffu)));
+                appliedFramebufferSize = size;
+            }
 
-            glfwPollEvents();
-            if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-                glfwSetWindowShouldClose(window, true);
-            
             // Limpiar el framebuffer:
             GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
             GLCall(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
 
-            // Switch scenes: Press key '2' to switch to Scene2, key '1' to switch back to Scene1.
-            if (glfwGetKey(window, GLFW_KEY_2) == GLFW_PRESS)
-            {
-                SceneManager::GetInstance().SwitchScene(std::make_unique<Scene2>());
-            }
-            else if (glfwGetKey(window, GLFW_KEY_1) == GLFW_PRESS)
-            {
-                SceneManager::GetInstance().SwitchScene(std::make_unique<Scene1>());
-            }
-
-            // Update and render the current scene.
-            SceneManager::GetInstance().Update(deltaTime);
             SceneManager::GetInstance().Render();
 
             // Verify framebuffer status.
@@ -167,16 +184,52 @@ int main()
                                      "[Main] Framebuffer complete.", 5.0);
             }
 
+            FrameRingBuffer::GetInstance().EndFrame();
             glfwSwapBuffers(window);
+        };
+        // From here on the context belongs to the GL thread (unless render: renderThread is off).
+        RenderThread &renderThread = RenderThread::GetInstance();
+        renderThread.Start(window, renderFrame, config.renderThread);
+
+        Logger::Info("Main: Entering main loop.");
+        // Main loop: simulates frame N while the GL thread submits frame N-1.
+        while (!glfwWindowShouldClose(window))
+        {
+            float currentFrame = static_cast<float>(glfwGetTime());
+            deltaTime = currentFrame - lastFrame;
+            lastFrame = currentFrame;
+
+            glfwPollEvents();
+            if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+                glfwSetWindowShouldClose(window, true);
+
+            // Switch scenes: Press key '2' to switch to Scene2, key '1' to switch back to Scene1.
+            // Init/Destroy create and release GL objects: they run on the GL thread with no frame in flight.
+            if (glfwGetKey(window, GLFW_KEY_2) == GLFW_PRESS)
+            {
+                renderThread.Execute([] { SceneManager::GetInstance().SwitchScene(std::make_unique<Scene2>()); });
+            }
+            else if (glfwGetKey(window, GLFW_KEY_1) == GLFW_PRESS)
+            {
+                renderThread.Execute([] { SceneManager::GetInstance().SwitchScene(std::make_unique<Scene1>()); });
+            }
+
+            // Update the current scene (writes its render packets), then hand the frame to the GL thread.
+            SceneManager::GetInstance().Update(deltaTime);
+            renderThread.SubmitFrame();
         }
 
+        // Destroy the scene on the GL thread, finish the frame in flight and take the context back.
+        ShutdownRendering();
         Logger::Info("Main: Exiting main loop. Cleaning up resources.");
+        FrameRingBuffer::GetInstance().Release();
         glfwTerminate();
         return 0;
     }
     catch (const std::exception &e)
     {
         Logger::Error(std::string("[Main] Exception caught in main loop: ") + e.what());
+        ShutdownRendering();
         std::cerr << "Ocurrió un error inesperado. Por favor, revisa el log para más detalles." << std::endl;
         glfwTerminate();
         return -1;
@@ -184,6 +237,7 @@ int main()
     catch (...)
     {
         Logger::Error("[Main] Unknown exception caught in main loop.");
+        ShutdownRendering();
         std::cerr << "Ocurrió un error desconocido. Por favor, revisa el log." << std::endl;
         glfwTerminate();
         return -1;
@@ -0,0 +1,332 @@
+// MeshOptimizer.cpp
+#include "renderer/MeshOptimizer.h"
+#include <algorithm>
+#include <unordered_map>
+#include <cstring>
+#include <cmath>
+
+namespace
+{
+    // Hash FNV-1a de los bytes de un vértice.
+    struct VertexHasher {
+        const unsigned char* data;
+        size_t stride;
+
+        size_t operator()(uint32_t index) const {
+            const unsigned char* bytes = data + static_cast<size_t>(index) * stride;
+            uint32_t hash = 2166136261u;
+            for (size_t i = 0; i < stride; ++i) {
+                hash ^= bytes[i];
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+    };
+
+    struct VertexEqual {
+        const unsigned char* data;
+        size_t stride;
+
+        bool operator()(uint32_t a, uint32_t b) const {
+            return std::memcmp(data + static_cast<size_t>(a) * stride, data + static_cast<size_t>(b) * stride, stride) == 0;
+        }
+    };
+
+    // Parámetros de Forsyth, "Linear-Speed Vertex Cache Optimisation".
+    constexpr int kCacheSize = 32;
+    constexpr float kCacheDecayPower = 1.5f;
+    constexpr float kLastTriangleScore = 0.75f;
+    constexpr float kValenceBoostScale = 2.0f;
+    constexpr float kValenceBoostPower = 0.5f;
+
+    float VertexScore(int cachePosition, uint32_t remainingTriangles)
+    {
+        if (remainingTriangles == 0)
+            return -1.0f;
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            if (cachePosition < 3) {
+                // Los tres vértices del último triángulo reciben una puntuación fija para no favorecer tiras.
+                score = kLastTriangleScore;
+            } else {
+                const float scaler = 1.0f / (kCacheSize - 3);
+                score = std::pow(1.0f - (cachePosition - 3) * scaler, kCacheDecayPower);
+            }
+        }
+        score += kValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -kValenceBoostPower);
+        return score;
+    }
+
+    // ACMR de un rango de triángulos simulando una caché FIFO que se comparte entre llamadas.
+    struct FifoCache {
+        std::vector<uint32_t> timestamps;
+        uint32_t time;
+        size_t size;
+
+        FifoCache(size_t vertexCount, size_t cacheSize) : timestamps(vertexCount, 0), time(static_cast<uint32_t>(cacheSize) + 1), size(cacheSize) {}
+
+        // Devuelve los fallos del triángulo y lo inserta en la caché.
+        unsigned Access(const uint32_t* tri) {
+            unsigned misses = 0;
+            for (int k = 0; k < 3; ++k) {
+                if (time - timestamps[tri[k]] > size) {
+                    timestamps[tri[k]] = time++;
+                    misses++;
+                }
+            }
+            return misses;
+        }
+    };
+}
+
+size_t MeshOptimizer::GenerateVertexRemap(std::vector<uint32_t>& remap, const void* vertices, size_t vertexCount,
+                                          size_t vertexSize) {
+    remap.assign(vertexCount, UINT32_MAX);
+    const unsigned char* data = static_cast<const unsigned char*>(vertices);
+    std::unordered_map<uint32_t, uint32_t, VertexHasher, VertexEqual> unique(
+        vertexCount, VertexHasher{ data, vertexSize }, VertexEqual{ data, vertexSize });
+    uint32_t next = 0;
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        auto result = unique.emplace(i, next);
+        if (result.second)
+            next++;
+        remap[i] = result.first->second;
+    }
+    return next;
+}
+
+void MeshOptimizer::RemapIndices(std::vector<uint32_t>& indices, const std::vector<uint32_t>& remap) {
+    for (auto& index : indices)
+        index = remap[index];
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+
+    // Adyacencia vértice -> triángulos.
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i)
+        remaining[indices[i]]++;
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v)
+        offsets[v + 1] = offsets[v] + remaining[v];
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    {
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < triangleCount * 3; ++i)
+            adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v)
+        vertexScores[v] = VertexScore(-1, remaining[v]);
+    std::vector<float> triangleScores(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t)
+        triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    std::vector<uint32_t> result;
+    result.reserve(triangleCount * 3);
+    std::vector<uint32_t> cache, newCache;
+    cache.reserve(kCacheSize + 3);
+    newCache.reserve(kCacheSize + 3);
+
+    size_t scanCursor = 0;
+    int64_t best = -1;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        if (best < 0 || triangleScores[t] > triangleScores[best])
+            best = static_cast<int64_t>(t);
+    }
+
+    while (best >= 0) {
+        const uint32_t* tri = &indices[best * 3];
+        emitted[best] = 1;
+        result.insert(result.end(), tri, tri + 3);
+
+        // Los vértices del triángulo pasan al frente de la caché LRU.
+        newCache.assign(tri, tri + 3);
+        for (uint32_t v : cache) {
+            if (v != tri[0] && v != tri[1] && v != tri[2])
+                newCache.push_back(v);
+        }
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = tri[k];
+            // Quitar el triángulo de la lista de pendientes del vértice.
+            uint32_t* begin = &adjacency[offsets[v]];
+            uint32_t* end = begin + remaining[v];
+            uint32_t* it = std::find(begin, end, static_cast<uint32_t>(best));
+            if (it != end) {
+                std::swap(*it, *(end - 1));
+                remaining[v]--;
+            }
+        }
+
+        // Actualizar puntuaciones de los vértices en caché (y de los que salen) y buscar el mejor triángulo vecino.
+        best = -1;
+        float bestScore = -1.0f;
+        for (size_t i = 0; i < newCache.size(); ++i) {
+            uint32_t v = newCache[i];
+            int position = i < static_cast<size_t>(kCacheSize) ? static_cast<int>(i) : -1;
+            cachePosition[v] = position;
+            float newScore = VertexScore(position, remaining[v]);
+            float delta = newScore - vertexScores[v];
+            vertexScores[v] = newScore;
+            for (uint32_t k = offsets[v]; k < offsets[v] + remaining[v]; ++k) {
+                uint32_t t = adjacency[k];
+                triangleScores[t] += delta;
+                if (triangleScores[t] > bestScore) {
+                    bestScore = triangleScores[t];
+                    best = t;
+                }
+            }
+        }
+        if (newCache.size() > static_cast<size_t>(kCacheSize))
+            newCache.resize(kCacheSize);
+        cache.swap(newCache);
+
+        // Sin candidatos en caché: siguiente triángulo pendiente en orden.
+        if (best < 0) {
+            while (scanCursor < triangleCount && emitted[scanCursor])
+                scanCursor++;
+            if (scanCursor < triangleCount)
+                best = static_cast<int64_t>(scanCursor);
+        }
+    }
+    indices.swap(result);
+}
+
+void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions,
+                                     float threshold) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2)
+        return;
+    const size_t vertexCount = positions.size();
+    const VertexCacheStats original = AnalyzeVertexCache(indices, vertexCount);
+
+    // Clusters (Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"):
+    // cortes duros donde un triángulo falla sus tres vértices y cortes blandos dentro de cada uno en
+    // cuanto su ACMR acumulado, empezando con la caché vacía, ya no supera threshold * su ACMR.
+    std::vector<size_t> hardStarts;
+    {
+        FifoCache cache(vertexCount, 16);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            if (cache.Access(&indices[t * 3]) == 3 || t == 0)
+                hardStarts.push_back(t);
+        }
+    }
+    std::vector<size_t> clusterStarts;
+    {
+        FifoCache cache(vertexCount, 16);
+        for (size_t h = 0; h < hardStarts.size(); ++h) {
+            size_t begin = hardStarts[h];
+            size_t end = h + 1 < hardStarts.size() ? hardStarts[h + 1] : triangleCount;
+            cache.time += static_cast<uint32_t>(cache.size) + 1; // vaciar
+            size_t misses = 0;
+            for (size_t t = begin; t < end; ++t)
+                misses += cache.Access(&indices[t * 3]);
+            const float clusterThreshold = threshold * static_cast<float>(misses) / (end - begin);
+
+            clusterStarts.push_back(begin);
+            cache.time += static_cast<uint32_t>(cache.size) + 1;
+            size_t start = begin;
+            misses = 0;
+            for (size_t t = begin; t < end; ++t) {
+                misses += cache.Access(&indices[t * 3]);
+                if (t + 1 < end && static_cast<float>(misses) / (t - start + 1) <= clusterThreshold) {
+                    clusterStarts.push_back(t + 1);
+                    cache.time += static_cast<uint32_t>(cache.size) + 1;
+                    start = t + 1;
+                    misses = 0;
+                }
+            }
+        }
+    }
+    if (clusterStarts.size() < 2)
+        return;
+
+    // Orden de fuera hacia dentro: los clusters cuya normal media apunta hacia fuera del centro van primero.
+    glm::vec3 meshCenter(0.0f);
+    float meshArea = 0.0f;
+    struct Cluster {
+        size_t begin, end;
+        float sortKey;
+    };
+    std::vector<Cluster> clusters;
+    clusters.reserve(clusterStarts.size());
+    std::vector<glm::vec3> clusterCentroids, clusterNormals;
+    for (size_t c = 0; c < clusterStarts.size(); ++c) {
+        size_t begin = clusterStarts[c];
+        size_t end = c + 1 < clusterStarts.size() ? clusterStarts[c + 1] : triangleCount;
+        glm::vec3 centroid(0.0f), normal(0.0f);
+        float area = 0.0f;
+        for (size_t t = begin; t < end; ++t) {
+            const glm::vec3& a = positions[indices[t * 3]];
+            const glm::vec3& b = positions[indices[t * 3 + 1]];
+            const glm::vec3& d = positions[indices[t * 3 + 2]];
+            glm::vec3 n = glm::cross(b - a, d - a);
+            float triArea = glm::length(n);
+            centroid += (a + b + d) * (triArea / 3.0f);
+            normal += n;
+            area += triArea;
+        }
+        meshCenter += centroid;
+        meshArea += area;
+        clusterCentroids.push_back(area > 0.0f ? centroid / area : positions[indices[begin * 3]]);
+        clusterNormals.push_back(glm::length(normal) > 0.0f ? glm::normalize(normal) : glm::vec3(0.0f));
+        clusters.push_back({ begin, end, 0.0f });
+    }
+    if (meshArea > 0.0f)
+        meshCenter /= meshArea;
+    for (size_t c = 0; c < clusters.size(); ++c)
+        clusters[c].sortKey = glm::dot(clusterCentroids[c] - meshCenter, clusterNormals[c]);
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    for (const auto& cluster : clusters)
+        result.insert(result.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+
+    // Solo se acepta si el ACMR no empeora más del umbral.
+    VertexCacheStats reordered = AnalyzeVertexCache(result, vertexCount);
+    if (reordered.acmr <= original.acmr * threshold)
+        indices.swap(result);
+}
+
+size_t MeshOptimizer::OptimizeVertexFetchRemap(std::vector<uint32_t>& remap, const std::vector<uint32_t>& indices,
+                                               size_t vertexCount) {
+    remap.assign(vertexCount, UINT32_MAX);
+    uint32_t next = 0;
+    for (uint32_t index : indices) {
+        if (remap[index] == UINT32_MAX)
+            remap[index] = next++;
+    }
+    return next;
+}
+
+VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+                                                   size_t cacheSize) {
+    VertexCacheStats stats;
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0)
+        return stats;
+    FifoCache cache(vertexCount, cacheSize);
+    size_t misses = 0;
+    for (size_t t = 0; t < triangleCount; ++t)
+        misses += cache.Access(&indices[t * 3]);
+
+    std::vector<uint8_t> used(vertexCount, 0);
+    size_t uniqueUsed = 0;
+    for (uint32_t index : indices) {
+        if (!used[index]) {
+            used[index] = 1;
+            uniqueUsed++;
+        }
+    }
+    stats.acmr = static_cast<float>(misses) / triangleCount;
+    stats.atvr = static_cast<float>(misses) / uniqueUsed;
+    return stats;
+}
\ No newline at end of file
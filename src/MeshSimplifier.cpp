@@ -0,0 +1,250 @@
+// MeshSimplifier.cpp
+#include "renderer/MeshSimplifier.h"
+#include <algorithm>
+#include <unordered_map>
+#include <cstring>
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+    // Cuádrica simétrica 4x4 (10 coeficientes) en doble precisión.
+    struct Quadric {
+        double a00 = 0, a01 = 0, a02 = 0, a03 = 0;
+        double a11 = 0, a12 = 0, a13 = 0;
+        double a22 = 0, a23 = 0;
+        double a33 = 0;
+
+        static Quadric FromPlane(double a, double b, double c, double d, double weight) {
+            Quadric q;
+            q.a00 = weight * a * a; q.a01 = weight * a * b; q.a02 = weight * a * c; q.a03 = weight * a * d;
+            q.a11 = weight * b * b; q.a12 = weight * b * c; q.a13 = weight * b * d;
+            q.a22 = weight * c * c; q.a23 = weight * c * d;
+            q.a33 = weight * d * d;
+            return q;
+        }
+
+        Quadric& operator+=(const Quadric& o) {
+            a00 += o.a00; a01 += o.a01; a02 += o.a02; a03 += o.a03;
+            a11 += o.a11; a12 += o.a12; a13 += o.a13;
+            a22 += o.a22; a23 += o.a23;
+            a33 += o.a33;
+            return *this;
+        }
+
+        // v^T Q v con v = (p, 1).
+        double Evaluate(const glm::vec3& p) const {
+            double x = p.x, y = p.y, z = p.z;
+            return a00 * x * x + 2 * a01 * x * y + 2 * a02 * x * z + 2 * a03 * x +
+                   a11 * y * y + 2 * a12 * y * z + 2 * a13 * y +
+                   a22 * z * z + 2 * a23 * z +
+                   a33;
+        }
+    };
+
+    struct Collapse {
+        uint32_t from;
+        uint32_t to;
+        double cost;
+    };
+
+    struct PositionHash {
+        size_t operator()(const glm::vec3& p) const {
+            uint32_t bits[3];
+            std::memcpy(bits, &p, sizeof(bits));
+            return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+        }
+    };
+
+    uint64_t EdgeKey(uint32_t a, uint32_t b)
+    {
+        if (a > b)
+            std::swap(a, b);
+        return (static_cast<uint64_t>(a) << 32) | b;
+    }
+}
+
+std::vector<uint32_t> MeshSimplifier::Simplify(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices,
+                                               size_t targetIndexCount, float maxError, float* outError) {
+    std::vector<uint32_t> result = indices;
+    if (outError)
+        *outError = 0.0f;
+    const size_t vertexCount = positions.size();
+    if (vertexCount == 0 || result.size() <= targetIndexCount)
+        return result;
+
+    glm::vec3 minP(FLT_MAX), maxP(-FLT_MAX);
+    for (const auto& p : positions) {
+        minP = glm::min(minP, p);
+        maxP = glm::max(maxP, p);
+    }
+    // Las cuádricas se calculan sobre posiciones normalizadas (diagonal 1) para que el error no dependa de la escala.
+    const float extent = std::max(glm::length(maxP - minP), 1e-12f);
+    std::vector<glm::vec3> normalized(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i)
+        normalized[i] = (positions[i] - minP) / extent;
+    const double maxCost = static_cast<double>(maxError) * maxError;
+
+    // Soldar por posición: las costuras de UV/normales son vértices distintos en la misma posición.
+    std::vector<uint32_t> weld(vertexCount);
+    std::vector<uint32_t> weldCount(vertexCount, 0);
+    {
+        std::unordered_map<glm::vec3, uint32_t, PositionHash> firstAt;
+        firstAt.reserve(vertexCount);
+        for (uint32_t i = 0; i < vertexCount; ++i) {
+            auto it = firstAt.emplace(positions[i], i).first;
+            weld[i] = it->second;
+            weldCount[weld[i]]++;
+        }
+    }
+
+    // Bordes y aristas no-manifold (en la topología soldada): sus vértices quedan bloqueados.
+    std::vector<uint8_t> locked(vertexCount, 0);
+    {
+        std::unordered_map<uint64_t, uint32_t> edgeUse;
+        edgeUse.reserve(result.size());
+        for (size_t t = 0; t + 2 < result.size(); t += 3) {
+            for (int e = 0; e < 3; ++e) {
+                uint32_t a = weld[result[t + e]], b = weld[result[t + (e + 1) % 3]];
+                if (a != b)
+                    edgeUse[EdgeKey(a, b)]++;
+            }
+        }
+        std::vector<uint8_t> weldLocked(vertexCount, 0);
+        for (const auto& [key, count] : edgeUse) {
+            if (count != 2) {
+                weldLocked[key >> 32] = 1;
+                weldLocked[key & 0xFFFFFFFFu] = 1;
+            }
+        }
+        for (uint32_t i = 0; i < vertexCount; ++i)
+            locked[i] = weldLocked[weld[i]] || weldCount[weld[i]] > 1;
+    }
+
+    // Cuádricas por vértice soldado a partir de los planos de sus triángulos (ponderadas por área).
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t t = 0; t + 2 < result.size(); t += 3) {
+        const glm::dvec3 p0(normalized[result[t]]), p1(normalized[result[t + 1]]), p2(normalized[result[t + 2]]);
+        glm::dvec3 n = glm::cross(p1 - p0, p2 - p0);
+        double length = glm::length(n);
+        if (length <= 0.0)
+            continue;
+        n /= length;
+        Quadric q = Quadric::FromPlane(n.x, n.y, n.z, -glm::dot(n, p0), length * 0.5);
+        for (int k = 0; k < 3; ++k)
+            quadrics[weld[result[t + k]]] += q;
+    }
+
+    double worstCost = 0.0;
+    std::vector<Collapse> collapses;
+    std::vector<uint32_t> remap(vertexCount);
+    std::vector<uint8_t> touched(vertexCount);
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1);
+    std::vector<uint32_t> adjacency;
+
+    // Cada pasada colapsa un conjunto independiente de aristas ordenadas por coste.
+    while (result.size() > targetIndexCount) {
+        const size_t triangleCount = result.size() / 3;
+
+        collapses.clear();
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int e = 0; e < 3; ++e) {
+                uint32_t a = result[t * 3 + e], b = result[t * 3 + (e + 1) % 3];
+                if (weld[a] == weld[b])
+                    continue;
+                for (int dir = 0; dir < 2; ++dir) {
+                    uint32_t from = dir ? b : a, to = dir ? a : b;
+                    if (locked[from])
+                        continue;
+                    Quadric q = quadrics[weld[from]];
+                    q += quadrics[weld[to]];
+                    collapses.push_back({ from, to, std::max(q.Evaluate(normalized[to]), 0.0) });
+                }
+            }
+        }
+        if (collapses.empty())
+            break;
+        std::sort(collapses.begin(), collapses.end(),
+                  [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+        // Triángulos incidentes a cada vértice.
+        std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+        for (uint32_t index : result)
+            adjacencyOffsets[index + 1]++;
+        for (size_t i = 0; i < vertexCount; ++i)
+            adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+        adjacency.resize(result.size());
+        {
+            std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (size_t i = 0; i < result.size(); ++i)
+                adjacency[fill[result[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        for (uint32_t i = 0; i < vertexCount; ++i)
+            remap[i] = i;
+        std::fill(touched.begin(), touched.end(), 0);
+
+        const size_t targetTriangles = targetIndexCount / 3;
+        size_t remainingTriangles = triangleCount;
+        size_t applied = 0;
+        for (const Collapse& c : collapses) {
+            if (c.cost > maxCost || remainingTriangles <= targetTriangles)
+                break;
+            if (touched[c.from] || touched[c.to])
+                continue;
+
+            // Rechazar colapsos que inviertan o degeneren algún triángulo que sobrevive.
+            bool valid = true;
+            size_t removed = 0;
+            const glm::vec3& target = positions[c.to];
+            for (uint32_t k = adjacencyOffsets[c.from]; k < adjacencyOffsets[c.from + 1] && valid; ++k) {
+                const uint32_t* tri = &result[adjacency[k] * 3];
+                if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) {
+                    removed++;
+                    continue;
+                }
+                glm::vec3 p[3], q[3];
+                for (int v = 0; v < 3; ++v) {
+                    p[v] = positions[tri[v]];
+                    q[v] = tri[v] == c.from ? target : p[v];
+                }
+                glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                glm::vec3 after = glm::cross(q[1] - q[0], q[2] - q[0]);
+                float beforeLength = glm::length(before), afterLength = glm::length(after);
+                if (afterLength <= 1e-12f || glm::dot(before, after) < 0.25f * beforeLength * afterLength)
+                    valid = false;
+            }
+            if (!valid || removed == 0)
+                continue;
+
+            remap[c.from] = c.to;
+            quadrics[weld[c.to]] += quadrics[weld[c.from]];
+            worstCost = std::max(worstCost, c.cost);
+            remainingTriangles -= removed;
+            applied++;
+            // Bloquear el vecindario en esta pasada: los tests de inversión asumen que no cambia.
+            for (uint32_t k = adjacencyOffsets[c.from]; k < adjacencyOffsets[c.from + 1]; ++k) {
+                const uint32_t* tri = &result[adjacency[k] * 3];
+                touched[tri[0]] = touched[tri[1]] = touched[tri[2]] = 1;
+            }
+        }
+        if (applied == 0)
+            break;
+
+        // Aplicar los colapsos y eliminar triángulos degenerados.
+        size_t write = 0;
+        for (size_t t = 0; t < triangleCount; ++t) {
+            uint32_t a = remap[result[t * 3]], b = remap[result[t * 3 + 1]], c = remap[result[t * 3 + 2]];
+            if (a == b || b == c || a == c)
+                continue;
+            result[write++] = a;
+            result[write++] = b;
+            result[write++] = c;
+        }
+        result.resize(write);
+    }
+
+    if (outError)
+        *outError = static_cast<float>(std::sqrt(worstCost));
+    return result;
+}
\ No newline at end of file
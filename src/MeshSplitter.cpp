@@ -0,0 +1,41 @@
+// MeshSplitter.cpp
+#include "renderer/MeshSplitter.h"
+
+std::vector<MeshChunk> MeshSplitter::Split(size_t vertexCount, const std::vector<uint32_t>& indices, size_t maxVertices) {
+    std::vector<MeshChunk> chunks;
+    if (maxVertices < 3)
+        return chunks;
+
+    // local[v] = índice local de v en el trozo actual; stamp[v] indica a qué trozo pertenece ese valor.
+    std::vector<uint32_t> local(vertexCount, 0);
+    std::vector<uint32_t> stamp(vertexCount, UINT32_MAX);
+    uint32_t chunkId = 0;
+    chunks.emplace_back();
+
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        const uint32_t* tri = &indices[t];
+        size_t newVertices = 0;
+        for (int k = 0; k < 3; ++k) {
+            bool repeated = (k > 0 && tri[k] == tri[0]) || (k > 1 && tri[k] == tri[1]);
+            if (stamp[tri[k]] != chunkId && !repeated)
+                newVertices++;
+        }
+        if (chunks.back().vertexRemap.size() + newVertices > maxVertices) {
+            chunks.emplace_back();
+            chunkId++;
+        }
+        MeshChunk& chunk = chunks.back();
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = tri[k];
+            if (stamp[v] != chunkId) {
+                stamp[v] = chunkId;
+                local[v] = static_cast<uint32_t>(chunk.vertexRemap.size());
+                chunk.vertexRemap.push_back(v);
+            }
+            chunk.indices.push_back(local[v]);
+        }
+    }
+    if (chunks.back().indices.empty())
+        chunks.pop_back();
+    return chunks;
+}
\ No newline at end of file
@@ -2,24 +2,32 @@
 #include "renderer/Model.h"
 #include "renderer/Submesh.h"
 #include "renderer/Material.h"
+#include "renderer/MaterialTable.h"
+#include "renderer/MeshSimplifier.h"
+#include "renderer/MeshSplitter.h"
+#include "renderer/MeshOptimizer.h"
 #include "renderer/ResourceManager.h" // Para acceder a recursos de materiales
 #include "utils/FileUtils.h"
 #include "utils/Logger.h"
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
+#include <assimp/GltfMaterial.h>
 #include <sstream>
+#include <algorithm>
 #include <filesystem>
 #include <glm/gtc/type_ptr.hpp>
 
 /**
  * Carga el material de un mesh usando las propiedades glTF expuestas por Assimp.
  * Se intentan cargar las texturas para:
- *   - Albedo (usando BASE_COLOR o DIFFUSE). Si no existe, se extrae el factor "baseColorFactor".
+ *   - Albedo (usando BASE_COLOR o DIFFUSE).
  *   - Normal (NORMALS)
- *   - MetallicRoughness (UNKNOWN); de no existir, se leen "metallicFactor" y "roughnessFactor".
+ *   - MetallicRoughness (UNKNOWN)
  *   - Occlusion (AMBIENT)
  *   - Emisivo (EMISSIVE)
+ * Los factores (baseColor, metallic, roughness, emissive, clearcoat, transmission, ior) se leen
+ * siempre, ya que en glTF multiplican a la textura correspondiente cuando existe.
  * Se utilizan rutas resueltas de forma genérica.
  */
 Material LoadMaterial(aiMaterial* material, const std::string &modelDir) {
@@ -35,17 +43,19 @@ Material LoadMaterial(aiMaterial* material, const std::string &modelDir) {
         std::string fullTexPath = FileUtils::ResolvePath(modelDir, texPathStr);
         Logger::Debug("[LoadMaterial] Loading base color texture from: " + fullTexPath);
         mat.albedo = ResourceManager::LoadTexture(fullTexPath.c_str(), true, fullTexPath);
-    } else {
-        aiColor4D baseColor;
-        if (AI_SUCCESS == aiGetMaterialColor(material, "gltf.pbrMetallicRoughness.baseColorFactor", 0, 0, &baseColor)) {
-            mat.baseColorFactor = glm::vec4(baseColor.r, baseColor.g, baseColor.b, baseColor.a);
-            Logger::Debug("[LoadMaterial] Using baseColorFactor: " +
-                          std::to_string(mat.baseColorFactor.r) + ", " +
-                          std::to_string(mat.baseColorFactor.g) + ", " +
-                          std::to_string(mat.baseColorFactor.b) + ", " +
-                          std::to_string(mat.baseColorFactor.a));
-        }
     }
+    aiColor4D baseColor;
+    if (AI_SUCCESS == aiGetMaterialColor(material, AI_MATKEY_BASE_COLOR, &baseColor)) {
+        mat.baseColorFactor = glm::vec4(baseColor.r, baseColor.g, baseColor.b, baseColor.a);
+        Logger::Debug("[LoadMaterial] Using baseColorFactor: " +
+                      std::to_string(mat.baseColorFactor.r) + ", " +
+                      std::to_string(mat.baseColorFactor.g) + ", " +
+                      std::to_string(mat.baseColorFactor.b) + ", " +
+                      std::to_string(mat.baseColorFactor.a));
+    }
+    aiString alphaMode;
+    if (AI_SUCCESS == material->Get(AI_MATKEY_GLTF_ALPHAMODE, alphaMode))
+        mat.alphaBlend = std::string(alphaMode.C_Str()) == "BLEND";
     
     // Normal map
     if (material->GetTexture(aiTextureType_NORMALS, 0, &texPath) == AI_SUCCESS) {
@@ -65,16 +75,15 @@ Material LoadMaterial(aiMaterial* material, const std::string &modelDir) {
          std::string fullTexPath = FileUtils::ResolvePath(modelDir, texPathStr);
          Logger::Debug("[LoadMaterial] Loading metallicRoughness texture from: " + fullTexPath);
          mat.metallicRoughness = ResourceManager::LoadTexture(fullTexPath.c_str(), true, fullTexPath);
-    } else {
-         float metallic = 1.0f, roughness = 1.0f;
-         if (AI_SUCCESS == aiGetMaterialFloat(material, "gltf.pbrMetallicRoughness.metallicFactor", 0, 0, &metallic)) {
-             mat.metallicFactor = metallic;
-             Logger::Debug("[LoadMaterial] Metallic factor: " + std::to_string(metallic));
-         }
-         if (AI_SUCCESS == aiGetMaterialFloat(material, "gltf.pbrMetallicRoughness.roughnessFactor", 0, 0, &roughness)) {
-             mat.roughnessFactor = roughness;
-             Logger::Debug("[LoadMaterial] Roughness factor: " + std::to_string(roughness));
-         }
+    }
+    float metallic = 1.0f, roughness = 1.0f;
+    if (AI_SUCCESS == aiGetMaterialFloat(material, AI_MATKEY_METALLIC_FACTOR, &metallic)) {
+        mat.metallicFactor = metallic;
+        Logger::Debug("[LoadMaterial] Metallic factor: " + std::to_string(metallic));
+    }
+    if (AI_SUCCESS == aiGetMaterialFloat(material, AI_MATKEY_ROUGHNESS_FACTOR, &roughness)) {
+        mat.roughnessFactor = roughness;
+        Logger::Debug("[LoadMaterial] Roughness factor: " + std::to_string(roughness));
     }
     
     // Occlusion map (usualmente en AMBIENT)
@@ -96,91 +105,230 @@ Material LoadMaterial(aiMaterial* material, const std::string &modelDir) {
          Logger::Debug("[LoadMaterial] Loading emissive texture from: " + fullTexPath);
          mat.emissive = ResourceManager::LoadTexture(fullTexPath.c_str(), true, fullTexPath);
     }
+    aiColor3D emissiveColor;
+    if (AI_SUCCESS == material->Get(AI_MATKEY_COLOR_EMISSIVE, emissiveColor)) {
+        mat.emissiveFactor = glm::vec3(emissiveColor.r, emissiveColor.g, emissiveColor.b);
+    }
+    
+    // Extensiones KHR_materials_clearcoat / KHR_materials_transmission / KHR_materials_ior
+    material->Get(AI_MATKEY_CLEARCOAT_FACTOR, mat.clearcoatFactor);
+    material->Get(AI_MATKEY_CLEARCOAT_ROUGHNESS_FACTOR, mat.clearcoatRoughnessFactor);
+    material->Get(AI_MATKEY_TRANSMISSION_FACTOR, mat.transmissionFactor);
+    material->Get(AI_MATKEY_REFRACTI, mat.ior);
     
     return mat;
 }
 
-Model::Model(const std::string &path) {
+/**
+ * Genera la cadena de LODs del submesh (50%, 25% y 10% de los triángulos) con el simplificador
+ * cuádrico. Los índices de cada LOD se concatenan tras los del LOD 0 para compartir VBO y EBO.
+ * La cadena se corta si un nivel no reduce lo suficiente (malla ya simple o error máximo alcanzado).
+ */
+void GenerateLODChain(Submesh &submesh) {
+    static const float kLodRatios[] = { 0.5f, 0.25f, 0.1f };
+    const float kMaxError = 0.05f;       // 5% de la diagonal de la malla
+    const size_t kMinTriangles = 64;     // Por debajo no merece la pena simplificar
+    
+    const uint32_t fullCount = static_cast<uint32_t>(submesh.indices.size());
+    submesh.lods.clear();
+    submesh.lods.push_back({ 0, fullCount, 0.0f });
+    if (fullCount / 3 < kMinTriangles)
+        return;
+    
+    std::vector<glm::vec3> positions;
+    positions.reserve(submesh.vertices.size());
+    for (const auto &vertex : submesh.vertices)
+        positions.push_back(vertex.Position);
+    std::vector<uint32_t> source(submesh.indices.begin(), submesh.indices.end());
+    
+    for (float ratio : kLodRatios) {
+        size_t target = (static_cast<size_t>(fullCount * ratio) / 3) * 3;
+        float error = 0.0f;
+        // Cada nivel parte del anterior: más rápido y los LODs quedan anidados.
+        std::vector<uint32_t> lod = MeshSimplifier::Simplify(positions, source, target, kMaxError, &error);
+        if (lod.empty() || lod.size() > source.size() * 9 / 10)
+            break;
+        source = lod;
+        // El simplificador conserva el orden del LOD 0 pero con huecos: se reordena para la caché.
+        MeshOptimizer::OptimizeVertexCache(lod, submesh.vertices.size());
+        uint32_t offset = static_cast<uint32_t>(submesh.indices.size());
+        submesh.indices.insert(submesh.indices.end(), lod.begin(), lod.end());
+        submesh.lods.push_back({ offset, static_cast<uint32_t>(lod.size()), std::max(error, submesh.lods.back().error) });
+    }
+    
+    std::string chain;
+    for (const auto &level : submesh.lods)
+        chain += " " + std::to_string(level.indexCount / 3);
+    Logger::Debug("[GenerateLODChain] Triangles per LOD:" + chain);
+}
+
+/**
+ * Reordena el LOD 0 del submesh: triángulos para la caché post-transform (Forsyth), clusters de fuera
+ * hacia dentro contra el overdraw y, por último, los vértices en orden de primer uso para el fetch.
+ * Debe llamarse antes de GenerateLODChain, ya que remapea los vértices.
+ */
+void OptimizeSubmesh(Submesh &submesh) {
+    std::vector<uint32_t> &indices = submesh.indices;
+    MeshOptimizer::OptimizeVertexCache(indices, submesh.vertices.size());
+    
+    std::vector<glm::vec3> positions;
+    positions.reserve(submesh.vertices.size());
+    for (const auto &vertex : submesh.vertices)
+        positions.push_back(vertex.Position);
+    MeshOptimizer::OptimizeOverdraw(indices, positions);
+    
+    std::vector<uint32_t> remap;
+    size_t used = MeshOptimizer::OptimizeVertexFetchRemap(remap, indices, submesh.vertices.size());
+    submesh.vertices = MeshOptimizer::RemapVertices(submesh.vertices, remap, used);
+    MeshOptimizer::RemapIndices(indices, remap);
+}
+
+Model::Model(const std::string &path, const ModelImportOptions &options) : importOptions(options) {
     Logger::Info("[Model] Loading from: " + path);
     loadModel(path);
 }
 
+uint32_t Model::addSubmesh(Submesh &&submesh) {
+    if (importOptions.optimizeMeshes) {
+        OptimizeSubmesh(submesh);
+        VertexCacheStats after = MeshOptimizer::AnalyzeVertexCache(submesh.indices, submesh.vertices.size());
+        optimizationReport.missesAfter += after.acmr * (submesh.indices.size() / 3);
+        optimizationReport.verticesAfter += submesh.vertices.size();
+    }
+    GenerateLODChain(submesh);
+    submesh.vertexFormat = importOptions.vertexFormat;
+    submesh.setupMesh();
+    submeshes.push_back(std::move(submesh));
+    return static_cast<uint32_t>(submeshes.size() - 1);
+}
+
 void Model::processNode(aiNode* node, const aiScene* scene, const glm::mat4& parentTransform, const std::string &modelDir) {
     glm::mat4 nodeTransform = parentTransform * aiMatrix4x4ToGlm(node->mTransformation);
     
     for (unsigned int i = 0; i < node->mNumMeshes; i++) {
-        aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-        Submesh submesh;
-        Logger::Info("[Model::processNode] Processing mesh from node: " + std::string(node->mName.C_Str()) +
-                     ", vertices: " + std::to_string(mesh->mNumVertices));
-        
-        // Reservar espacio para evitar realineaciones
-        submesh.vertices.reserve(mesh->mNumVertices);
-        submesh.indices.reserve(mesh->mNumFaces * 3);
+        // Los vértices quedan en el espacio del aiMesh; la transformación del nodo va en la instancia.
+        // Un aiMesh referenciado por varios nodos (ruedas, árboles repetidos) se importa una sola vez.
+        auto imported = meshSubmeshes.find(node->mMeshes[i]);
+        if (imported == meshSubmeshes.end())
+            imported = meshSubmeshes.emplace(node->mMeshes[i], importMesh(scene->mMeshes[node->mMeshes[i]], scene, modelDir)).first;
+        for (uint32_t index : imported->second)
+            instances.push_back({ index, nodeTransform, submeshes[index].bounds.Transform(nodeTransform),
+                                  glm::transpose(glm::inverse(glm::mat3(nodeTransform))) });
+    }
+    
+    for (unsigned int i = 0; i < node->mNumChildren; i++) {
+        processNode(node->mChildren[i], scene, nodeTransform, modelDir);
+    }
+}
+
+std::vector<uint32_t> Model::importMesh(aiMesh* mesh, const aiScene* scene, const std::string &modelDir) {
+    Submesh submesh;
+    Logger::Info("[Model::importMesh] Processing mesh: " + std::string(mesh->mName.C_Str()) +
+                 ", vertices: " + std::to_string(mesh->mNumVertices));
+    
+    // Reservar espacio para evitar realineaciones
+    submesh.vertices.reserve(mesh->mNumVertices);
+    submesh.indices.reserve(mesh->mNumFaces * 3);
+    
+    for (unsigned int j = 0; j < mesh->mNumVertices; j++) {
+        Vertex vertex;
+        vertex.Position = glm::vec3(mesh->mVertices[j].x,
+                                    mesh->mVertices[j].y,
+                                    mesh->mVertices[j].z);
         
-        glm::mat3 normalMatrix = glm::mat3(glm::transpose(glm::inverse(nodeTransform)));
+        if (mesh->HasNormals()) {
+            glm::vec3 norm(mesh->mNormals[j].x,
+                           mesh->mNormals[j].y,
+                           mesh->mNormals[j].z);
+            vertex.Normal = glm::normalize(norm);
+        } else {
+            vertex.Normal = glm::vec3(0.0f);
+        }
         
-        for (unsigned int j = 0; j < mesh->mNumVertices; j++) {
-            Vertex vertex;
-            glm::vec4 pos = nodeTransform * glm::vec4(mesh->mVertices[j].x,
-                                                       mesh->mVertices[j].y,
-                                                       mesh->mVertices[j].z,
-                                                       1.0f);
-            vertex.Position = glm::vec3(pos);
-            
-            if (mesh->HasNormals()) {
-                glm::vec3 norm(mesh->mNormals[j].x,
-                               mesh->mNormals[j].y,
-                               mesh->mNormals[j].z);
-                vertex.Normal = glm::normalize(normalMatrix * norm);
-            } else {
-                vertex.Normal = glm::vec3(0.0f);
-            }
-            
-            if (mesh->HasTextureCoords(0)) {
-                vertex.TexCoords = glm::vec2(mesh->mTextureCoords[0][j].x,
-                                             mesh->mTextureCoords[0][j].y);
-            } else {
-                vertex.TexCoords = glm::vec2(0.0f);
-            }
-            if (mesh->HasTextureCoords(1)) {
-                vertex.TexCoords2 = glm::vec2(mesh->mTextureCoords[1][j].x,
-                                              mesh->mTextureCoords[1][j].y);
-            } else {
-                vertex.TexCoords2 = glm::vec2(0.0f);
-            }
-            
-            if (mesh->HasTangentsAndBitangents()) {
-                glm::vec3 tan(mesh->mTangents[j].x,
-                              mesh->mTangents[j].y,
-                              mesh->mTangents[j].z);
-                vertex.Tangent = glm::normalize(normalMatrix * tan);
-            } else {
-                vertex.Tangent = glm::vec3(0.0f);
-            }
-            
-            submesh.vertices.push_back(vertex);
+        if (mesh->HasTextureCoords(0)) {
+            vertex.TexCoords = glm::vec2(mesh->mTextureCoords[0][j].x,
+                                         mesh->mTextureCoords[0][j].y);
+        } else {
+            vertex.TexCoords = glm::vec2(0.0f);
+        }
+        if (mesh->HasTextureCoords(1)) {
+            vertex.TexCoords2 = glm::vec2(mesh->mTextureCoords[1][j].x,
+                                          mesh->mTextureCoords[1][j].y);
+        } else {
+            vertex.TexCoords2 = glm::vec2(0.0f);
         }
         
-        for (unsigned int j = 0; j < mesh->mNumFaces; j++) {
-            aiFace face = mesh->mFaces[j];
-            for (unsigned int k = 0; k < face.mNumIndices; k++) {
-                submesh.indices.push_back(face.mIndices[k]);
-            }
+        if (mesh->HasTangentsAndBitangents()) {
+            glm::vec3 tan(mesh->mTangents[j].x,
+                          mesh->mTangents[j].y,
+                          mesh->mTangents[j].z);
+            glm::vec3 bitan(mesh->mBitangents[j].x,
+                            mesh->mBitangents[j].y,
+                            mesh->mBitangents[j].z);
+            glm::vec3 t = glm::normalize(tan);
+            // Signo de la bitangente: negativo en UVs espejadas.
+            float handedness = glm::dot(glm::cross(vertex.Normal, t), bitan) < 0.0f ? -1.0f : 1.0f;
+            vertex.Tangent = glm::vec4(t, handedness);
+        } else {
+            vertex.Tangent = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
         }
         
-        if (scene->HasMaterials()) {
-            aiMaterial* aiMat = scene->mMaterials[mesh->mMaterialIndex];
-            submesh.material = LoadMaterial(aiMat, modelDir);
+        submesh.vertices.push_back(vertex);
+    }
+    
+    for (unsigned int j = 0; j < mesh->mNumFaces; j++) {
+        aiFace face = mesh->mFaces[j];
+        for (unsigned int k = 0; k < face.mNumIndices; k++) {
+            submesh.indices.push_back(face.mIndices[k]);
         }
+    }
+    
+    // Cada aiMaterial se carga (texturas y rutas incluidas) y se registra una sola vez; los submeshes
+    // que lo usan comparten la entrada de la tabla global (por defecto si no hay material).
+    const unsigned int materialIndex = scene->HasMaterials() ? mesh->mMaterialIndex : UINT32_MAX;
+    auto material = loadedMaterials.find(materialIndex);
+    if (material == loadedMaterials.end()) {
+        Material loaded;
+        if (scene->HasMaterials())
+            loaded = LoadMaterial(scene->mMaterials[mesh->mMaterialIndex], modelDir);
+        material = loadedMaterials.emplace(materialIndex, &MaterialTable::GetInstance().Register(std::move(loaded))).first;
+    }
+    submesh.material = material->second;
+    
+    if (importOptions.optimizeMeshes) {
+        VertexCacheStats before = MeshOptimizer::AnalyzeVertexCache(submesh.indices, submesh.vertices.size());
+        optimizationReport.missesBefore += before.acmr * (submesh.indices.size() / 3);
+        optimizationReport.triangles += submesh.indices.size() / 3;
+        optimizationReport.verticesBefore += submesh.vertices.size();
         
-        submesh.setupMesh();
-        submeshes.push_back(std::move(submesh));
+        // Soldar vértices idénticos (Assimp duplica por cara en muchos exportadores).
+        std::vector<uint32_t> remap;
+        size_t unique = MeshOptimizer::GenerateVertexRemap(remap, submesh.vertices.data(), submesh.vertices.size(), sizeof(Vertex));
+        if (unique < submesh.vertices.size()) {
+            submesh.vertices = MeshOptimizer::RemapVertices(submesh.vertices, remap, unique);
+            MeshOptimizer::RemapIndices(submesh.indices, remap);
+        }
     }
     
-    for (unsigned int i = 0; i < node->mNumChildren; i++) {
-        processNode(node->mChildren[i], scene, nodeTransform, modelDir);
+    if (!MeshSplitter::NeedsSplit(submesh.vertices.size()))
+        return { addSubmesh(std::move(submesh)) };
+    
+    // Mallas con más de 65536 vértices: trozos indexables con uint16 que comparten material.
+    std::vector<uint32_t> sourceIndices(submesh.indices.begin(), submesh.indices.end());
+    std::vector<MeshChunk> chunks = MeshSplitter::Split(submesh.vertices.size(), sourceIndices);
+    Logger::Info("[Model::importMesh] Splitting mesh with " + std::to_string(submesh.vertices.size()) +
+                 " vertices into " + std::to_string(chunks.size()) + " 16-bit chunks");
+    std::vector<uint32_t> parts;
+    for (auto &chunk : chunks) {
+        Submesh part;
+        part.vertices.reserve(chunk.vertexRemap.size());
+        for (uint32_t v : chunk.vertexRemap)
+            part.vertices.push_back(submesh.vertices[v]);
+        part.indices.assign(chunk.indices.begin(), chunk.indices.end());
+        part.material = submesh.material;
+        parts.push_back(addSubmesh(std::move(part)));
     }
+    return parts;
 }
 
 void Model::loadModel(const std::string &path) {
@@ -227,11 +375,134 @@ void Model::loadModel(const std::string &path) {
     Logger::Info("[Model::loadModel] Base directory: " + modelDir);
     
     processNode(scene->mRootNode, scene, glm::mat4(1.0f), modelDir);
+    const size_t materialCount = loadedMaterials.size();
+    meshSubmeshes.clear();
+    loadedMaterials.clear();
+    
+    // Agrupar submeshes por material para minimizar cambios de estado al dibujar.
+    std::vector<uint32_t> order(submeshes.size());
+    for (uint32_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        return submeshes[a].GetMaterialId() < submeshes[b].GetMaterialId();
+    });
+    std::vector<Submesh> sorted;
+    sorted.reserve(submeshes.size());
+    std::vector<uint32_t> newIndex(submeshes.size());
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        newIndex[order[i]] = i;
+        sorted.push_back(std::move(submeshes[order[i]]));
+    }
+    submeshes = std::move(sorted);
+    for (auto &instance : instances)
+        instance.submesh = newIndex[instance.submesh];
+    // Las instancias de un mismo submesh quedan contiguas: el RenderSystem las agrupa en un draw instanciado.
+    std::stable_sort(instances.begin(), instances.end(), [](const MeshInstance &a, const MeshInstance &b) {
+        return a.submesh < b.submesh;
+    });
+    
+    bounds = AABB();
+    for (const auto &instance : instances)
+        bounds.Expand(instance.bounds);
+
+    buildOccluders();
+    
+    // Los oclusores ya tienen su propia copia: la geometría de CPU solo se conserva si se pidió.
+    const size_t residentBefore = GetResidentCPUBytes();
+    if (!importOptions.keepCPUGeometry) {
+        for (auto &submesh : submeshes)
+            submesh.ReleaseCPUData();
+    }
+    Logger::Info("[Model::loadModel] Resident CPU geometry: " + std::to_string(residentBefore / 1024) + " KB -> " +
+                 std::to_string(GetResidentCPUBytes() / 1024) + " KB" +
+                 (importOptions.keepCPUGeometry ? " (kept)" : ""));
+    
+    size_t vertexBytes = 0;
+    size_t indexBytes = 0;
+    for (const auto &submesh : submeshes) {
+        vertexBytes += submesh.GetVertexBufferBytes();
+        indexBytes += submesh.GetIndexBufferBytes();
+    }
+    Logger::Info("[Model::loadModel] " + std::to_string(submeshes.size()) + " unique submeshes, " +
+                 std::to_string(instances.size()) + " instances, " + std::to_string(materialCount) + " materials");
+    Logger::Info("[Model::loadModel] Vertex buffers: " + std::to_string(vertexBytes / 1024) + " KB (" +
+                 (importOptions.vertexFormat == VertexFormat::Compact ? "compact" : "full") + " format), index buffers: " +
+                 std::to_string(indexBytes / 1024) + " KB");
+    
+    const OptimizationReport &report = optimizationReport;
+    if (importOptions.optimizeMeshes && report.triangles > 0 && report.verticesAfter > 0) {
+        // FIFO de 16 entradas; el ATVR de antes se mide contra los vértices sin soldar.
+        Logger::Info("[Model::loadModel] Mesh optimization: ACMR " +
+                     std::to_string(report.missesBefore / report.triangles) + " -> " +
+                     std::to_string(report.missesAfter / report.triangles) + ", ATVR " +
+                     std::to_string(report.missesBefore / report.verticesBefore) + " -> " +
+                     std::to_string(report.missesAfter / report.verticesAfter) + ", vertices " +
+                     std::to_string(report.verticesBefore) + " -> " + std::to_string(report.verticesAfter));
+    }
 }
 
-void Model::Draw() {
-    for (auto &submesh : submeshes) {
-        if (submesh.VAO != 0)
-            submesh.Draw();
+void Model::buildOccluders() {
+    occluders.clear();
+    occluderInstances.clear();
+    // Escala máxima con la que se instancia cada submesh, para comparar su tamaño con el del modelo.
+    std::vector<float> instanceScale(submeshes.size(), 0.0f);
+    for (const auto &instance : instances) {
+        glm::mat3 m(instance.transform);
+        float scale = std::max({ glm::length(m[0]), glm::length(m[1]), glm::length(m[2]) });
+        instanceScale[instance.submesh] = std::max(instanceScale[instance.submesh], scale);
     }
+    
+    std::vector<int32_t> submeshOccluder(submeshes.size(), -1);
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> lodIndices;
+    for (size_t i = 0; i < submeshes.size(); ++i) {
+        const Submesh &submesh = submeshes[i];
+        if (submesh.lods.empty() || instanceScale[i] <= 0.0f)
+            continue;
+        // El LOD más detallado que quepa en el límite de triángulos de un oclusor. Solo se aceptan
+        // LODs con error pequeño para que el oclusor no sobresalga de la malla real.
+        const SubmeshLOD *level = &submesh.lods.front();
+        for (const auto &candidate : submesh.lods) {
+            if (candidate.error > 0.01f)
+                break;
+            level = &candidate;
+            if (candidate.indexCount / 3 <= OcclusionCuller::MaxOccluderTriangles)
+                break;
+        }
+        positions.clear();
+        positions.reserve(submesh.vertices.size());
+        for (const auto &vertex : submesh.vertices)
+            positions.push_back(vertex.Position);
+        lodIndices.assign(submesh.indices.begin() + level->indexOffset,
+                          submesh.indices.begin() + level->indexOffset + level->indexCount);
+        // Los vértices están en espacio del submesh: la AABB del modelo se lleva a esa escala.
+        AABB meshScaleBounds(bounds.min / instanceScale[i], bounds.max / instanceScale[i]);
+        OccluderMesh occluder;
+        if (OcclusionCuller::BuildOccluder(positions, lodIndices, meshScaleBounds, occluder)) {
+            submeshOccluder[i] = static_cast<int32_t>(occluders.size());
+            occluders.push_back(std::move(occluder));
+        }
+    }
+    
+    size_t triangles = 0;
+    for (const auto &instance : instances) {
+        int32_t occluder = submeshOccluder[instance.submesh];
+        if (occluder < 0)
+            continue;
+        occluderInstances.push_back({ static_cast<uint32_t>(occluder), instance.transform,
+                                      occluders[occluder].bounds.Transform(instance.transform) });
+        triangles += occluders[occluder].TriangleCount();
+    }
+    Logger::Info("[Model::buildOccluders] " + std::to_string(occluderInstances.size()) + " occluder instances (" +
+                 std::to_string(occluders.size()) + " meshes, " + std::to_string(triangles) + " triangles) out of " +
+                 std::to_string(instances.size()) + " instances");
+}
+
+size_t Model::GetResidentCPUBytes() const {
+    size_t bytes = 0;
+    for (const auto &submesh : submeshes)
+        bytes += submesh.GetCPUBytes();
+    for (const auto &occluder : occluders)
+        bytes += occluder.positions.capacity() * sizeof(glm::vec3) + occluder.indices.capacity() * sizeof(uint32_t);
+    return bytes;
 }
\ No newline at end of file
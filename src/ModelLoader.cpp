@@ -41,8 +41,8 @@ void processNode(aiNode *node, const aiScene *scene,
                 vertex.TexCoords2 = glm::vec2(0.0f);
             
             vertex.Tangent = mesh->HasTangentsAndBitangents()
-                                 ? glm::normalize(glm::vec3(mesh->mTangents[j].x, mesh->mTangents[j].y, mesh->mTangents[j].z))
-                                 : glm::vec3(0.0f);
+                                 ? glm::vec4(glm::normalize(glm::vec3(mesh->mTangents[j].x, mesh->mTangents[j].y, mesh->mTangents[j].z)), 1.0f)
+                                 : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
             vertices.push_back(vertex);
         }
 
@@ -90,7 +90,7 @@ void processNode(aiNode *node, const aiScene *scene,
             }
             for (unsigned int j = 0; j < mesh->mNumVertices; j++)
             {
-                vertices[vertexOffset + j].Tangent = glm::normalize(tempTangents[j]);
+                vertices[vertexOffset + j].Tangent = glm::vec4(glm::normalize(tempTangents[j]), 1.0f);
             }
             Logger::Debug("[ModelLoader] Manually calculated tangents.");
         }
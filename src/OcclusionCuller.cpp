@@ -0,0 +1,269 @@
+// OcclusionCuller.cpp
+#include "renderer/OcclusionCuller.h"
+#include "utils/Simd.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Tolerancia relativa del test de visibilidad: evita que un oclusor se descarte a sí mismo
+    // cuando su cara coincide con la de su AABB.
+    constexpr float kDepthTolerance = 1e-4f;
+
+    float EdgeFunction(float ax, float ay, float bx, float by, float px, float py)
+    {
+        return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+    }
+}
+
+OcclusionCuller::OcclusionCuller(int width, int height)
+    : width((std::max(width, 4) + 3) & ~3), height(std::max(height, 1)) {
+    // El ancho es múltiplo de 4 para que cada bloque SIMD quede dentro de la fila.
+    depth.assign(static_cast<size_t>(this->width) * this->height, 0.0f);
+}
+
+void OcclusionCuller::BeginFrame(const glm::mat4& viewProjMatrix) {
+    viewProj = viewProjMatrix;
+    std::fill(depth.begin(), depth.end(), 0.0f);
+    stats = OcclusionStats();
+}
+
+void OcclusionCuller::RasterizeOccluder(const OccluderMesh& occluder, const glm::mat4& model) {
+    if (occluder.indices.empty())
+        return;
+    RasterizeTriangles(occluder.positions.data(), occluder.positions.size(), occluder.indices.data(),
+                       occluder.indices.size(), model);
+    stats.occluders++;
+}
+
+void OcclusionCuller::RasterizeTriangles(const glm::vec3* positions, size_t vertexCount, const uint32_t* indices,
+                                         size_t indexCount, const glm::mat4& model) {
+    // Transformar cada vértice una sola vez.
+    glm::mat4 mvp = viewProj * model;
+    clipScratch.resize(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i)
+        clipScratch[i] = mvp * glm::vec4(positions[i], 1.0f);
+
+    for (size_t i = 0; i + 2 < indexCount; i += 3) {
+        const glm::vec4& a = clipScratch[indices[i]];
+        const glm::vec4& b = clipScratch[indices[i + 1]];
+        const glm::vec4& c = clipScratch[indices[i + 2]];
+        // Descartar triángulos completamente fuera de un mismo plano lateral o del far.
+        if ((a.x > a.w && b.x > b.w && c.x > c.w) || (a.x < -a.w && b.x < -b.w && c.x < -c.w) ||
+            (a.y > a.w && b.y > b.w && c.y > c.w) || (a.y < -a.w && b.y < -b.w && c.y < -c.w) ||
+            (a.z > a.w && b.z > b.w && c.z > c.w))
+            continue;
+        RasterizeClipTriangle(a, b, c);
+    }
+}
+
+void OcclusionCuller::RasterizeClipTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c) {
+    // Recorte contra el plano near (z + w >= 0); el resto de planos los resuelve el bounding box en pantalla.
+    const glm::vec4 in[3] = { a, b, c };
+    float dist[3] = { a.z + a.w, b.z + b.w, c.z + c.w };
+    if (dist[0] >= 0.0f && dist[1] >= 0.0f && dist[2] >= 0.0f) {
+        RasterizeScreenTriangle(ToScreen(a), ToScreen(b), ToScreen(c));
+        return;
+    }
+    if (dist[0] < 0.0f && dist[1] < 0.0f && dist[2] < 0.0f)
+        return;
+
+    glm::vec4 poly[4];
+    int count = 0;
+    for (int i = 0; i < 3; ++i) {
+        int j = (i + 1) % 3;
+        if (dist[i] >= 0.0f)
+            poly[count++] = in[i];
+        if ((dist[i] >= 0.0f) != (dist[j] >= 0.0f)) {
+            float t = dist[i] / (dist[i] - dist[j]);
+            poly[count++] = in[i] + (in[j] - in[i]) * t;
+        }
+    }
+    for (int i = 1; i + 1 < count; ++i)
+        RasterizeScreenTriangle(ToScreen(poly[0]), ToScreen(poly[i]), ToScreen(poly[i + 1]));
+}
+
+OcclusionCuller::ScreenVertex OcclusionCuller::ToScreen(const glm::vec4& clip) const {
+    float invW = 1.0f / std::max(clip.w, 1e-6f);
+    ScreenVertex v;
+    v.x = (clip.x * invW * 0.5f + 0.5f) * width;
+    v.y = (clip.y * invW * 0.5f + 0.5f) * height;
+    v.invW = invW;
+    return v;
+}
+
+void OcclusionCuller::RasterizeScreenTriangle(ScreenVertex v0, ScreenVertex v1, ScreenVertex v2) {
+    float area = EdgeFunction(v0.x, v0.y, v1.x, v1.y, v2.x, v2.y);
+    if (std::abs(area) < 1e-8f)
+        return;
+    // Los oclusores se rasterizan por las dos caras.
+    if (area < 0.0f) {
+        std::swap(v1, v2);
+        area = -area;
+    }
+
+    int minX = std::max(0, static_cast<int>(std::floor(std::min({ v0.x, v1.x, v2.x }))));
+    int maxX = std::min(width - 1, static_cast<int>(std::floor(std::max({ v0.x, v1.x, v2.x }))));
+    int minY = std::max(0, static_cast<int>(std::floor(std::min({ v0.y, v1.y, v2.y }))));
+    int maxY = std::min(height - 1, static_cast<int>(std::floor(std::max({ v0.y, v1.y, v2.y }))));
+    if (minX > maxX || minY > maxY)
+        return;
+    stats.occluderTriangles++;
+
+    // Funciones de arista y profundidad como ecuaciones lineales en (x, y): valor en el primer
+    // centro de píxel y derivadas por columna y por fila.
+    const int startX = minX & ~3;
+    const float px = startX + 0.5f;
+    const float py = minY + 0.5f;
+    float e0 = EdgeFunction(v1.x, v1.y, v2.x, v2.y, px, py);
+    float e1 = EdgeFunction(v2.x, v2.y, v0.x, v0.y, px, py);
+    float e2 = EdgeFunction(v0.x, v0.y, v1.x, v1.y, px, py);
+    const float e0dx = -(v2.y - v1.y), e0dy = v2.x - v1.x;
+    const float e1dx = -(v0.y - v2.y), e1dy = v0.x - v2.x;
+    const float e2dx = -(v1.y - v0.y), e2dy = v1.x - v0.x;
+
+    const float invArea = 1.0f / area;
+    const float z0 = v0.invW, z10 = (v1.invW - v0.invW) * invArea, z20 = (v2.invW - v0.invW) * invArea;
+    // z = z0 + (e1 * (z1 - z0) + e2 * (z2 - z0)) / area
+    float z = z0 + e1 * z10 + e2 * z20;
+    const float zdx = e1dx * z10 + e2dx * z20;
+    const float zdy = e1dy * z10 + e2dy * z20;
+
+#ifdef TOXIC_SIMD_SSE2
+    const __m128 laneOffsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128 e0Step = _mm_set1_ps(4.0f * e0dx);
+    const __m128 e1Step = _mm_set1_ps(4.0f * e1dx);
+    const __m128 e2Step = _mm_set1_ps(4.0f * e2dx);
+    const __m128 zStep = _mm_set1_ps(4.0f * zdx);
+    const __m128 zero = _mm_setzero_ps();
+    for (int y = minY; y <= maxY; ++y) {
+        __m128 w0 = _mm_add_ps(_mm_set1_ps(e0), _mm_mul_ps(laneOffsets, _mm_set1_ps(e0dx)));
+        __m128 w1 = _mm_add_ps(_mm_set1_ps(e1), _mm_mul_ps(laneOffsets, _mm_set1_ps(e1dx)));
+        __m128 w2 = _mm_add_ps(_mm_set1_ps(e2), _mm_mul_ps(laneOffsets, _mm_set1_ps(e2dx)));
+        __m128 zv = _mm_add_ps(_mm_set1_ps(z), _mm_mul_ps(laneOffsets, _mm_set1_ps(zdx)));
+        float* row = depth.data() + static_cast<size_t>(y) * width;
+        for (int x = startX; x <= maxX; x += 4) {
+            __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(w0, zero), _mm_cmpge_ps(w1, zero)),
+                                       _mm_cmpge_ps(w2, zero));
+            if (_mm_movemask_ps(inside)) {
+                __m128 current = _mm_loadu_ps(row + x);
+                __m128 nearer = _mm_max_ps(current, zv);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, current)));
+            }
+            w0 = _mm_add_ps(w0, e0Step);
+            w1 = _mm_add_ps(w1, e1Step);
+            w2 = _mm_add_ps(w2, e2Step);
+            zv = _mm_add_ps(zv, zStep);
+        }
+        e0 += e0dy;
+        e1 += e1dy;
+        e2 += e2dy;
+        z += zdy;
+    }
+#else
+    for (int y = minY; y <= maxY; ++y) {
+        float w0 = e0, w1 = e1, w2 = e2, zv = z;
+        float* row = depth.data() + static_cast<size_t>(y) * width;
+        for (int x = startX; x <= maxX; ++x) {
+            if (w0 >= 0.0f && w1 >= 0.0f && w2 >= 0.0f)
+                row[x] = std::max(row[x], zv);
+            w0 += e0dx;
+            w1 += e1dx;
+            w2 += e2dx;
+            zv += zdx;
+        }
+        e0 += e0dy;
+        e1 += e1dy;
+        e2 += e2dy;
+        z += zdy;
+    }
+#endif
+}
+
+bool OcclusionCuller::IsVisible(const AABB& worldBox) {
+    stats.tested++;
+    if (TestAABB(worldBox))
+        return true;
+    stats.occluded++;
+    return false;
+}
+
+bool OcclusionCuller::TestAABB(const AABB& worldBox) const {
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+    float nearestInvW = 0.0f;
+    for (int i = 0; i < 8; ++i) {
+        glm::vec3 corner((i & 1) ? worldBox.max.x : worldBox.min.x,
+                         (i & 2) ? worldBox.max.y : worldBox.min.y,
+                         (i & 4) ? worldBox.max.z : worldBox.min.z);
+        glm::vec4 clip = viewProj * glm::vec4(corner, 1.0f);
+        // Si la caja cruza el plano near no se puede proyectar de forma fiable: se considera visible.
+        if (clip.z + clip.w < 0.0f || clip.w <= 1e-6f)
+            return true;
+        ScreenVertex v = ToScreen(clip);
+        minX = std::min(minX, v.x);
+        maxX = std::max(maxX, v.x);
+        minY = std::min(minY, v.y);
+        maxY = std::max(maxY, v.y);
+        nearestInvW = std::max(nearestInvW, v.invW);
+    }
+    // Fuera de pantalla: lo resuelve el frustum culling.
+    if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height)
+        return true;
+
+    const int x0 = std::max(0, static_cast<int>(std::floor(minX)));
+    const int x1 = std::min(width - 1, static_cast<int>(std::floor(maxX)));
+    const int y0 = std::max(0, static_cast<int>(std::floor(minY)));
+    const int y1 = std::min(height - 1, static_cast<int>(std::floor(maxY)));
+    // Visible si en algún píxel el oclusor está más lejos (o no hay oclusor) que el punto más cercano.
+    const float threshold = nearestInvW * (1.0f + kDepthTolerance);
+
+#ifdef TOXIC_SIMD_SSE2
+    const int startX = x0 & ~3;
+    const __m128 thresholdV = _mm_set1_ps(threshold);
+    const int firstMask = 0xF & ~((1 << (x0 - startX)) - 1);
+    for (int y = y0; y <= y1; ++y) {
+        const float* row = depth.data() + static_cast<size_t>(y) * width;
+        for (int x = startX; x <= x1; x += 4) {
+            int mask = _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(row + x), thresholdV));
+            if (x == startX)
+                mask &= firstMask;
+            if (x + 3 > x1)
+                mask &= (1 << (x1 - x + 1)) - 1;
+            if (mask)
+                return true;
+        }
+    }
+#else
+    for (int y = y0; y <= y1; ++y) {
+        const float* row = depth.data() + static_cast<size_t>(y) * width;
+        for (int x = x0; x <= x1; ++x) {
+            if (row[x] <= threshold)
+                return true;
+        }
+    }
+#endif
+    return false;
+}
+
+bool OcclusionCuller::BuildOccluder(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices,
+                                    const AABB& modelBounds, OccluderMesh& out) {
+    size_t triangles = indices.size() / 3;
+    if (triangles == 0 || triangles > MaxOccluderTriangles || positions.empty())
+        return false;
+
+    AABB box;
+    for (const auto& p : positions)
+        box.Expand(p);
+    // Un buen oclusor tiene al menos dos dimensiones grandes (muros, fachadas, troncos...).
+    glm::vec3 size = box.max - box.min;
+    float dims[3] = { size.x, size.y, size.z };
+    std::sort(dims, dims + 3);
+    float modelDiagonal = glm::length(modelBounds.max - modelBounds.min);
+    if (dims[1] < 0.025f * modelDiagonal)
+        return false;
+
+    out.positions = positions;
+    out.indices = indices;
+    out.bounds = box;
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+// PointShadowScheduler.cpp
+#include "renderer/PointShadowScheduler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Mínimo de |v| con v en [lo, hi].
+    float MinAbs(float lo, float hi)
+    {
+        if (lo <= 0.0f && hi >= 0.0f)
+            return 0.0f;
+        return std::min(std::abs(lo), std::abs(hi));
+    }
+
+    int PopCount(uint8_t mask)
+    {
+        int count = 0;
+        for (; mask; mask &= mask - 1)
+            ++count;
+        return count;
+    }
+}
+
+void PointShadowScheduler::SetSettings(const PointShadowSettings& newSettings) {
+    settings = newSettings;
+    slots.assign(settings.slotCount, LightState());
+    slotUsed.assign(settings.slotCount, 0);
+}
+
+uint8_t PointShadowScheduler::FacesTouched(const glm::vec3& lightPos, float range, const AABB& box) {
+    glm::vec3 lo = box.min - lightPos;
+    glm::vec3 hi = box.max - lightPos;
+    glm::vec3 closest = glm::clamp(glm::vec3(0.0f), lo, hi);
+    if (glm::dot(closest, closest) > range * range)
+        return 0;
+
+    // La cara +X ve los puntos con x >= max(|y|, |z|): basta con comparar el extremo en x
+    // con la menor |y| y la menor |z| de la caja.
+    uint8_t faces = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        int a = (axis + 1) % 3;
+        int b = (axis + 2) % 3;
+        float other = std::max(MinAbs(lo[a], hi[a]), MinAbs(lo[b], hi[b]));
+        if (hi[axis] >= other)
+            faces |= 1u << (axis * 2);
+        if (-lo[axis] >= other)
+            faces |= 1u << (axis * 2 + 1);
+    }
+    return faces;
+}
+
+int PointShadowScheduler::GetSlot(uint32_t light) const {
+    for (size_t s = 0; s < slots.size(); ++s) {
+        if (slotUsed[s] && slots[s].light == light)
+            return static_cast<int>(s);
+    }
+    return -1;
+}
+
+void PointShadowScheduler::Schedule(const std::vector<ShadowLight>& lights, const std::vector<AABB>& movedBounds,
+                                    const glm::vec3& cameraPos, std::vector<PointShadowRequest>& out) {
+    out.clear();
+    stats = PointShadowStats();
+
+    // Las slotCount luces más cercanas a la cámara tienen sombra; las que ya tenían slot lo conservan.
+    order.resize(lights.size());
+    for (uint32_t i = 0; i < lights.size(); ++i)
+        order[i] = i;
+    auto priority = [&](const ShadowLight& light) {
+        return std::max(glm::length(light.position - cameraPos) - light.range, 0.0f);
+    };
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return priority(lights[a]) < priority(lights[b]);
+    });
+    if (order.size() > slots.size())
+        order.resize(slots.size());
+
+    std::vector<uint8_t> keep(slots.size(), 0);
+    std::vector<uint32_t> unassigned;
+    for (uint32_t i : order) {
+        int slot = GetSlot(lights[i].light);
+        if (slot >= 0)
+            keep[slot] = 1;
+        else
+            unassigned.push_back(i);
+    }
+    for (size_t s = 0; s < slots.size(); ++s)
+        slotUsed[s] = keep[s];
+    size_t nextFree = 0;
+    for (uint32_t i : unassigned) {
+        while (slotUsed[nextFree])
+            ++nextFree;
+        slotUsed[nextFree] = 1;
+        slots[nextFree] = LightState();
+        slots[nextFree].light = lights[i].light;
+        slots[nextFree].pendingFaces = AllFaces;
+    }
+
+    // Caras sucias: la luz se movió o cambió de alcance, o una caja movida entra en sus pirámides.
+    for (uint32_t i : order) {
+        LightState& state = slots[GetSlot(lights[i].light)];
+        if (state.position != lights[i].position || state.range != lights[i].range) {
+            state.position = lights[i].position;
+            state.range = lights[i].range;
+            state.pendingFaces = AllFaces;
+        }
+        for (const AABB& box : movedBounds) {
+            if (state.pendingFaces == AllFaces)
+                break;
+            state.pendingFaces |= FacesTouched(state.position, state.range, box);
+        }
+        state.priority = priority(lights[i]);
+    }
+
+    // Presupuesto: primero lo que más lleva esperando, luego lo más cercano.
+    std::vector<uint32_t> dirty;
+    for (uint32_t s = 0; s < slots.size(); ++s) {
+        if (!slotUsed[s])
+            continue;
+        stats.shadowedLights++;
+        if (slots[s].pendingFaces)
+            dirty.push_back(s);
+    }
+    stats.dirtyLights = static_cast<uint32_t>(dirty.size());
+    std::sort(dirty.begin(), dirty.end(), [&](uint32_t a, uint32_t b) {
+        if (slots[a].waitFrames != slots[b].waitFrames)
+            return slots[a].waitFrames > slots[b].waitFrames;
+        return slots[a].priority < slots[b].priority;
+    });
+    uint32_t budget = settings.faceBudget;
+    for (uint32_t s : dirty) {
+        LightState& state = slots[s];
+        uint8_t faces = 0;
+        for (int face = 0; face < 6 && budget > 0; ++face) {
+            if (state.pendingFaces & (1u << face)) {
+                faces |= 1u << face;
+                --budget;
+            }
+        }
+        state.pendingFaces &= ~faces;
+        if (faces)
+            out.push_back({ state.light, s, faces });
+        stats.renderedFaces += PopCount(faces);
+        stats.pendingFaces += PopCount(state.pendingFaces);
+        state.waitFrames = faces ? 0 : state.waitFrames + 1; // Frames sin ser atendida
+    }
+}
\ No newline at end of file
@@ -4,9 +4,16 @@
 #include "components/TransformComponent.h"
 #include "components/RenderComponent.h"
 #include "renderer/Shader.h"
+#include "renderer/MaterialTable.h"
+#include "renderer/FrameConstants.h"
+#include "engine/SceneResources.h"
+#include "engine/LightManager.h"
+#include "engine/Config.h"
+#include "renderer/Frustum.h"
 #include "engine/Camera.h"
 #include "utils/GLDebug.h"
 #include "utils/Logger.h"
+#include "utils/ThreadPool.h"
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/glm.hpp>
 
@@ -14,40 +21,1008 @@ void RenderSystem::Init(Coordinator* coordinator, Shader* shader, Camera* camera
     mCoordinator = coordinator;
     mShader = shader;
     mCamera = camera;
-    // Cachear la ubicación de la uniform "model"
-    mModelLoc = glGetUniformLocation(mShader->ID, "model");
+    // Cachear las ubicaciones de las uniforms (reflejadas por el Shader tras el linkado)
+    mForwardUniforms = QueryDrawUniforms(*mShader);
+
+    // Los bloques de sombras se suben siempre (sin cascadas ni slots mientras no se activen) para que el shader los lea.
+    if (mPointShadowInfo.empty())
+        mPointShadowInfo.assign(1, glm::vec4(-1.0f, 0.0f, 0.0f, 0.0f));
+    BindLightingResources(*mShader);
+}
+
+void RenderSystem::ConfigureFromConfig(SceneResources& resources, const Config& config, const std::string& prefix,
+                                       LightManager& lights) {
+    if (!mShader) return;
+
+    SetCullingMode(config.culling == "flat" ? CullingMode::Flat : CullingMode::BVH);
+    SetOcclusionCulling(config.occlusionCulling, static_cast<size_t>(config.occluderTriangleBudget));
+    SetLODBias(config.lodBias);
+
+    if (config.renderPath == "deferred") {
+        Shader* gbufferShader = resources.LoadShader("pbr_vertex.glsl", "gbuffer_fragment.glsl", prefix + "GBufferShader").get();
+        Shader* lightingShader = resources.LoadShader("deferred_lighting_vertex.glsl", "deferred_lighting_fragment.glsl",
+                                                      prefix + "LightingShader").get();
+        if (!gbufferShader || !lightingShader) {
+            Logger::Error("[RenderSystem] " + prefix + ": failed to load the deferred path shaders.");
+            gbufferShader = nullptr;
+            lightingShader = nullptr;
+        }
+        SetDeferredShaders(gbufferShader, lightingShader);
+        SetRenderPath(RenderPath::Deferred);
+    }
+
+    if (config.depthPrepass) {
+        Shader* depthShader = resources.LoadShader("depth_vertex.glsl", "depth_fragment.glsl", prefix + "DepthShader").get();
+        if (depthShader)
+            depthShader->BindUniformBlock("FrameConstants", FrameUniforms::BindingPoint);
+        else
+            Logger::Error("[RenderSystem] " + prefix + ": failed to load the depth pre-pass shader.");
+        SetDepthPrepass(depthShader);
+    }
+
+    // Luces de config, a continuación de las que ya tenga lights.
+    const uint32_t firstLight = static_cast<uint32_t>(lights.GetLights().size());
+    for (const LightConfig& lc : config.lights) {
+        Light light{};
+        if (lc.type == "point")
+            light.typeAndPadding = glm::vec4(0, 0, 0, 0);
+        else if (lc.type == "directional")
+            light.typeAndPadding = glm::vec4(static_cast<float>(LightType::DIRECTIONAL), 0, 0, 0);
+        light.position = glm::vec4(lc.position, lc.range);
+        light.direction = glm::vec4(glm::normalize(lc.direction), 0.0f);
+        light.colorAndIntensity = glm::vec4(lc.color, 1.0f);
+        lights.AddLight(light);
+    }
+
+    // Sombras en cascada para la primera direccional que las pide.
+    for (size_t i = 0; i < config.lights.size(); ++i) {
+        const LightConfig& lc = config.lights[i];
+        if (lc.type != "directional" || !lc.castShadows)
+            continue;
+        Shader* shadowShader = resources.LoadShader("shadow_vertex.glsl", "depth_fragment.glsl", prefix + "ShadowShader").get();
+        if (!shadowShader) {
+            Logger::Error("[RenderSystem] " + prefix + ": failed to load the shadow shader.");
+            break;
+        }
+        ShadowCascadeSettings shadowSettings;
+        shadowSettings.cascadeCount = static_cast<uint32_t>(config.shadowCascades);
+        shadowSettings.resolution = static_cast<uint32_t>(config.shadowResolution);
+        shadowSettings.maxDistance = config.shadowDistance;
+        SetDirectionalShadows(shadowShader, static_cast<int>(firstLight + i), lc.direction, shadowSettings);
+        break;
+    }
+
+    // Las puntuales que piden sombra compiten por el atlas de cubos (mismo shader que las cascadas).
+    std::vector<uint32_t> pointShadowLights;
+    for (size_t i = 0; i < config.lights.size(); ++i) {
+        if (config.lights[i].type == "point" && config.lights[i].castShadows)
+            pointShadowLights.push_back(firstLight + static_cast<uint32_t>(i));
+    }
+    if (!pointShadowLights.empty()) {
+        Shader* shadowShader = resources.LoadShader("shadow_vertex.glsl", "depth_fragment.glsl", prefix + "ShadowShader").get();
+        PointShadowSettings pointShadowSettings;
+        pointShadowSettings.slotCount = static_cast<uint32_t>(config.pointShadowSlots);
+        pointShadowSettings.resolution = static_cast<uint32_t>(config.pointShadowResolution);
+        pointShadowSettings.faceBudget = static_cast<uint32_t>(config.pointShadowFaceBudget);
+        SetPointShadows(shadowShader, &lights.GetLights(), pointShadowLights, pointShadowSettings);
+    }
+
+    if (!lights.BindBlocks(*mShader) || (mLightingShader && !lights.BindBlocks(*mLightingShader)))
+        Logger::Error("[RenderSystem] " + prefix +
+                      ": light blocks (LightBlock, LightBuffer, ClusterBlock, LightIndexBlock) not found in shader.");
+    else
+        Logger::Info("[RenderSystem] " + prefix + ": clustered light blocks bound.");
+
+    if (!mShader->BindUniformBlock("FrameConstants", FrameUniforms::BindingPoint))
+        Logger::Error("[RenderSystem] " + prefix + ": 'FrameConstants' uniform block not found in shader.");
+    if (!mShader->BindStorageBlock("MaterialBlock", MaterialTable::BindingPoint))
+        Logger::Error("[RenderSystem] " + prefix + ": 'MaterialBlock' storage block not found in shader.");
+    if (mGBufferShader) {
+        mGBufferShader->BindUniformBlock("FrameConstants", FrameUniforms::BindingPoint);
+        mGBufferShader->BindStorageBlock("MaterialBlock", MaterialTable::BindingPoint);
+        mLightingShader->BindUniformBlock("FrameConstants", FrameUniforms::BindingPoint);
+    }
+
+    // Los samplers no cambian entre frames: se configuran una sola vez.
+    BindMaterialSamplers(*mShader);
+    if (mGBufferShader)
+        BindMaterialSamplers(*mGBufferShader);
+
+    // Variantes por material del shader PBR y del G-buffer, con los mismos bloques y samplers que el ubershader.
+    if (config.shaderVariants) {
+        const uint32_t maxLights = static_cast<uint32_t>(config.maxLightsPerCluster);
+        ShaderVariantCache* forward = resources.LoadShaderVariants("pbr_vertex.glsl", "pbr_fragment.glsl",
+                                                                   prefix + "ShaderVariants", maxLights).get();
+        ShaderVariantCache* gbuffer = nullptr;
+        if (mGBufferShader)
+            gbuffer = resources.LoadShaderVariants("pbr_vertex.glsl", "gbuffer_fragment.glsl",
+                                                   prefix + "GBufferVariants", maxLights).get();
+        LightManager* lightManager = &lights;
+        auto setup = [lightManager](Shader& program) {
+            program.BindUniformBlock("FrameConstants", FrameUniforms::BindingPoint);
+            program.BindStorageBlock("MaterialBlock", MaterialTable::BindingPoint);
+            lightManager->BindBlocks(program); // Sin efecto en el G-buffer (no evalúa luces)
+            BindMaterialSamplers(program);
+        };
+        forward->AddSetup(setup);
+        if (gbuffer)
+            gbuffer->AddSetup(setup);
+        SetShaderVariants(forward, gbuffer);
+    }
+}
+
+void RenderSystem::Release() {
+    if (mFullscreenVAO != 0)
+        GLCall(glDeleteVertexArrays(1, &mFullscreenVAO));
+    mFullscreenVAO = 0;
+    // Una consulta aún pendiente se descarta: nadie va a leer su resultado.
+    if (mOverdrawQueries[0] != 0)
+        GLCall(glDeleteQueries(2, mOverdrawQueries));
+    mOverdrawQueries[0] = mOverdrawQueries[1] = 0;
+    mOverdrawQueryPending[0] = mOverdrawQueryPending[1] = false;
+}
+
+void RenderSystem::BindLightingResources(Shader& shader) {
+    if (!shader.BindStorageBlock("InstanceBlock", InstanceBindingPoint))
+        Logger::Error("[RenderSystem] 'InstanceBlock' storage block not found in shader " + std::to_string(shader.ID) + ".");
+    shader.BindStorageBlock("NormalMatrixBlock", NormalMatrixBindingPoint);
+    // Los shaders de G-buffer no tienen bloques ni samplers de sombras: las llamadas no hacen nada.
+    shader.BindUniformBlock("ShadowBlock", ShadowBindingPoint);
+    shader.BindStorageBlock("PointShadowBlock", PointShadowBindingPoint);
+    shader.Use();
+    GLCall(glUniform1i(shader.GetUniformLocation("shadowMap"), ShadowMapUnit));
+    GLCall(glUniform1i(shader.GetUniformLocation("pointShadowMap"), PointShadowMapUnit));
+}
+
+void RenderSystem::BindMaterialSamplers(Shader& shader) {
+    shader.Use();
+    GLCall(glUniform1i(shader.GetUniformLocation("albedoMap"), 0));
+    GLCall(glUniform1i(shader.GetUniformLocation("metallicRoughnessMap"), 1));
+    GLCall(glUniform1i(shader.GetUniformLocation("normalMap"), 2));
+    GLCall(glUniform1i(shader.GetUniformLocation("emissiveMap"), 3));
+}
+
+RenderSystem::DrawUniforms RenderSystem::QueryDrawUniforms(Shader& shader) {
+    DrawUniforms uniforms;
+    uniforms.instanceOffset = shader.GetUniformLocation("instanceOffset");
+    uniforms.materialId = shader.GetUniformLocation("materialID");
+    uniforms.compactVertices = shader.GetUniformLocation("compactVertices");
+    uniforms.posOffset = shader.GetUniformLocation("posOffset");
+    uniforms.posScale = shader.GetUniformLocation("posScale");
+    return uniforms;
+}
+
+void RenderSystem::SetDeferredShaders(Shader* gbufferShader, Shader* lightingShader) {
+    mGBufferShader = gbufferShader;
+    mLightingShader = lightingShader;
+    if (!mGBufferShader || !mLightingShader)
+        return;
+    mGBufferUniforms = QueryDrawUniforms(*mGBufferShader);
+    if (!mGBufferShader->BindStorageBlock("InstanceBlock", InstanceBindingPoint))
+        Logger::Error("[RenderSystem] 'InstanceBlock' storage block not found in G-buffer shader.");
+    mGBufferShader->BindStorageBlock("NormalMatrixBlock", NormalMatrixBindingPoint);
+
+    // Las unidades del G-buffer son fijas: los samplers se configuran una sola vez.
+    mLightingShader->Use();
+    GLCall(glUniform1i(mLightingShader->GetUniformLocation("gAlbedoMetallic"), GBufferFirstUnit));
+    GLCall(glUniform1i(mLightingShader->GetUniformLocation("gNormalRoughness"), GBufferFirstUnit + 1));
+    GLCall(glUniform1i(mLightingShader->GetUniformLocation("gEmissive"), GBufferFirstUnit + 2));
+    GLCall(glUniform1i(mLightingShader->GetUniformLocation("gDepth"), GBufferFirstUnit + 3));
+    mInvViewProjLoc = mLightingShader->GetUniformLocation("invViewProj");
+    GLCall(glUniform1i(mLightingShader->GetUniformLocation("shadowMap"), ShadowMapUnit));
+    GLCall(glUniform1i(mLightingShader->GetUniformLocation("pointShadowMap"), PointShadowMapUnit));
+    mLightingShader->BindUniformBlock("ShadowBlock", ShadowBindingPoint);
+    mLightingShader->BindStorageBlock("PointShadowBlock", PointShadowBindingPoint);
+    if (mFullscreenVAO == 0)
+        GLCall(glGenVertexArrays(1, &mFullscreenVAO));
+}
+
+void RenderSystem::SetDepthPrepass(Shader* depthShader) {
+    mDepthShader = depthShader;
+    if (mDepthShader) {
+        mDepthUniforms = QueryDrawUniforms(*mDepthShader);
+        if (!mDepthShader->BindStorageBlock("InstanceBlock", InstanceBindingPoint))
+            Logger::Error("[RenderSystem] 'InstanceBlock' storage block not found in depth shader.");
+    }
+    Logger::Info(std::string("[RenderSystem] Depth pre-pass ") + (mDepthShader ? "enabled" : "disabled"));
+}
+
+void RenderSystem::SetDirectionalShadows(Shader* shadowShader, int lightIndex, const glm::vec3& direction,
+                                         const ShadowCascadeSettings& settings) {
+    mShadowShader = shadowShader;
+    mShadowLightIndex = lightIndex;
+    mShadowDirection = direction;
+    mShadowCascades.SetSettings(settings);
+    mStaticCacheValid = 0;
+    mLiveHasDynamic = 0;
+    if (!mShadowShader) {
+        mShadowBlockData = ShadowBlockData{};
+        return;
+    }
+    mShadowUniforms = QueryDrawUniforms(*mShadowShader);
+    mShadowViewProjLoc = mShadowShader->GetUniformLocation("shadowViewProj");
+    if (!mShadowShader->BindStorageBlock("InstanceBlock", InstanceBindingPoint))
+        Logger::Error("[RenderSystem] 'InstanceBlock' storage block not found in shadow shader.");
+    Logger::Info("[RenderSystem] Directional shadows: " + std::to_string(mShadowCascades.GetCascadeCount()) +
+                 " cascades of " + std::to_string(mShadowCascades.GetSettings().resolution) + " texels up to " +
+                 std::to_string(mShadowCascades.GetSettings().maxDistance) + " units");
+}
+
+void RenderSystem::SetPointShadows(Shader* shadowShader, const std::vector<Light>* lights,
+                                   std::vector<uint32_t> shadowedLights, const PointShadowSettings& settings) {
+    mPointShadowShader = lights ? shadowShader : nullptr;
+    mPointShadowLightSource = lights;
+    mPointShadowCandidates = std::move(shadowedLights);
+    mPointShadowScheduler.SetSettings(settings);
+    if (!mPointShadowShader)
+        return;
+    mPointShadowUniforms = QueryDrawUniforms(*mPointShadowShader);
+    mPointShadowViewProjLoc = mPointShadowShader->GetUniformLocation("shadowViewProj");
+    if (!mPointShadowShader->BindStorageBlock("InstanceBlock", InstanceBindingPoint))
+        Logger::Error("[RenderSystem] 'InstanceBlock' storage block not found in point shadow shader.");
+    Logger::Info("[RenderSystem] Point light shadows: " + std::to_string(mPointShadowCandidates.size()) +
+                 " candidate lights, " + std::to_string(settings.slotCount) + " atlas slots, " +
+                 std::to_string(settings.faceBudget) + " faces per frame");
+}
+
+void RenderSystem::SetShaderVariants(ShaderVariantCache* forward, ShaderVariantCache* gbuffer) {
+    mForwardVariants = forward;
+    mGBufferVariants = gbuffer;
+    mVariantUniforms.clear();
+    for (ShaderVariantCache* variants : { forward, gbuffer }) {
+        if (variants)
+            variants->AddSetup(BindLightingResources);
+    }
+    Logger::Info(std::string("[RenderSystem] Shader variants ") + (forward || gbuffer ? "enabled" : "disabled"));
+}
+
+void RenderSystem::PrepareShaderVariants() {
+    const MaterialTable& table = MaterialTable::GetInstance();
+    for (ShaderVariantCache* variants : { mForwardVariants, mGBufferVariants }) {
+        if (!variants)
+            continue;
+        for (uint32_t id = 0; id < table.Size(); ++id) {
+            const Material& material = table.Get(id);
+            // Los transparentes nunca pasan por el G-buffer.
+            if (variants == mGBufferVariants && material.IsTransparent())
+                continue;
+            variants->Request(variants->KeyFor(material));
+        }
+        variants->Request(ShaderVariantKey{ 0, variants->GetMaxLights() }); // Submeshes sin material
+        Logger::Info("[RenderSystem] " + std::to_string(variants->GetVariantCount()) + " shader variants for " +
+                     std::to_string(table.Size()) + " materials (" + std::to_string(variants->GetPendingCount()) +
+                     " compiling)");
+    }
+    if (mShader)
+        mShader->Use();
+}
+
+uint32_t RenderSystem::VariantFeatures(const Submesh& submesh) const {
+    if ((!mForwardVariants && !mGBufferVariants) || !submesh.material)
+        return 0;
+    return ShaderVariantKey::ForMaterial(*submesh.material, 0).features;
+}
+
+void RenderSystem::SetRenderPath(RenderPath path) {
+    if (path == RenderPath::Deferred && (!mGBufferShader || !mLightingShader)) {
+        Logger::Warning("[RenderSystem] Deferred path requested without G-buffer/lighting shaders, using forward.");
+        path = RenderPath::Forward;
+    }
+    mRenderPath = path;
+    Logger::Info(std::string("[RenderSystem] Render path: ") + (path == RenderPath::Deferred ? "deferred" : "forward"));
 }
 
 void RenderSystem::Update(float dt) {
-    if (!mCoordinator || !mShader || !mCamera) return;
-    
-    // Asegurarse de que el shader esté activo.
-    mShader->Use();
-    
-    glm::vec3 camPos = mCamera->Position;
+    if (!mCoordinator || !mCamera) return;
+
+    ThreadPool& pool = ThreadPool::GetInstance();
+    glm::mat4 viewProj = mCamera->GetProjectionMatrix() * mCamera->GetViewMatrix();
+    Frustum frustum = Frustum::FromMatrix(viewProj);
+    if (mCullingMode == CullingMode::BVH)
+        CullBVH(frustum);
+    else
+        GatherFlat(pool);
+    // Los oclusores se rasterizan en serie; el test de cada draw contra ellos va en los bloques paralelos.
+    const bool occlusion = mOcclusionEnabled && RasterizeOccluders(frustum, viewProj);
+
+    // Frustum (en modo flat), oclusión, LOD y clave de orden, repartidos entre los hilos del pool.
+    // La clave pone los opacos antes que los transparentes (el camino diferido solo escribe los opacos
+    // en el G-buffer); dentro de cada grupo ordena por variante de shader y material para minimizar
+    // cambios de programa y estado, y por submesh y LOD para instanciar.
+    auto filter = [this, occlusion](uint32_t record, DrawSortEntry& entry) {
+        return ClassifyDraw(record, occlusion, entry);
+    };
+    if (mCullingMode == CullingMode::BVH) {
+        mDrawListBuilder.Build(mQueryResults, filter, &pool);
+    } else {
+        mDrawListBuilder.Build(frustum, mWorldBounds, filter, &pool);
+        mCullingStats = mDrawListBuilder.GetCullingStats();
+    }
+    const std::vector<DrawSortEntry>& visible = mDrawListBuilder.GetSorted();
+    if (occlusion) {
+        uint32_t occluded = mDrawListBuilder.GetRejectedCount();
+        mOcclusionCuller.AddTestStats(static_cast<uint32_t>(visible.size()) + occluded, occluded);
+    }
+
+    // Paquete del frame: matrices en mundo ya calculadas (cada hilo su tramo), sombras decididas y sus
+    // oclusores recogidos.
+    FramePacket& packet = mPackets.Write();
+    packet.visible.Resize(visible.size());
+    packet.normalMatrices.resize(visible.size());
+    pool.ParallelFor(visible.size(), DrawListBuilder::MinBatch, [this, &visible, &packet](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const DrawRecord& draw = mDrawRecords[visible[i].candidate];
+            packet.visible.Set(i, draw, visible[i].lod);
+            glm::mat3 normal = WorldNormalMatrix(draw);
+            packet.normalMatrices[i] = glm::mat3x4(glm::vec4(normal[0], 0.0f), glm::vec4(normal[1], 0.0f),
+                                                   glm::vec4(normal[2], 0.0f));
+        }
+    });
+    packet.firstTransparent = mDrawListBuilder.GetFirstTransparent();
+    packet.invViewProj = glm::inverse(viewProj);
+    packet.cascadeCount = 0;
+    packet.pointShadowSlots = 0;
+    if (!visible.empty() && (mShadowShader || mPointShadowShader)) {
+        bool staticSetChanged = UpdateCasterMotion();
+        if (mShadowShader)
+            PrepareShadows(staticSetChanged, packet);
+        if (mPointShadowShader)
+            PreparePointShadows(packet);
+    }
+    packet.shadowBlock = mShadowBlockData;
+    packet.pointShadowInfo = mPointShadowInfo;
+
+    Logger::ThrottledLog("RenderSystem_Culling", LogLevel::DEBUG,
+                         "[RenderSystem] Frustum culling: " + std::to_string(mCullingStats.visible) +
+                             " visible, " + std::to_string(mCullingStats.culled) + " culled",
+                         5.0);
+    if (mOcclusionEnabled) {
+        const OcclusionStats& occlusion = mOcclusionCuller.GetStats();
+        Logger::ThrottledLog("RenderSystem_Occlusion", LogLevel::DEBUG,
+                             "[RenderSystem] Occlusion culling: " + std::to_string(occlusion.occluded) + " of " +
+                                 std::to_string(occlusion.tested) + " draws rejected, " +
+                                 std::to_string(occlusion.occluders) + " occluders (" +
+                                 std::to_string(occlusion.occluderTriangles) + " triangles)",
+                             5.0);
+    }
+}
 
-    // Recoger entidades y ordenarlas (código de ejemplo)
-    std::vector<std::pair<Model*, ECS::Entity>> sortedEntities;
+void RenderSystem::GatherFlat(ThreadPool& pool) {
+    // Los componentes se buscan en serie; transformaciones y AABB en mundo se calculan en paralelo.
+    mFlatEntities.clear();
     for (auto entity : mEntities) {
         auto& render = mCoordinator->GetComponent<RenderComponent>(entity);
-        if (render.model) {
-            sortedEntities.push_back({ render.model.get(), entity });
+        if (render.model)
+            mFlatEntities.push_back({ entity, &mCoordinator->GetComponent<TransformComponent>(entity), &render });
+    }
+    pool.ParallelFor(mFlatEntities.size(), 256, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            FlatEntity& flat = mFlatEntities[i];
+            flat.transform->UpdateTransform();
+            flat.render->worldBounds = flat.render->model->bounds.Transform(flat.transform->transform);
+        }
+    });
+
+    // Un registro por instancia de submesh y su AABB en mundo.
+    mDrawRecords.clear();
+    mSubmeshOrderBase.clear();
+    mNextSubmeshOrder = 0;
+    for (const FlatEntity& flat : mFlatEntities) {
+        Model& model = *flat.render->model;
+        uint32_t orderBase = SubmeshOrderBase(model);
+        for (size_t i = 0; i < model.instances.size(); ++i) {
+            auto& submesh = model.submeshes[model.instances[i].submesh];
+            if (submesh.VAO == 0)
+                continue;
+            mDrawRecords.push_back({ &submesh, &flat.transform->transform, &flat.transform->normalMatrix,
+                                     &model.instances[i], flat.entity, orderBase + model.instances[i].submesh, 0 });
         }
     }
-    std::sort(sortedEntities.begin(), sortedEntities.end(),
-        [](const std::pair<Model*, ECS::Entity>& a, const std::pair<Model*, ECS::Entity>& b) {
-            return a.first < b.first;
+    mWorldBounds.Resize(mDrawRecords.size());
+    pool.ParallelFor(mDrawRecords.size(), DrawListBuilder::MinBatch, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            mWorldBounds.Set(i, mDrawRecords[i].submesh->bounds.Transform(WorldTransform(mDrawRecords[i])));
+    });
+    // El estado de LOD es por registro: se conserva mientras cada frame genere los mismos.
+    if (mLODState.size() != mDrawRecords.size())
+        mLODState.assign(mDrawRecords.size(), 0);
+
+    // Los registros se regeneran cada frame: el BVH deja de ser válido.
+    mTracked.clear();
+    mProxies.clear();
+    mBVH.Clear();
+}
+
+uint32_t RenderSystem::SubmeshOrderBase(const Model& model) {
+    auto [it, inserted] = mSubmeshOrderBase.try_emplace(&model, mNextSubmeshOrder);
+    if (inserted)
+        mNextSubmeshOrder += static_cast<uint32_t>(model.submeshes.size());
+    return it->second;
+}
+
+bool RenderSystem::SyncTrackedEntities() {
+    bool changed = mTracked.size() != mEntities.size();
+    if (!changed) {
+        for (auto entity : mEntities) {
+            auto it = mTracked.find(entity);
+            if (it == mTracked.end() ||
+                it->second.model != mCoordinator->GetComponent<RenderComponent>(entity).model.get()) {
+                changed = true;
+                break;
+            }
         }
-    );
+    }
+    if (!changed)
+        return false;
 
-    // Renderizar entidades (suponiendo culling, etc.)
-    for (const auto& pair : sortedEntities) {
-        ECS::Entity entity = pair.second;
+    mTracked.clear();
+    mDrawRecords.clear();
+    mProxies.clear();
+    mBVH.Clear();
+    mSubmeshOrderBase.clear();
+    mNextSubmeshOrder = 0;
+    for (auto entity : mEntities) {
+        auto& render = mCoordinator->GetComponent<RenderComponent>(entity);
         auto& transform = mCoordinator->GetComponent<TransformComponent>(entity);
         transform.UpdateTransform();
-        GLCall(glUniformMatrix4fv(mModelLoc, 1, GL_FALSE, glm::value_ptr(transform.transform)));
+
+        TrackedEntity tracked;
+        tracked.model = render.model.get();
+        tracked.firstRecord = mDrawRecords.size();
+        tracked.lastTransform = transform.transform;
+        if (render.model) {
+            render.worldBounds = render.model->bounds.Transform(transform.transform);
+            uint32_t orderBase = SubmeshOrderBase(*render.model);
+            const auto& instances = render.model->instances;
+            for (size_t i = 0; i < instances.size(); ++i) {
+                auto& submesh = render.model->submeshes[instances[i].submesh];
+                if (submesh.VAO == 0)
+                    continue;
+                uint32_t record = static_cast<uint32_t>(mDrawRecords.size());
+                mDrawRecords.push_back({ &submesh, &transform.transform, &transform.normalMatrix, &instances[i], entity,
+                                         orderBase + instances[i].submesh, 0 });
+                mProxies.push_back(mBVH.CreateProxy(submesh.bounds.Transform(transform.transform * instances[i].transform), record));
+            }
+        }
+        tracked.recordCount = mDrawRecords.size() - tracked.firstRecord;
+        mTracked.emplace(entity, tracked);
+    }
+    mLODState.assign(mDrawRecords.size(), 0);
+    // Tras la carga, la mayoría de la escena es estática: reconstrucción completa con SAH.
+    mBVH.Rebuild();
+    Logger::Info("[RenderSystem] BVH built: " + std::to_string(mBVH.GetProxyCount()) +
+                 " proxies, height " + std::to_string(mBVH.GetHeight()));
+    return true;
+}
+
+void RenderSystem::CullBVH(const Frustum& frustum) {
+    if (!SyncTrackedEntities()) {
+        // Refit: solo las entidades cuya transformación cambió (p. ej. el coche) tocan el árbol,
+        // y solo se reinsertan si salen de su AABB engordada.
+        for (auto& [entity, tracked] : mTracked) {
+            auto& transform = mCoordinator->GetComponent<TransformComponent>(entity);
+            transform.UpdateTransform();
+            if (transform.transform == tracked.lastTransform)
+                continue;
+            tracked.lastTransform = transform.transform;
+            if (!tracked.model)
+                continue;
+            auto& render = mCoordinator->GetComponent<RenderComponent>(entity);
+            render.worldBounds = tracked.model->bounds.Transform(transform.transform);
+            for (size_t i = tracked.firstRecord; i < tracked.firstRecord + tracked.recordCount; ++i)
+                mBVH.MoveProxy(mProxies[i], mDrawRecords[i].submesh->bounds.Transform(WorldTransform(mDrawRecords[i])));
+        }
+    }
+
+    mQueryResults.clear();
+    mBVH.QueryFrustum(frustum, mQueryResults, &mCullingStats);
+}
+
+void RenderSystem::Render() {
+    if (!mShader) return;
+    
+    // Subir (si cambió) y enlazar la tabla de materiales.
+    MaterialTable::GetInstance().UploadAndBind();
+    
+    mDrawCalls = 0;
+    // Recoger las variantes que el driver haya terminado desde el último frame.
+    for (ShaderVariantCache* variants : { mForwardVariants, mGBufferVariants }) {
+        if (variants && variants->GetPendingCount() > 0)
+            variants->Update();
+    }
+    const FramePacket& packet = mPackets.Read();
+    if (packet.visible.items.empty()) {
+        mShader->Use();
+        return;
+    }
+    if (mShadowShader && packet.cascadeCount > 0)
+        RenderShadows(packet);
+    if (mPointShadowShader && packet.pointShadowSlots > 0)
+        RenderPointShadows(packet);
+    // Datos de sombras ya actualizados por las pasadas anteriores.
+    FrameRingBuffer& ring = FrameRingBuffer::GetInstance();
+    FrameRingBuffer::Bind(GL_UNIFORM_BUFFER, ShadowBindingPoint,
+                          ring.Upload(GL_UNIFORM_BUFFER, &packet.shadowBlock, sizeof(ShadowBlockData)));
+    FrameRingBuffer::Bind(GL_SHADER_STORAGE_BUFFER, PointShadowBindingPoint,
+                          ring.Upload(GL_SHADER_STORAGE_BUFFER, packet.pointShadowInfo.data(),
+                                      static_cast<GLsizeiptr>(packet.pointShadowInfo.size() * sizeof(glm::vec4))));
+    
+    UploadInstances(packet.visible);
+    UploadNormalMatrices(packet);
+
+    if (mRenderPath == RenderPath::Deferred) {
+        RenderDeferred(packet);
+    } else {
+        DrawOpaque(packet, *mShader, mForwardUniforms, mForwardVariants);
+        DrawRange(packet.visible, packet.firstTransparent, packet.visible.Size(), mForwardUniforms, false,
+                  mForwardVariants, mShader);
+    }
+    Logger::ThrottledLog("RenderSystem_DrawCalls", LogLevel::DEBUG,
+                         "[RenderSystem] " + std::to_string(mDrawCalls) + " draw calls", 5.0);
+}
+
+void RenderSystem::UploadInstances(const DrawList& draws) {
+    // Matrices de modelo en orden de dibujo: cada grupo de instancias consecutivas del mismo
+    // submesh y LOD lee su rango con instanceOffset + gl_InstanceID. Update ya las calculó;
+    // aquí solo se copian a la memoria mapeada de la sección del frame.
+    FrameRingBuffer::Range range = FrameRingBuffer::GetInstance().Upload(
+        GL_SHADER_STORAGE_BUFFER, draws.transforms.data(), static_cast<GLsizeiptr>(draws.Size() * sizeof(glm::mat4)));
+    FrameRingBuffer::Bind(GL_SHADER_STORAGE_BUFFER, InstanceBindingPoint, range);
+}
+
+void RenderSystem::UploadNormalMatrices(const FramePacket& packet) {
+    FrameRingBuffer::Range range = FrameRingBuffer::GetInstance().Upload(
+        GL_SHADER_STORAGE_BUFFER, packet.normalMatrices.data(),
+        static_cast<GLsizeiptr>(packet.normalMatrices.size() * sizeof(glm::mat3x4)));
+    FrameRingBuffer::Bind(GL_SHADER_STORAGE_BUFFER, NormalMatrixBindingPoint, range);
+}
+
+bool RenderSystem::UpdateCasterMotion() {
+    bool changed = false;
+    mMovedBounds.clear();
+    auto pushBounds = [this](const AABB& box) {
+        if (box.IsValid())
+            mMovedBounds.push_back(box);
+    };
+    for (auto entity : mEntities) {
+        const glm::mat4& transform = mCoordinator->GetComponent<TransformComponent>(entity).transform;
+        const AABB& bounds = mCoordinator->GetComponent<RenderComponent>(entity).worldBounds;
+        auto [it, inserted] = mCasterMotion.try_emplace(entity);
+        if (inserted) {
+            it->second.lastTransform = transform;
+            it->second.lastBounds = bounds;
+            pushBounds(bounds);
+            changed = true;
+        } else if (transform != it->second.lastTransform) {
+            // El primer movimiento saca a la entidad de la caché estática (que hay que rehacer una vez).
+            changed |= !it->second.dynamic;
+            it->second.dynamic = true;
+            it->second.lastTransform = transform;
+            pushBounds(it->second.lastBounds);
+            pushBounds(bounds);
+            it->second.lastBounds = bounds;
+        }
+    }
+    if (mCasterMotion.size() != mEntities.size()) {
+        for (auto it = mCasterMotion.begin(); it != mCasterMotion.end();) {
+            if (mEntities.count(it->first) == 0) {
+                pushBounds(it->second.lastBounds);
+                it = mCasterMotion.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        changed = true;
+    }
+    return changed;
+}
+
+void RenderSystem::CollectCasters(const Frustum& frustum, std::vector<uint32_t>& out) {
+    out.clear();
+    if (mCullingMode == CullingMode::BVH) {
+        mBVH.QueryFrustum(frustum, out);
+        return;
+    }
+    mCasterVisibility.resize(mDrawRecords.size());
+    FrustumCuller::CullAABBs(frustum, mWorldBounds, mCasterVisibility.data());
+    for (uint32_t i = 0; i < mDrawRecords.size(); ++i) {
+        if (mCasterVisibility[i])
+            out.push_back(i);
+    }
+}
+
+void RenderSystem::PrepareShadows(bool staticSetChanged, FramePacket& packet) {
+    mShadowStats = ShadowStats();
+    if (staticSetChanged)
+        mStaticCacheValid = 0;
+    const ShadowCascadeSettings& settings = mShadowCascades.GetSettings();
+    const uint32_t cascadeCount = mShadowCascades.GetCascadeCount();
+    uint32_t replaced = mShadowCascades.Update(mCamera->GetViewMatrix(), mCamera->Fov, mCamera->AspectRatio,
+                                               mCamera->NearPlane, mCamera->FarPlane, mShadowDirection);
+    mStaticCacheValid &= ~replaced;
+
+    // Oclusores de cada cascada: los estáticos solo si su caché está invalidada; los dinámicos siempre.
+    // Siempre con el LOD 0: la caché estática no puede depender de la distancia a la cámara.
+    auto byBatch = [](const DrawRecord& a, const DrawRecord& b) {
+        return a.submesh != b.submesh ? a.submesh < b.submesh : a.lod < b.lod;
+    };
+    mShadowDraws.clear();
+    for (uint32_t c = 0; c < cascadeCount; ++c) {
+        CollectCasters(Frustum::FromMatrix(mShadowCascades.GetCascade(c).cullViewProj), mCasterResults);
+        const uint32_t bit = 1u << c;
+        CascadePass& pass = packet.cascades[c];
+        pass.viewProj = mShadowCascades.GetCascade(c).viewProj;
+        pass.refreshStatic = (mStaticCacheValid & bit) == 0;
+        pass.staticBegin = mShadowDraws.size();
+        for (uint32_t record : mCasterResults) {
+            if (pass.refreshStatic && !mCasterMotion[mDrawRecords[record].entity].dynamic)
+                mShadowDraws.push_back(mDrawRecords[record]);
+        }
+        pass.staticEnd = pass.dynamicBegin = mShadowDraws.size();
+        for (uint32_t record : mCasterResults) {
+            if (mCasterMotion[mDrawRecords[record].entity].dynamic)
+                mShadowDraws.push_back(mDrawRecords[record]);
+        }
+        pass.dynamicEnd = mShadowDraws.size();
+        std::sort(mShadowDraws.begin() + pass.staticBegin, mShadowDraws.begin() + pass.staticEnd, byBatch);
+        std::sort(mShadowDraws.begin() + pass.dynamicBegin, mShadowDraws.begin() + pass.dynamicEnd, byBatch);
+        mShadowStats.staticCasters += static_cast<uint32_t>(pass.staticEnd - pass.staticBegin);
+        mShadowStats.dynamicCasters += static_cast<uint32_t>(pass.dynamicEnd - pass.dynamicBegin);
+
+        // Sin cambios en la caché ni dinámicos (ni ahora ni el frame anterior) el mapa final sigue valiendo.
+        // El hilo de GL dibuja todo paquete publicado: las cachés se dan por regeneradas desde ya.
+        const bool hasDynamic = pass.dynamicEnd > pass.dynamicBegin;
+        pass.refreshLive = pass.refreshStatic || hasDynamic || (mLiveHasDynamic & bit);
+        if (pass.refreshStatic)
+            mShadowStats.staticCascadesRendered++;
+        if (pass.refreshLive)
+            mShadowStats.cascadesRefreshed++;
+        mStaticCacheValid |= bit;
+        mLiveHasDynamic = hasDynamic ? (mLiveHasDynamic | bit) : (mLiveHasDynamic & ~bit);
+    }
+    packet.shadowDraws.Clear();
+    for (const auto& draw : mShadowDraws)
+        packet.shadowDraws.Push(draw, 0);
+    packet.cascadeCount = cascadeCount;
+    packet.shadowResolution = settings.resolution;
+
+    UpdateShadowBlock();
+    Logger::ThrottledLog("RenderSystem_Shadows", LogLevel::DEBUG,
+                         "[RenderSystem] Shadows: " + std::to_string(mShadowStats.staticCascadesRendered) +
+                             " static cascades rendered, " + std::to_string(mShadowStats.cascadesRefreshed) +
+                             " refreshed, " + std::to_string(mShadowStats.staticCasters) + " static / " +
+                             std::to_string(mShadowStats.dynamicCasters) + " dynamic casters",
+                         5.0);
+}
+
+void RenderSystem::RenderShadows(const FramePacket& packet) {
+    // El array solo se recrea tras SetDirectionalShadows, que ya invalidó las cachés estáticas.
+    mShadowMaps.Resize(static_cast<int>(packet.shadowResolution), static_cast<int>(packet.cascadeCount));
+    UploadInstances(packet.shadowDraws);
+
+    GLint viewport[4];
+    GLCall(glGetIntegerv(GL_VIEWPORT, viewport));
+    GLCall(glViewport(0, 0, mShadowMaps.GetResolution(), mShadowMaps.GetResolution()));
+    // Depth clamp: los oclusores entre la luz y el volumen de la cascada se aplastan en su plano cercano.
+    GLCall(glEnable(GL_DEPTH_CLAMP));
+    GLCall(glEnable(GL_POLYGON_OFFSET_FILL));
+    GLCall(glPolygonOffset(2.0f, 4.0f));
+    mShadowShader->Use();
+    for (uint32_t c = 0; c < packet.cascadeCount; ++c) {
+        const CascadePass& pass = packet.cascades[c];
+        GLCall(glUniformMatrix4fv(mShadowViewProjLoc, 1, GL_FALSE, glm::value_ptr(pass.viewProj)));
+        if (pass.refreshStatic) {
+            mShadowMaps.BindLayer(true, static_cast<int>(c));
+            GLCall(glClear(GL_DEPTH_BUFFER_BIT));
+            DrawRange(packet.shadowDraws, pass.staticBegin, pass.staticEnd, mShadowUniforms, true);
+        }
+        if (pass.refreshLive) {
+            mShadowMaps.CopyStaticToLive(static_cast<int>(c));
+            if (pass.dynamicEnd > pass.dynamicBegin) {
+                mShadowMaps.BindLayer(false, static_cast<int>(c));
+                DrawRange(packet.shadowDraws, pass.dynamicBegin, pass.dynamicEnd, mShadowUniforms, true);
+            }
+        }
+    }
+    GLCall(glDisable(GL_POLYGON_OFFSET_FILL));
+    GLCall(glDisable(GL_DEPTH_CLAMP));
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    GLCall(glViewport(viewport[0], viewport[1], viewport[2], viewport[3]));
+    mShadowMaps.BindLive(ShadowMapUnit);
+}
+
+void RenderSystem::PreparePointShadows(FramePacket& packet) {
+    const PointShadowSettings& settings = mPointShadowScheduler.GetSettings();
+
+    // Candidatas: luces puntuales; el alcance de la sombra es su rango (o el de por defecto si no tienen).
+    const std::vector<Light>& lights = *mPointShadowLightSource;
+    mShadowLights.clear();
+    for (uint32_t index : mPointShadowCandidates) {
+        if (index >= lights.size())
+            continue;
+        float range = lights[index].position.w > 0.0f ? lights[index].position.w : settings.defaultRange;
+        mShadowLights.push_back({ index, glm::vec3(lights[index].position), range });
+    }
+    mPointShadowScheduler.Schedule(mShadowLights, mMovedBounds, mCamera->Position, mPointShadowRequests);
+
+    // Slot, near y far por luz para el shader.
+    mPointShadowInfo.assign(std::max<size_t>(lights.size(), 1), glm::vec4(-1.0f, 0.0f, 0.0f, 0.0f));
+    for (const ShadowLight& light : mShadowLights) {
+        int slot = mPointShadowScheduler.GetSlot(light.light);
+        if (slot >= 0)
+            mPointShadowInfo[light.light] = glm::vec4(static_cast<float>(slot), settings.nearPlane, light.range, 0.0f);
+    }
+    packet.pointShadowSlots = settings.slotCount;
+    packet.pointShadowResolution = settings.resolution;
+    packet.pointShadowFaces.clear();
+    packet.pointShadowDraws.Clear();
+    if (mPointShadowRequests.empty())
+        return;
+
+    // Caras de cubo en el orden de GL (+X, -X, +Y, -Y, +Z, -Z).
+    static const glm::vec3 faceDirections[6] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+    static const glm::vec3 faceUps[6] = { { 0, -1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }, { 0, -1, 0 }, { 0, -1, 0 } };
+    mPointShadowDraws.clear();
+    for (const PointShadowRequest& request : mPointShadowRequests) {
+        glm::vec3 position(lights[request.light].position);
+        float range = mPointShadowInfo[request.light].z;
+        glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, settings.nearPlane, range);
+        for (int face = 0; face < 6; ++face) {
+            if ((request.faces & (1u << face)) == 0)
+                continue;
+            glm::mat4 viewProj = projection * glm::lookAt(position, position + faceDirections[face], faceUps[face]);
+            CollectCasters(Frustum::FromMatrix(viewProj), mCasterResults);
+            size_t begin = mPointShadowDraws.size();
+            for (uint32_t record : mCasterResults)
+                mPointShadowDraws.push_back(mDrawRecords[record]);
+            std::sort(mPointShadowDraws.begin() + begin, mPointShadowDraws.end(),
+                      [](const DrawRecord& a, const DrawRecord& b) {
+                          return a.submesh != b.submesh ? a.submesh < b.submesh : a.lod < b.lod;
+                      });
+            packet.pointShadowFaces.push_back({ request.slot, face, viewProj, begin, mPointShadowDraws.size() });
+        }
+    }
+    for (const auto& draw : mPointShadowDraws)
+        packet.pointShadowDraws.Push(draw, 0);
+
+    const PointShadowStats& stats = mPointShadowScheduler.GetStats();
+    Logger::ThrottledLog("RenderSystem_PointShadows", LogLevel::DEBUG,
+                         "[RenderSystem] Point shadows: " + std::to_string(stats.renderedFaces) + " faces rendered, " +
+                             std::to_string(stats.pendingFaces) + " deferred, " + std::to_string(stats.dirtyLights) +
+                             " of " + std::to_string(stats.shadowedLights) + " lights dirty",
+                         5.0);
+}
+
+void RenderSystem::RenderPointShadows(const FramePacket& packet) {
+    // El atlas solo se recrea tras SetPointShadows, que ya vació los slots del planificador.
+    mPointShadowAtlas.Resize(static_cast<int>(packet.pointShadowResolution), static_cast<int>(packet.pointShadowSlots));
+    mPointShadowAtlas.Bind(PointShadowMapUnit);
+    if (packet.pointShadowFaces.empty())
+        return;
+    UploadInstances(packet.pointShadowDraws);
+
+    GLint viewport[4];
+    GLCall(glGetIntegerv(GL_VIEWPORT, viewport));
+    GLCall(glViewport(0, 0, mPointShadowAtlas.GetResolution(), mPointShadowAtlas.GetResolution()));
+    GLCall(glEnable(GL_POLYGON_OFFSET_FILL));
+    GLCall(glPolygonOffset(2.0f, 4.0f));
+    mPointShadowShader->Use();
+    for (const FaceDraws& face : packet.pointShadowFaces) {
+        mPointShadowAtlas.BeginFace(static_cast<int>(face.slot), face.face);
+        GLCall(glUniformMatrix4fv(mPointShadowViewProjLoc, 1, GL_FALSE, glm::value_ptr(face.viewProj)));
+        DrawRange(packet.pointShadowDraws, face.begin, face.end, mPointShadowUniforms, true);
+    }
+    GLCall(glDisable(GL_POLYGON_OFFSET_FILL));
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    GLCall(glViewport(viewport[0], viewport[1], viewport[2], viewport[3]));
+}
+
+void RenderSystem::UpdateShadowBlock() {
+    const uint32_t cascadeCount = mShadowCascades.GetCascadeCount();
+    for (uint32_t c = 0; c < cascadeCount; ++c) {
+        mShadowBlockData.cascadeViewProj[c] = mShadowCascades.GetCascade(c).viewProj;
+        mShadowBlockData.cascadeSplits[c] = mShadowCascades.GetCascade(c).splitFar;
+    }
+    // La resolución de los ajustes: el array de mapas es del hilo de GL.
+    mShadowBlockData.shadowParams = glm::vec4(static_cast<float>(cascadeCount), static_cast<float>(mShadowLightIndex),
+                                              0.0005f, 1.0f / mShadowCascades.GetSettings().resolution);
+}
+
+void RenderSystem::DrawOpaque(const FramePacket& packet, Shader& shader, const DrawUniforms& uniforms,
+                              ShaderVariantCache* variants) {
+    if (mDepthShader && packet.firstTransparent > 0) {
+        // Solo profundidad: el sombreado posterior se ejecuta una vez por píxel (la capa visible).
+        GLCall(glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE));
+        mDepthShader->Use();
+        DrawRange(packet.visible, 0, packet.firstTransparent, mDepthUniforms, true);
+        GLCall(glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE));
+        GLCall(glDepthFunc(GL_EQUAL));
+        GLCall(glDepthMask(GL_FALSE));
+    }
+    shader.Use();
+    BeginOverdrawQuery();
+    DrawRange(packet.visible, 0, packet.firstTransparent, uniforms, false, variants, &shader);
+    EndOverdrawQuery();
+    if (mDepthShader) {
+        GLCall(glDepthFunc(GL_LESS));
+        GLCall(glDepthMask(GL_TRUE));
+    }
+}
+
+void RenderSystem::BeginOverdrawQuery() {
+    if (mOverdrawQueries[0] == 0)
+        GLCall(glGenQueries(2, mOverdrawQueries));
+    // Recoger la consulta de hace dos frames (la que se va a reutilizar) si ya está disponible.
+    int slot = mOverdrawQueryFrame & 1;
+    if (mOverdrawQueryPending[slot]) {
+        GLuint available = 0;
+        GLCall(glGetQueryObjectuiv(mOverdrawQueries[slot], GL_QUERY_RESULT_AVAILABLE, &available));
+        if (available) {
+            GLuint64 samples = 0;
+            GLCall(glGetQueryObjectui64v(mOverdrawQueries[slot], GL_QUERY_RESULT, &samples));
+            GLint viewport[4];
+            GLCall(glGetIntegerv(GL_VIEWPORT, viewport));
+            mOverdrawStats.shadedSamples = samples;
+            mOverdrawStats.pixels = static_cast<uint64_t>(viewport[2]) * static_cast<uint64_t>(viewport[3]);
+            mOverdrawStats.overdraw = mOverdrawStats.pixels ? static_cast<float>(samples) / mOverdrawStats.pixels : 0.0f;
+            Logger::ThrottledLog("RenderSystem_Overdraw", LogLevel::DEBUG,
+                                 "[RenderSystem] Opaque shading: " + std::to_string(samples) + " samples, overdraw " +
+                                     std::to_string(mOverdrawStats.overdraw) + "x (depth pre-pass " +
+                                     (mDepthShader ? "on" : "off") + ")",
+                                 5.0);
+        }
+        mOverdrawQueryPending[slot] = false;
+    }
+    GLCall(glBeginQuery(GL_SAMPLES_PASSED, mOverdrawQueries[slot]));
+}
+
+void RenderSystem::EndOverdrawQuery() {
+    GLCall(glEndQuery(GL_SAMPLES_PASSED));
+    mOverdrawQueryPending[mOverdrawQueryFrame & 1] = true;
+    mOverdrawQueryFrame++;
+}
+
+void RenderSystem::RenderDeferred(const FramePacket& packet) {
+    // El G-buffer sigue al viewport actual (se recrea si cambia el tamaño de la ventana).
+    GLint viewport[4];
+    GLCall(glGetIntegerv(GL_VIEWPORT, viewport));
+    mGBuffer.Resize(viewport[2], viewport[3]);
+
+    // 1) Geometría opaca al G-buffer. Sin blending: el alfa de los targets guarda metallic.
+    mGBuffer.BindForWriting();
+    GLCall(glDisable(GL_BLEND));
+    GLCall(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+    DrawOpaque(packet, *mGBufferShader, mGBufferUniforms, mGBufferVariants);
+
+    // 2) Iluminación: una evaluación de luces por píxel visible, independiente del overdraw.
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    GLCall(glDisable(GL_DEPTH_TEST));
+    mLightingShader->Use();
+    GLCall(glUniformMatrix4fv(mInvViewProjLoc, 1, GL_FALSE, glm::value_ptr(packet.invViewProj)));
+    mGBuffer.BindTextures(GBufferFirstUnit);
+    GLCall(glBindVertexArray(mFullscreenVAO));
+    GLCall(glDrawArrays(GL_TRIANGLES, 0, 3));
+    GLCall(glBindVertexArray(0));
+    mDrawCalls++;
+    GLCall(glEnable(GL_DEPTH_TEST));
+    GLCall(glEnable(GL_BLEND));
+
+    // 3) Transparentes en forward sobre la profundidad de los opacos, sin escribirla.
+    if (packet.firstTransparent == packet.visible.Size()) {
+        mShader->Use();
+        return;
+    }
+    mGBuffer.BlitDepthToDefault();
+    GLCall(glDepthMask(GL_FALSE));
+    mShader->Use();
+    DrawRange(packet.visible, packet.firstTransparent, packet.visible.Size(), mForwardUniforms, false, mForwardVariants,
+              mShader);
+    GLCall(glDepthMask(GL_TRUE));
+}
+
+void RenderSystem::DrawRange(const DrawList& draws, size_t begin, size_t end,
+                             const DrawUniforms& uniforms, bool depthOnly, ShaderVariantCache* variants,
+                             Shader* fallback) {
+    int lastFormat = -1;
+    const DrawUniforms* active = &uniforms;
+    const Shader* lastProgram = nullptr;
+    for (size_t first = begin; first < end;) {
+        const DrawItem& draw = draws.items[first];
+        size_t last = first + 1;
+        while (last < end && draws.items[last].submesh == draw.submesh && draws.items[last].lod == draw.lod)
+            ++last;
+        
+        // Los draws llegan ordenados por variante: el programa cambia solo entre grupos de variantes.
+        // Mientras el driver compila una variante, o si falló, el ubershader (que cubre cualquier material)
+        // la sustituye.
+        if (variants) {
+            Shader* variant = variants->TryGetVariant(ShaderVariantKey{ VariantFeatures(*draw.submesh), variants->GetMaxLights() });
+            Shader* program = variant ? variant : fallback;
+            if (program && program != lastProgram) {
+                program->Use();
+                if (variant) {
+                    auto it = mVariantUniforms.find(variant);
+                    if (it == mVariantUniforms.end())
+                        it = mVariantUniforms.emplace(variant, QueryDrawUniforms(*variant)).first;
+                    active = &it->second;
+                } else {
+                    active = &uniforms;
+                }
+                lastProgram = program;
+                lastFormat = -1; // compactVertices es estado del programa
+            }
+        }
+        
+        // Formato de vértice: el compacto necesita además la cuantización de posiciones del submesh.
+        const bool compact = draw.submesh->vertexFormat == VertexFormat::Compact;
+        if (static_cast<int>(compact) != lastFormat) {
+            GLCall(glUniform1i(active->compactVertices, compact ? 1 : 0));
+            lastFormat = static_cast<int>(compact);
+        }
+        if (compact) {
+            GLCall(glUniform3fv(active->posOffset, 1, glm::value_ptr(draw.submesh->quantization.offset)));
+            GLCall(glUniform3fv(active->posScale, 1, glm::value_ptr(draw.submesh->quantization.scale)));
+        }
+        GLCall(glUniform1i(active->instanceOffset, static_cast<GLint>(first)));
+        if (depthOnly)
+            draw.submesh->DrawGeometry(draw.lod, static_cast<GLsizei>(last - first));
+        else
+            draw.submesh->Draw(active->materialId, draw.lod, static_cast<GLsizei>(last - first));
+        mDrawCalls++;
+        first = last;
+    }
+}
+
+bool RenderSystem::RasterizeOccluders(const Frustum& frustum, const glm::mat4& viewProj) {
+    // Oclusores de las entidades dentro del frustum, de más cercano a más lejano.
+    glm::vec3 cameraPos = mCamera->Position;
+    mOccluders.clear();
+    for (auto entity : mEntities) {
         auto& render = mCoordinator->GetComponent<RenderComponent>(entity);
-        if (render.model)
-            render.model->Draw();
+        if (!render.model || render.model->occluderInstances.empty() || !frustum.IntersectsAABB(render.worldBounds))
+            continue;
+        const glm::mat4& transform = mCoordinator->GetComponent<TransformComponent>(entity).transform;
+        for (const auto& placed : render.model->occluderInstances) {
+            AABB worldBox = placed.bounds.Transform(transform);
+            if (!frustum.IntersectsAABB(worldBox))
+                continue;
+            glm::vec3 closest = glm::clamp(cameraPos, worldBox.min, worldBox.max);
+            mOccluders.push_back({ &render.model->occluders[placed.occluder], transform * placed.transform,
+                                   glm::length(closest - cameraPos) });
+        }
+    }
+    std::sort(mOccluders.begin(), mOccluders.end(),
+              [](const OccluderRecord& a, const OccluderRecord& b) { return a.distance < b.distance; });
+
+    mOcclusionCuller.BeginFrame(viewProj);
+    size_t triangles = 0;
+    for (const auto& occluder : mOccluders) {
+        if (triangles + occluder.mesh->TriangleCount() > mOccluderTriangleBudget)
+            break;
+        mOcclusionCuller.RasterizeOccluder(*occluder.mesh, occluder.transform);
+        triangles += occluder.mesh->TriangleCount();
+    }
+    return mOcclusionCuller.GetStats().occluders > 0;
+}
+
+bool RenderSystem::ClassifyDraw(uint32_t record, bool occlusion, DrawSortEntry& entry) {
+    const DrawRecord& draw = mDrawRecords[record];
+    const Submesh& submesh = *draw.submesh;
+    glm::mat4 world = WorldTransform(draw);
+    if (occlusion && !mOcclusionCuller.TestAABB(submesh.bounds.Transform(world)))
+        return false;
+
+    entry.lod = 0;
+    size_t lodCount = submesh.GetLODCount();
+    if (lodCount > 1) {
+        BoundingSphere sphere = LODSelector::TransformSphere(submesh.sphere, world);
+        float screenSize = LODSelector::ScreenSize(sphere, mCamera->Position, mCamera->Fov);
+        uint8_t& state = mLODState[record];
+        state = static_cast<uint8_t>(LODSelector::Select(screenSize, state, lodCount, mLODSettings));
+        entry.lod = state;
     }
+    bool transparent = submesh.material && submesh.material->IsTransparent();
+    entry.key = DrawListBuilder::MakeKey(transparent, VariantFeatures(submesh), submesh.GetMaterialId(),
+                                         draw.submeshOrder, entry.lod);
+    return true;
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "renderer/ResourceManager.h"
+#include "renderer/MaterialTable.h"
 #include "utils/FileUtils.h"
 #include "utils/Logger.h"
 #include <filesystem>
@@ -129,10 +130,11 @@ std::shared_ptr<Texture2D> ResourceManager::LoadTexture(const char *file, bool a
     }
 }
 
-std::shared_ptr<Model> ResourceManager::LoadModel(const char *file, std::string name)
+std::shared_ptr<Model> ResourceManager::LoadModel(const char *file, std::string name, const ModelImportOptions &options)
 {
-    // Si ya está cargado, lo devolvemos
-    auto it = Models.find(name);
+    // Si ya está cargado con las mismas opciones, lo devolvemos
+    std::string key = ModelKey(name, options);
+    auto it = Models.find(key);
     if (it != Models.end())
         return it->second;
 
@@ -144,9 +146,9 @@ std::shared_ptr<Model> ResourceManager::LoadModel(const char *file, std::string
         {
             filePath = FileUtils::ResolvePath(m_Config.projectRoot + m_Config.assets, filePath);
         }
-        auto model = std::make_shared<Model>(filePath);
-        Models[name] = model;
-        Logger::Info("[ResourceManager] Model loaded: " + name);
+        auto model = std::make_shared<Model>(filePath, options);
+        Models[key] = model;
+        Logger::Info("[ResourceManager] Model loaded: " + key);
         return model;
     }
     catch (const std::exception &e)
@@ -162,9 +164,10 @@ std::future<std::shared_ptr<Texture2D>> ResourceManager::LoadTextureAsync(const
     });
 }
 
-std::future<std::shared_ptr<Model>> ResourceManager::LoadModelAsync(const char *file, std::string name) {
-    return std::async(std::launch::async, [file, name]() {
-        return LoadModel(file, name);
+std::future<std::shared_ptr<Model>> ResourceManager::LoadModelAsync(const char *file, std::string name,
+                                                                    const ModelImportOptions &options) {
+    return std::async(std::launch::async, [file, name, options]() {
+        return LoadModel(file, name, options);
     });
 }
 
@@ -176,8 +179,20 @@ std::shared_ptr<Texture2D> ResourceManager::GetTexture(const std::string &name)
     return Textures[name];
 }
 
-std::shared_ptr<Model> ResourceManager::GetModel(const std::string &name) {
-    return Models[name];
+std::shared_ptr<Model> ResourceManager::GetModel(const std::string &name, const ModelImportOptions &options) {
+    return Models[ModelKey(name, options)];
+}
+
+std::string ResourceManager::ModelKey(const std::string &name, const ModelImportOptions &options) {
+    std::string key = name;
+    if (options.vertexFormat == VertexFormat::Compact)
+        key += "#compact";
+    if (!options.optimizeMeshes)
+        key += "#unoptimized";
+    // Sin esto, quien necesita la geometría en CPU recibiría un modelo que ya la liberó.
+    if (options.keepCPUGeometry)
+        key += "#cpu";
+    return key;
 }
 
 void ResourceManager::Clear() {
@@ -189,4 +204,5 @@ void ResourceManager::Clear() {
         GLCall(glDeleteTextures(1, &iter.second->ID));
     Textures.clear();
     Models.clear();
+    MaterialTable::GetInstance().Clear();
 }
\ No newline at end of file
@@ -12,17 +12,8 @@ std::shared_ptr<Shader> SceneResources::LoadShader(const char* vShaderFile, cons
         return it->second;
     
     try {
-        std::string vertexPath = FileUtils::NormalizePath(vShaderFile);
-        std::filesystem::path vp(vertexPath);
-        if (!vp.is_absolute()) {
-            // Suponemos que los shaders se encuentran en "./shaders/"
-            vertexPath = FileUtils::ResolvePath("./shaders/", vertexPath);
-        }
-        std::string fragmentPath = FileUtils::NormalizePath(fShaderFile);
-        std::filesystem::path fp(fragmentPath);
-        if (!fp.is_absolute()) {
-            fragmentPath = FileUtils::ResolvePath("./shaders/", fragmentPath);
-        }
+        std::string vertexPath = ResolveShaderPath(vShaderFile);
+        std::string fragmentPath = ResolveShaderPath(fShaderFile);
         
         auto shader = std::make_shared<Shader>();
         shader->Compile(vertexPath.c_str(), fragmentPath.c_str());
@@ -35,6 +26,28 @@ std::shared_ptr<Shader> SceneResources::LoadShader(const char* vShaderFile, cons
     }
 }
 
+std::shared_ptr<ShaderVariantCache> SceneResources::LoadShaderVariants(const char* vShaderFile, const char* fShaderFile,
+                                                                      const std::string& name, uint32_t maxLights) {
+    auto it = shaderVariants.find(name);
+    if(it != shaderVariants.end())
+        return it->second;
+    
+    auto variants = std::make_shared<ShaderVariantCache>(ResolveShaderPath(vShaderFile), ResolveShaderPath(fShaderFile),
+                                                         name, maxLights);
+    shaderVariants[name] = variants;
+    Logger::Info("[SceneResources] Shader variants registered: " + name);
+    return variants;
+}
+
+std::string SceneResources::ResolveShaderPath(const char* file) {
+    std::string path = FileUtils::NormalizePath(file);
+    if (!std::filesystem::path(path).is_absolute()) {
+        // Suponemos que los shaders se encuentran en "./shaders/"
+        path = FileUtils::ResolvePath("./shaders/", path);
+    }
+    return path;
+}
+
 std::shared_ptr<Texture2D> SceneResources::LoadTexture(const char* file, bool alpha, const std::string& name) {
     // Si ya está cargada, devolverla
     auto it = textures.find(name);
@@ -120,6 +133,11 @@ void SceneResources::Clear() {
     }
     shaders.clear();
     
+    for(auto &iter : shaderVariants) {
+        iter.second->Clear();
+    }
+    shaderVariants.clear();
+    
     for(auto &iter : textures) {
         GLCall(glDeleteTextures(1, &iter.second->ID));
     }
@@ -0,0 +1,87 @@
+// ShadowCascades.cpp
+#include "renderer/ShadowCascades.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Distancia hacia la luz que se añade a la matriz de culling de oclusores.
+    constexpr float CasterPullback = 1000.0f;
+}
+
+void ShadowCascades::SetSettings(const ShadowCascadeSettings& newSettings) {
+    settings = newSettings;
+    settings.cascadeCount = std::clamp(settings.cascadeCount, 1u, MaxCascades);
+    settings.coverageMargin = std::max(settings.coverageMargin, 1.0f);
+    for (bool& p : placed)
+        p = false;
+}
+
+uint32_t ShadowCascades::Update(const glm::mat4& view, float fovY, float aspect, float nearPlane, float farPlane,
+                                const glm::vec3& direction) {
+    uint32_t replaced = 0;
+    glm::vec3 dir = glm::normalize(direction);
+    if (glm::dot(dir, lightDirection) < 0.99999f) {
+        lightDirection = dir;
+        glm::vec3 up = std::abs(dir.y) > 0.99f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        lightRotation = glm::lookAt(glm::vec3(0.0f), dir, up);
+        for (bool& p : placed)
+            p = false;
+    }
+
+    const glm::mat4 invView = glm::inverse(view);
+    const float tanHalfY = std::tan(glm::radians(fovY) * 0.5f);
+    const float tanHalfX = tanHalfY * aspect;
+    const float farZ = std::min(farPlane, settings.maxDistance);
+    const uint32_t count = settings.cascadeCount;
+
+    float splitNear = nearPlane;
+    for (uint32_t i = 0; i < count; ++i) {
+        // Reparto práctico: mezcla de logarítmico y uniforme.
+        float t = static_cast<float>(i + 1) / count;
+        float logSplit = nearPlane * std::pow(farZ / nearPlane, t);
+        float uniformSplit = nearPlane + (farZ - nearPlane) * t;
+        float splitFar = settings.splitLambda * logSplit + (1.0f - settings.splitLambda) * uniformSplit;
+
+        // Esfera del slice en espacio de vista: centro en el eje, el más cercano a ambas tapas que las contiene.
+        float k = tanHalfX * tanHalfX + tanHalfY * tanHalfY;
+        float centerDepth = std::min(0.5f * (splitNear + splitFar) * (1.0f + k), splitFar);
+        glm::vec3 farCorner(tanHalfX * splitFar, tanHalfY * splitFar, -splitFar);
+        glm::vec3 nearCorner(tanHalfX * splitNear, tanHalfY * splitNear, -splitNear);
+        glm::vec3 sliceCenterView(0.0f, 0.0f, -centerDepth);
+        float sliceRadius = std::max(glm::length(farCorner - sliceCenterView), glm::length(nearCorner - sliceCenterView));
+        sliceRadius = std::ceil(sliceRadius * 16.0f) / 16.0f;
+        glm::vec3 sliceCenter = glm::vec3(lightRotation * invView * glm::vec4(sliceCenterView, 1.0f));
+
+        ShadowCascade& cascade = cascades[i];
+        cascade.splitNear = splitNear;
+        cascade.splitFar = splitFar;
+        float radius = sliceRadius * settings.coverageMargin;
+        bool inside = placed[i] && cascade.radius == radius &&
+                      std::abs(sliceCenter.x - cascade.center.x) + sliceRadius <= radius &&
+                      std::abs(sliceCenter.y - cascade.center.y) + sliceRadius <= radius &&
+                      std::abs(sliceCenter.z - cascade.center.z) + sliceRadius <= radius;
+        if (!inside) {
+            float texel = 2.0f * radius / settings.resolution;
+            cascade.center = glm::floor(sliceCenter / texel + 0.5f) * texel;
+            cascade.radius = radius;
+            glm::mat4 lightView = glm::translate(glm::mat4(1.0f), -cascade.center) * lightRotation;
+            cascade.viewProj = glm::ortho(-radius, radius, -radius, radius, -radius, radius) * lightView;
+            cascade.cullViewProj = glm::ortho(-radius, radius, -radius, radius, -radius - CasterPullback, radius) * lightView;
+            cascade.version++;
+            placed[i] = true;
+            replaced |= 1u << i;
+        }
+        splitNear = splitFar;
+    }
+    return replaced;
+}
+
+int ShadowCascades::FindCascade(float viewDepth) const {
+    for (uint32_t i = 0; i < settings.cascadeCount; ++i) {
+        if (viewDepth <= cascades[i].splitFar)
+            return static_cast<int>(i);
+    }
+    return -1;
+}
\ No newline at end of file
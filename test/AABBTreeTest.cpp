@@ -0,0 +1,264 @@
+/**
+ * @file AABBTreeTest.cpp
+ * @brief Test de CPU (sin contexto OpenGL) del BVH dinámico: consultas de frustum, caja y rayo
+ * comparadas con fuerza bruta, refit de proxies en movimiento y benchmark sobre 100k entidades.
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "renderer/Bounds.h"
+#include "renderer/Frustum.h"
+#include "renderer/FrustumCuller.h"
+#include "renderer/AABBTree.h"
+
+#include "TestCheck.h"
+
+static std::vector<AABB> MakeRandomBoxes(size_t count, unsigned seed, float range = 500.0f)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-range, range);
+    std::uniform_real_distribution<float> size(0.1f, 2.0f);
+    std::vector<AABB> boxes;
+    boxes.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        glm::vec3 c(position(rng), position(rng) * 0.1f, position(rng));
+        glm::vec3 e(size(rng), size(rng), size(rng));
+        boxes.emplace_back(c - e, c + e);
+    }
+    return boxes;
+}
+
+static bool RayHitsBox(const AABB& box, const glm::vec3& origin, const glm::vec3& dir, float maxDistance)
+{
+    float tMin = 0.0f, tMax = maxDistance;
+    for (int a = 0; a < 3; ++a)
+    {
+        if (dir[a] == 0.0f)
+        {
+            if (origin[a] < box.min[a] || origin[a] > box.max[a])
+                return false;
+            continue;
+        }
+        float t1 = (box.min[a] - origin[a]) / dir[a];
+        float t2 = (box.max[a] - origin[a]) / dir[a];
+        tMin = std::max(tMin, std::min(t1, t2));
+        tMax = std::min(tMax, std::max(t1, t2));
+    }
+    return tMin <= tMax;
+}
+
+// Las hojas guardan AABBs engordadas: se compara contra fuerza bruta sobre esas mismas cajas.
+static std::vector<AABB> FatBoxes(const AABBTree& tree, const std::vector<int32_t>& proxies)
+{
+    std::vector<AABB> fat;
+    fat.reserve(proxies.size());
+    for (int32_t proxy : proxies)
+        fat.push_back(tree.GetFatAABB(proxy));
+    return fat;
+}
+
+static void CheckQueriesMatchBruteForce(const AABBTree& tree, const std::vector<AABB>& fat)
+{
+    Frustum frustum = MakeCameraFrustum();
+    std::vector<uint32_t> result;
+    tree.QueryFrustum(frustum, result);
+    std::sort(result.begin(), result.end());
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < fat.size(); ++i)
+        if (frustum.IntersectsAABB(fat[i]))
+            expected.push_back(i);
+    CHECK(result == expected);
+
+    AABB query(glm::vec3(-50.0f, -10.0f, -50.0f), glm::vec3(50.0f, 10.0f, 50.0f));
+    result.clear();
+    tree.QueryAABB(query, result);
+    std::sort(result.begin(), result.end());
+    expected.clear();
+    for (uint32_t i = 0; i < fat.size(); ++i)
+        if (fat[i].Overlaps(query))
+            expected.push_back(i);
+    CHECK(result == expected);
+
+    glm::vec3 origin(-600.0f, 0.5f, -3.0f);
+    glm::vec3 dir = glm::normalize(glm::vec3(1.0f, 0.0f, 0.01f));
+    std::vector<AABBTree::RayHit> hits;
+    tree.QueryRay(origin, dir, 2000.0f, hits);
+    result.clear();
+    for (const auto& hit : hits)
+        result.push_back(hit.userData);
+    std::sort(result.begin(), result.end());
+    expected.clear();
+    for (uint32_t i = 0; i < fat.size(); ++i)
+        if (RayHitsBox(fat[i], origin, dir, 2000.0f))
+            expected.push_back(i);
+    CHECK(result == expected);
+}
+
+static void TestQueriesMatchBruteForce()
+{
+    std::vector<AABB> boxes = MakeRandomBoxes(5000, 3);
+    AABBTree tree;
+    std::vector<int32_t> proxies;
+    for (uint32_t i = 0; i < boxes.size(); ++i)
+        proxies.push_back(tree.CreateProxy(boxes[i], i));
+    CHECK(tree.GetProxyCount() == boxes.size());
+    CHECK(tree.Validate());
+    CheckQueriesMatchBruteForce(tree, FatBoxes(tree, proxies));
+
+    tree.Rebuild();
+    CHECK(tree.Validate());
+    CheckQueriesMatchBruteForce(tree, FatBoxes(tree, proxies));
+    std::cout << "[AABBTreeTest] Queries match brute force (height " << tree.GetHeight() << ")" << std::endl;
+}
+
+static void TestMoveAndDestroy()
+{
+    std::vector<AABB> boxes = MakeRandomBoxes(2000, 11);
+    AABBTree tree(0.5f);
+    std::vector<int32_t> proxies;
+    for (uint32_t i = 0; i < boxes.size(); ++i)
+        proxies.push_back(tree.CreateProxy(boxes[i], i));
+
+    // Un desplazamiento menor que el margen no reinserta; uno mayor sí.
+    AABB small(boxes[0].min + glm::vec3(0.2f), boxes[0].max + glm::vec3(0.2f));
+    CHECK(!tree.MoveProxy(proxies[0], small));
+    AABB big(boxes[0].min + glm::vec3(30.0f), boxes[0].max + glm::vec3(30.0f));
+    CHECK(tree.MoveProxy(proxies[0], big));
+    CHECK(tree.GetFatAABB(proxies[0]).Contains(big));
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> offset(-20.0f, 20.0f);
+    for (size_t i = 0; i < proxies.size(); i += 3)
+    {
+        glm::vec3 d(offset(rng), 0.0f, offset(rng));
+        tree.MoveProxy(proxies[i], AABB(boxes[i].min + d, boxes[i].max + d));
+    }
+    CHECK(tree.Validate());
+    CheckQueriesMatchBruteForce(tree, FatBoxes(tree, proxies));
+
+    // Destruir los proxies pares: solo deben quedar los impares.
+    for (size_t i = 0; i < proxies.size(); ++i)
+    {
+        if (i % 2 == 0)
+            tree.DestroyProxy(proxies[i]);
+    }
+    CHECK(tree.GetProxyCount() == proxies.size() / 2);
+    CHECK(tree.Validate());
+    std::vector<uint32_t> all;
+    tree.QueryAABB(AABB(glm::vec3(-1e6f), glm::vec3(1e6f)), all);
+    CHECK(all.size() == proxies.size() / 2);
+    for (uint32_t userData : all)
+        CHECK(userData % 2 == 1);
+    std::cout << "[AABBTreeTest] Move/destroy OK" << std::endl;
+}
+
+static void BenchmarkAgainstBruteForce()
+{
+    const size_t count = 100000;
+    const int iterations = 50;
+    std::vector<AABB> boxes = MakeRandomBoxes(count, 7);
+    Frustum frustum = MakeCameraFrustum();
+
+    AABBTree tree;
+    std::vector<int32_t> proxies;
+    proxies.reserve(count);
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < count; ++i)
+        proxies.push_back(tree.CreateProxy(boxes[i], i));
+    double insertMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    tree.Rebuild();
+    double rebuildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[AABBTreeTest] Build " << count << " proxies: insert " << insertMs << " ms, SAH rebuild "
+              << rebuildMs << " ms (height " << tree.GetHeight() << ")" << std::endl;
+
+    // Frustum: BVH frente a SIMD plano sobre todas las cajas.
+    AABBSoA soa;
+    soa.Reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+        soa.Push(tree.GetFatAABB(proxies[i]));
+    std::vector<uint8_t> visibility(count);
+    CullingStats flatStats;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        flatStats = FrustumCuller::CullAABBs(frustum, soa, visibility.data());
+    double flatMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    std::vector<uint32_t> visible;
+    CullingStats bvhStats;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        visible.clear();
+        tree.QueryFrustum(frustum, visible, &bvhStats);
+    }
+    double bvhMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+    CHECK(bvhStats.visible == flatStats.visible);
+    std::cout << "[AABBTreeTest] Frustum: flat SIMD " << flatMs << " ms, BVH " << bvhMs << " ms ("
+              << bvhStats.visible << " visible)" << std::endl;
+
+    // Rayos: BVH frente a recorrer todas las cajas.
+    const int rays = 1000;
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<glm::vec3> origins, dirs;
+    for (int i = 0; i < rays; ++i)
+    {
+        origins.emplace_back(unit(rng) * 500.0f, unit(rng) * 10.0f, unit(rng) * 500.0f);
+        dirs.push_back(glm::normalize(glm::vec3(unit(rng), unit(rng) * 0.05f, unit(rng)) + glm::vec3(0.0f, 0.0f, 1e-3f)));
+    }
+    size_t bruteHits = 0;
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rays; ++r)
+        for (uint32_t i = 0; i < count; ++i)
+            bruteHits += RayHitsBox(tree.GetFatAABB(proxies[i]), origins[r], dirs[r], 100.0f);
+    double bruteRayMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    size_t bvhHits = 0;
+    std::vector<AABBTree::RayHit> hits;
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rays; ++r)
+    {
+        hits.clear();
+        tree.QueryRay(origins[r], dirs[r], 100.0f, hits);
+        bvhHits += hits.size();
+    }
+    double bvhRayMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    CHECK(bvhHits == bruteHits);
+    std::cout << "[AABBTreeTest] " << rays << " rays: brute force " << bruteRayMs << " ms, BVH " << bvhRayMs
+              << " ms (" << bvhHits << " hits)" << std::endl;
+
+    // Refit: 1% de objetos en movimiento por frame.
+    std::uniform_real_distribution<float> step(-0.5f, 0.5f);
+    size_t reinserted = 0;
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < iterations; ++frame)
+    {
+        for (uint32_t i = 0; i < count; i += 100)
+        {
+            glm::vec3 d(step(rng), 0.0f, step(rng));
+            boxes[i] = AABB(boxes[i].min + d, boxes[i].max + d);
+            reinserted += tree.MoveProxy(proxies[i], boxes[i]);
+        }
+    }
+    double refitMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+    CHECK(tree.Validate());
+    std::cout << "[AABBTreeTest] Refit " << count / 100 << " moving proxies: " << refitMs << " ms/frame ("
+              << reinserted << " reinsertions over " << iterations << " frames)" << std::endl;
+}
+
+int main()
+{
+    TestQueriesMatchBruteForce();
+    TestMoveAndDestroy();
+    BenchmarkAgainstBruteForce();
+    std::cout << "[AABBTreeTest] All tests passed." << std::endl;
+    return 0;
+}
\ No newline at end of file
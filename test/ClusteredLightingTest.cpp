@@ -0,0 +1,150 @@
+/**
+ * @file ClusteredLightingTest.cpp
+ * @brief Test de CPU (sin contexto OpenGL) de la asignación de luces a clusters del frustum.
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include "renderer/LightClusterGrid.h"
+#include "utils/ThreadPool.h"
+
+#include "TestCheck.h"
+
+static Light MakePointLight(const glm::vec3& position, float range)
+{
+    Light light{};
+    light.typeAndPadding = glm::vec4(0.0f);
+    light.position = glm::vec4(position, range);
+    light.colorAndIntensity = glm::vec4(1.0f);
+    return light;
+}
+
+static std::vector<Light> MakeRandomLights(size_t count, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> xz(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> height(0.0f, 10.0f);
+    std::uniform_real_distribution<float> range(1.0f, 6.0f);
+    std::vector<Light> lights;
+    for (size_t i = 0; i < count; ++i)
+        lights.push_back(MakePointLight(glm::vec3(xz(rng), height(rng), xz(rng)), range(rng)));
+    return lights;
+}
+
+static bool ClusterContains(const LightClusterGrid& grid, uint32_t cluster, uint32_t light)
+{
+    const ClusterRange& range = grid.GetClusters()[cluster];
+    const auto& indices = grid.GetLightIndices();
+    return std::find(indices.begin() + range.offset, indices.begin() + range.offset + range.count, light) !=
+           indices.begin() + range.offset + range.count;
+}
+
+static void TestConservativeAssignment()
+{
+    LightClusterGrid grid;
+    grid.SetProjection(45.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 10.0f, 20.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    std::vector<Light> lights = MakeRandomLights(2000, 3);
+    grid.Build(lights, view);
+
+    // Cualquier punto dentro del rango de una luz debe encontrarla en su cluster.
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    size_t checked = 0;
+    for (uint32_t i = 0; i < lights.size(); ++i)
+    {
+        glm::vec3 center(lights[i].position);
+        float range = lights[i].position.w;
+        for (int s = 0; s < 20; ++s)
+        {
+            glm::vec3 offset(unit(rng), unit(rng), unit(rng));
+            if (glm::length(offset) > 1.0f)
+                continue;
+            glm::vec3 viewPos = glm::vec3(view * glm::vec4(center + offset * range, 1.0f));
+            float depth = -viewPos.z;
+            if (depth < 0.1f || depth > 100.0f || std::abs(viewPos.x) > depth * 0.4142f * 16.0f / 9.0f ||
+                std::abs(viewPos.y) > depth * 0.4142f)
+                continue;
+            CHECK(ClusterContains(grid, grid.FindCluster(viewPos), i));
+            checked++;
+        }
+    }
+    CHECK(checked > 1000);
+    const ClusterStats& stats = grid.GetStats();
+    CHECK(stats.references < lights.size() * LightClusterGrid::ClusterCount / 20);
+    std::cout << "[ClusteredLightingTest] " << checked << " points lit correctly; " << stats.lights
+              << " lights in frustum, " << stats.references << " references, max " << stats.maxPerCluster
+              << " per cluster" << std::endl;
+}
+
+static void TestGlobalLightsAndThreads()
+{
+    LightClusterGrid grid;
+    grid.SetProjection(60.0f, 1.0f, 0.5f, 200.0f);
+    glm::mat4 view(1.0f);
+    std::vector<Light> lights = MakeRandomLights(500, 5);
+    lights.push_back(MakePointLight(glm::vec3(0.0f, 50.0f, 0.0f), 0.0f)); // Sin rango: global
+    Light disabled = MakePointLight(glm::vec3(0.0f), 0.0f);
+    disabled.typeAndPadding.x = -1.0f;
+    lights.push_back(disabled);
+
+    grid.Build(lights, view);
+    std::vector<ClusterRange> serialClusters = grid.GetClusters();
+    std::vector<uint32_t> serialIndices = grid.GetLightIndices();
+    CHECK(grid.GetStats().globalLights == 1);
+    CHECK(grid.GetParams().gridSize.w == 1);
+    CHECK(serialIndices[0] == 500);
+
+    ThreadPool pool(3);
+    grid.Build(lights, view, &pool);
+    CHECK(grid.GetClusters().size() == serialClusters.size());
+    for (size_t i = 0; i < serialClusters.size(); ++i)
+    {
+        CHECK(grid.GetClusters()[i].offset == serialClusters[i].offset);
+        CHECK(grid.GetClusters()[i].count == serialClusters[i].count);
+    }
+    CHECK(grid.GetLightIndices() == serialIndices);
+    std::cout << "[ClusteredLightingTest] Global light and threaded build OK" << std::endl;
+}
+
+static void TestManyLightsPerformance()
+{
+    LightClusterGrid grid;
+    grid.SetProjection(45.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 10.0f, 40.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    std::vector<Light> lights = MakeRandomLights(4096, 9);
+    ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+
+    const int iterations = 20;
+    double serialMs = 0.0, threadedMs = 0.0;
+    for (int i = 0; i < iterations; ++i)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        grid.Build(lights, view);
+        auto mid = std::chrono::high_resolution_clock::now();
+        grid.Build(lights, view, &pool);
+        auto end = std::chrono::high_resolution_clock::now();
+        serialMs += std::chrono::duration<double, std::milli>(mid - start).count();
+        threadedMs += std::chrono::duration<double, std::milli>(end - mid).count();
+    }
+    const ClusterStats& stats = grid.GetStats();
+    std::cout << "[ClusteredLightingTest] 4096 lights: " << serialMs / iterations << " ms serial, "
+              << threadedMs / iterations << " ms with " << pool.GetThreadCount() << " workers; average "
+              << static_cast<float>(stats.references) / LightClusterGrid::ClusterCount << " lights per cluster (max "
+              << stats.maxPerCluster << ")" << std::endl;
+}
+
+int main()
+{
+    TestConservativeAssignment();
+    TestGlobalLightsAndThreads();
+    TestManyLightsPerformance();
+    std::cout << "[ClusteredLightingTest] All tests passed." << std::endl;
+    return 0;
+}
\ No newline at end of file
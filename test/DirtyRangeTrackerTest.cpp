@@ -0,0 +1,65 @@
+/**
+ * @file DirtyRangeTrackerTest.cpp
+ * @brief Test de CPU (sin contexto OpenGL) de los rangos sucios por sección que usa LightManager
+ * para subir solo las luces modificadas a su buffer persistente.
+ */
+
+#include <iostream>
+#include <cstdlib>
+
+#include "utils/DirtyRangeTracker.h"
+
+#include "TestCheck.h"
+
+static void TestEverySectionSeesAChange()
+{
+    DirtyRangeTracker<3> tracker;
+    tracker.Mark(4, 5);
+    for (uint32_t section = 0; section < 3; ++section)
+    {
+        DirtyRangeTracker<3>::Range range = tracker.Take(section, 10);
+        CHECK(range.begin == 4 && range.end == 5);
+        // Una vez copiada, la sección queda limpia hasta el siguiente cambio.
+        CHECK(tracker.Take(section, 10).Empty());
+    }
+    std::cout << "[DirtyRangeTrackerTest] A change is copied once into every section" << std::endl;
+}
+
+static void TestRangesMerge()
+{
+    DirtyRangeTracker<3> tracker;
+    tracker.Mark(2, 3);
+    CHECK(tracker.Take(0, 10).Count() == 1);
+    tracker.Mark(7, 8);
+    // La sección 0 solo debe la luz 7; las demás acumulan [2, 8).
+    DirtyRangeTracker<3>::Range first = tracker.Take(0, 10);
+    CHECK(first.begin == 7 && first.end == 8);
+    DirtyRangeTracker<3>::Range second = tracker.Take(1, 10);
+    CHECK(second.begin == 2 && second.end == 8);
+    CHECK(tracker.Peek(2).begin == 2 && tracker.Peek(2).end == 8);
+    std::cout << "[DirtyRangeTrackerTest] Pending ranges merge per section" << std::endl;
+}
+
+static void TestClampAndClear()
+{
+    DirtyRangeTracker<3> tracker;
+    tracker.MarkAll(16);
+    // Quedan menos elementos de los marcados: no se copia más allá del final.
+    DirtyRangeTracker<3>::Range range = tracker.Take(0, 6);
+    CHECK(range.begin == 0 && range.end == 6);
+    CHECK(tracker.Take(1, 0).Empty());
+    tracker.Mark(3, 3);
+    CHECK(tracker.Peek(0).Empty());
+    tracker.Clear();
+    CHECK(tracker.Take(2, 16).Empty());
+    std::cout << "[DirtyRangeTrackerTest] Ranges clamp to the live count and clear" << std::endl;
+}
+
+int main()
+{
+    TestEverySectionSeesAChange();
+    TestRangesMerge();
+    TestClampAndClear();
+    std::cout << "[DirtyRangeTrackerTest] All tests passed" << std::endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,210 @@
+/**
+ * @file DrawListBuilderTest.cpp
+ * @brief Test de CPU (sin contexto OpenGL) de la lista de draws en paralelo: mismo resultado que el
+ * culling y la ordenación en serie con cualquier número de hilos, orden de los campos de la clave y
+ * benchmark de escalado con 100k entidades.
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cstdlib>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "renderer/Bounds.h"
+#include "renderer/Frustum.h"
+#include "renderer/FrustumCuller.h"
+#include "renderer/DrawListBuilder.h"
+#include "utils/ThreadPool.h"
+
+#include "TestCheck.h"
+
+// Entidades sintéticas: lo que RenderSystem lee de cada registro para filtrar y construir la clave.
+struct TestScene
+{
+    std::vector<glm::mat4> transforms;
+    std::vector<uint32_t> materials;
+    std::vector<uint32_t> submeshes;
+    AABBSoA bounds;
+    glm::vec3 cameraPos{0.0f, 5.0f, 0.0f};
+    Frustum frustum;
+};
+
+static TestScene MakeScene(size_t count, unsigned seed)
+{
+    TestScene scene;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-300.0f, 300.0f);
+    std::uniform_int_distribution<uint32_t> material(0, 63);
+    std::uniform_int_distribution<uint32_t> submesh(0, 255);
+    const AABB local(glm::vec3(-1.0f), glm::vec3(1.0f));
+    scene.bounds.Reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(position(rng), 0.0f, position(rng)));
+        scene.transforms.push_back(transform);
+        scene.materials.push_back(material(rng));
+        scene.submeshes.push_back(submesh(rng));
+        scene.bounds.Push(local.Transform(transform));
+    }
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 400.0f);
+    glm::mat4 view = glm::lookAt(scene.cameraPos, glm::vec3(0.0f, 0.0f, -50.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    scene.frustum = Frustum::FromMatrix(projection * view);
+    return scene;
+}
+
+// Filtro al estilo de RenderSystem: descarta algunos (como la oclusión), elige LOD por distancia y
+// compone la clave. Los materiales >= 56 son transparentes.
+static bool Classify(const TestScene& scene, uint32_t candidate, DrawSortEntry& entry)
+{
+    if (candidate % 11 == 0)
+        return false;
+    glm::vec3 center = glm::vec3(scene.transforms[candidate] * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    float distance = glm::length(center - scene.cameraPos);
+    entry.lod = std::min(3u, static_cast<uint32_t>(distance / 60.0f));
+    uint32_t material = scene.materials[candidate];
+    entry.key = DrawListBuilder::MakeKey(material >= 56, material & 7, material, scene.submeshes[candidate], entry.lod);
+    return true;
+}
+
+// Referencia en serie: test escalar, filtro y una sola ordenación.
+static std::vector<DrawSortEntry> ReferenceList(const TestScene& scene, CullingStats& stats, uint32_t& rejected)
+{
+    std::vector<uint8_t> visibility(scene.bounds.Size());
+    stats = FrustumCuller::CullAABBsScalar(scene.frustum, scene.bounds, visibility.data());
+    rejected = 0;
+    std::vector<DrawSortEntry> entries;
+    for (uint32_t i = 0; i < visibility.size(); ++i)
+    {
+        if (!visibility[i])
+            continue;
+        DrawSortEntry entry;
+        entry.candidate = i;
+        if (Classify(scene, i, entry))
+            entries.push_back(entry);
+        else
+            rejected++;
+    }
+    std::sort(entries.begin(), entries.end());
+    return entries;
+}
+
+static bool SameEntries(const std::vector<DrawSortEntry>& a, const std::vector<DrawSortEntry>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (a[i].key != b[i].key || a[i].candidate != b[i].candidate || a[i].lod != b[i].lod)
+            return false;
+    }
+    return true;
+}
+
+static void TestKeyOrder()
+{
+    // Transparente domina a todo; después variante, material, submesh y LOD.
+    CHECK(DrawListBuilder::MakeKey(false, 31, 65535, 1000, 15) < DrawListBuilder::MakeKey(true, 0, 0, 0, 0));
+    CHECK(DrawListBuilder::MakeKey(false, 1, 0, 0, 0) > DrawListBuilder::MakeKey(false, 0, 65535, 1000, 15));
+    CHECK(DrawListBuilder::MakeKey(false, 2, 5, 0, 0) > DrawListBuilder::MakeKey(false, 2, 4, 1000, 15));
+    CHECK(DrawListBuilder::MakeKey(false, 2, 5, 7, 0) > DrawListBuilder::MakeKey(false, 2, 5, 6, 15));
+    CHECK(DrawListBuilder::MakeKey(false, 2, 5, 7, 1) > DrawListBuilder::MakeKey(false, 2, 5, 7, 0));
+    CHECK(DrawListBuilder::IsTransparent(DrawListBuilder::MakeKey(true, 0, 0, 0, 0)));
+    CHECK(!DrawListBuilder::IsTransparent(DrawListBuilder::MakeKey(false, 31, 65535, 0xFFFFFF, 15)));
+    // Fuera de rango se recorta sin invadir los campos vecinos.
+    CHECK(DrawListBuilder::MakeKey(false, 0, 0, 0x1000000, 0) == DrawListBuilder::MakeKey(false, 0, 0, 0, 0));
+    std::cout << "[DrawListBuilderTest] Key order OK" << std::endl;
+}
+
+static void TestMatchesSerial()
+{
+    TestScene scene = MakeScene(20003, 3); // No múltiplo de 4: bloques con resto escalar
+    CullingStats referenceStats;
+    uint32_t referenceRejected = 0;
+    std::vector<DrawSortEntry> reference = ReferenceList(scene, referenceStats, referenceRejected);
+    CHECK(!reference.empty());
+    size_t referenceFirstTransparent = std::find_if(reference.begin(), reference.end(),
+        [](const DrawSortEntry& entry) { return DrawListBuilder::IsTransparent(entry.key); }) - reference.begin();
+    CHECK(referenceFirstTransparent > 0 && referenceFirstTransparent < reference.size());
+
+    auto filter = [&scene](uint32_t candidate, DrawSortEntry& entry) { return Classify(scene, candidate, entry); };
+    DrawListBuilder builder;
+    builder.Build(scene.frustum, scene.bounds, filter);
+    CHECK(builder.GetBucketCount() == 1);
+    CHECK(SameEntries(builder.GetSorted(), reference));
+
+    // Con 2, 3 (buckets impares) y 5 hilos, y reutilizando el builder entre construcciones.
+    for (size_t workers : { 1, 2, 4 })
+    {
+        ThreadPool pool(workers);
+        builder.Build(scene.frustum, scene.bounds, filter, &pool);
+        CHECK(builder.GetBucketCount() == workers + 1);
+        CHECK(SameEntries(builder.GetSorted(), reference));
+        CHECK(builder.GetFirstTransparent() == referenceFirstTransparent);
+        CHECK(builder.GetCullingStats().tested == referenceStats.tested);
+        CHECK(builder.GetCullingStats().visible == referenceStats.visible);
+        CHECK(builder.GetRejectedCount() == referenceRejected);
+    }
+
+    // Desde una lista de candidatos (consulta al BVH): mismo resultado.
+    std::vector<uint8_t> visibility(scene.bounds.Size());
+    FrustumCuller::CullAABBs(scene.frustum, scene.bounds, visibility.data());
+    std::vector<uint32_t> candidates;
+    for (uint32_t i = 0; i < visibility.size(); ++i)
+        if (visibility[i])
+            candidates.push_back(i);
+    std::reverse(candidates.begin(), candidates.end());
+    ThreadPool pool(2);
+    builder.Build(candidates, filter, &pool);
+    CHECK(SameEntries(builder.GetSorted(), reference));
+    CHECK(builder.GetRejectedCount() == referenceRejected);
+
+    // Sin candidatos.
+    builder.Build(std::vector<uint32_t>(), filter, &pool);
+    CHECK(builder.GetSorted().empty());
+    CHECK(builder.GetFirstTransparent() == 0);
+    std::cout << "[DrawListBuilderTest] Threaded build matches serial (" << reference.size() << " draws)" << std::endl;
+}
+
+static void BenchmarkScaling()
+{
+    const size_t count = 100000;
+    const int iterations = 20;
+    TestScene scene = MakeScene(count, 11);
+    auto filter = [&scene](uint32_t candidate, DrawSortEntry& entry) { return Classify(scene, candidate, entry); };
+
+    const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> threadCounts;
+    for (size_t threads = 1; threads < hardware; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(hardware);
+
+    DrawListBuilder builder;
+    double serialMs = 0.0;
+    for (size_t threads : threadCounts)
+    {
+        ThreadPool pool(threads - 1);
+        builder.Build(scene.frustum, scene.bounds, filter, &pool); // Calentar buckets y workers
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+            builder.Build(scene.frustum, scene.bounds, filter, &pool);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+        if (threads == 1)
+            serialMs = ms;
+        std::cout << "[DrawListBuilderTest] " << count << " entities, " << threads << " thread(s): " << ms
+                  << " ms (" << builder.GetSorted().size() << " draws, speedup " << serialMs / ms << "x)" << std::endl;
+    }
+}
+
+int main()
+{
+    TestKeyOrder();
+    TestMatchesSerial();
+    BenchmarkScaling();
+    std::cout << "[DrawListBuilderTest] All tests passed." << std::endl;
+    return 0;
+}
\ No newline at end of file
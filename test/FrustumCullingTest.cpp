@@ -0,0 +1,138 @@
+/**
+ * @file FrustumCullingTest.cpp
+ * @brief Test de CPU (sin contexto OpenGL) del culling por frustum: extracción de planos,
+ * transformación de AABBs, equivalencia SIMD/escalar y benchmark sobre 100k cajas.
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cassert>
+#include <cstdlib>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "renderer/Bounds.h"
+#include "renderer/Frustum.h"
+#include "renderer/FrustumCuller.h"
+
+#include "TestCheck.h"
+
+static void TestBasicVisibility()
+{
+    Frustum frustum = MakeCameraFrustum();
+    AABB inFront(glm::vec3(-1.0f, -1.0f, -11.0f), glm::vec3(1.0f, 1.0f, -9.0f));
+    AABB behind(glm::vec3(-1.0f, -1.0f, 9.0f), glm::vec3(1.0f, 1.0f, 11.0f));
+    AABB beyondFar(glm::vec3(-1.0f, -1.0f, -205.0f), glm::vec3(1.0f, 1.0f, -200.0f));
+    AABB farLeft(glm::vec3(-60.0f, -1.0f, -11.0f), glm::vec3(-50.0f, 1.0f, -9.0f));
+    AABB crossingNear(glm::vec3(-1.0f, -1.0f, -1.0f), glm::vec3(1.0f, 1.0f, 1.0f));
+
+    CHECK(frustum.IntersectsAABB(inFront));
+    CHECK(!frustum.IntersectsAABB(behind));
+    CHECK(!frustum.IntersectsAABB(beyondFar));
+    CHECK(!frustum.IntersectsAABB(farLeft));
+    CHECK(frustum.IntersectsAABB(crossingNear));
+
+    BoundingSphere sphere;
+    sphere.center = glm::vec3(0.0f, 0.0f, -20.0f);
+    sphere.radius = 1.0f;
+    CHECK(frustum.IntersectsSphere(sphere));
+    sphere.center = glm::vec3(0.0f, 0.0f, 20.0f);
+    CHECK(!frustum.IntersectsSphere(sphere));
+
+    AABBSoA soa;
+    soa.Push(inFront);
+    soa.Push(behind);
+    soa.Push(beyondFar);
+    soa.Push(farLeft);
+    soa.Push(crossingNear);
+    std::vector<uint8_t> visibility(soa.Size());
+    CullingStats stats = FrustumCuller::CullAABBs(frustum, soa, visibility.data());
+    CHECK(stats.tested == 5);
+    CHECK(stats.visible == 2);
+    CHECK(stats.culled == 3);
+    CHECK(visibility[0] == 1 && visibility[1] == 0 && visibility[2] == 0 && visibility[3] == 0 && visibility[4] == 1);
+    std::cout << "[FrustumCullingTest] Basic visibility OK" << std::endl;
+}
+
+static void TestTransformedBounds()
+{
+    AABB unit(glm::vec3(-1.0f), glm::vec3(1.0f));
+    glm::mat4 m = glm::translate(glm::mat4(1.0f), glm::vec3(10.0f, 0.0f, 0.0f)) *
+                  glm::rotate(glm::mat4(1.0f), glm::radians(45.0f), glm::vec3(0.0f, 1.0f, 0.0f)) *
+                  glm::scale(glm::mat4(1.0f), glm::vec3(2.0f));
+    AABB world = unit.Transform(m);
+    // Un cubo de lado 4 rotado 45º en Y ocupa 2*sqrt(2)*2 en X y Z.
+    float expected = 2.0f * std::sqrt(2.0f) * 2.0f;
+    CHECK(std::abs((world.max.x - world.min.x) - expected) < 1e-4f);
+    CHECK(std::abs((world.max.z - world.min.z) - expected) < 1e-4f);
+    CHECK(std::abs((world.max.y - world.min.y) - 4.0f) < 1e-4f);
+    CHECK(std::abs(world.Center().x - 10.0f) < 1e-4f);
+    std::cout << "[FrustumCullingTest] Transformed bounds OK" << std::endl;
+}
+
+static AABBSoA MakeRandomBoxes(size_t count, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+    std::uniform_real_distribution<float> size(0.1f, 5.0f);
+    AABBSoA soa;
+    soa.Reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        glm::vec3 c(position(rng), position(rng) * 0.2f, position(rng));
+        glm::vec3 e(size(rng), size(rng), size(rng));
+        soa.Push(AABB(c - e, c + e));
+    }
+    return soa;
+}
+
+static void TestSimdMatchesScalar()
+{
+    Frustum frustum = MakeCameraFrustum();
+    // 1003 cajas: cubre también el resto no múltiplo de 4.
+    AABBSoA soa = MakeRandomBoxes(1003, 42);
+    std::vector<uint8_t> simd(soa.Size()), scalar(soa.Size());
+    CullingStats simdStats = FrustumCuller::CullAABBs(frustum, soa, simd.data());
+    CullingStats scalarStats = FrustumCuller::CullAABBsScalar(frustum, soa, scalar.data());
+    CHECK(simd == scalar);
+    CHECK(simdStats.visible == scalarStats.visible);
+    CHECK(simdStats.culled == scalarStats.culled);
+    CHECK(simdStats.tested == soa.Size());
+    CHECK(simdStats.visible > 0 && simdStats.culled > 0);
+    std::cout << "[FrustumCullingTest] SIMD matches scalar (" << simdStats.visible << " visible, "
+              << simdStats.culled << " culled)" << std::endl;
+}
+
+static void BenchmarkCulling()
+{
+    const size_t count = 100000;
+    const int iterations = 50;
+    Frustum frustum = MakeCameraFrustum();
+    AABBSoA soa = MakeRandomBoxes(count, 7);
+    std::vector<uint8_t> visibility(count);
+
+    auto run = [&](bool simd) {
+        CullingStats stats;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+            stats = simd ? FrustumCuller::CullAABBs(frustum, soa, visibility.data())
+                         : FrustumCuller::CullAABBsScalar(frustum, soa, visibility.data());
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+        std::cout << "[FrustumCullingTest] " << (simd ? "SIMD  " : "Scalar") << ": " << count << " boxes in "
+                  << ms << " ms (" << stats.visible << " visible, " << stats.culled << " culled)" << std::endl;
+    };
+    run(false);
+    run(true);
+}
+
+int main()
+{
+    TestBasicVisibility();
+    TestTransformedBounds();
+    TestSimdMatchesScalar();
+    BenchmarkCulling();
+    std::cout << "[FrustumCullingTest] All tests passed." << std::endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+/**
+ * @file MeshLODTest.cpp
+ * @brief Test de CPU (sin contexto OpenGL) de la cadena de LODs: simplificación cuádrica sobre
+ * mallas cerradas y con bordes, y selección de LOD por tamaño en pantalla con histéresis.
+ */
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "renderer/MeshSimplifier.h"
+#include "renderer/LODSelector.h"
+
+#include "TestCheck.h"
+
+// Icosfera de radio 1 (malla cerrada sin costuras).
+static void MakeIcosphere(int subdivisions, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices)
+{
+    const float t = (1.0f + std::sqrt(5.0f)) * 0.5f;
+    positions = { { -1, t, 0 }, { 1, t, 0 }, { -1, -t, 0 }, { 1, -t, 0 }, { 0, -1, t }, { 0, 1, t },
+                  { 0, -1, -t }, { 0, 1, -t }, { t, 0, -1 }, { t, 0, 1 }, { -t, 0, -1 }, { -t, 0, 1 } };
+    for (auto& p : positions)
+        p = glm::normalize(p);
+    indices = { 0, 11, 5, 0, 5, 1, 0, 1, 7, 0, 7, 10, 0, 10, 11, 1, 5, 9, 5, 11, 4, 11, 10, 2, 10, 7, 6, 7, 1, 8,
+                3, 9, 4, 3, 4, 2, 3, 2, 6, 3, 6, 8, 3, 8, 9, 4, 9, 5, 2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1 };
+    for (int s = 0; s < subdivisions; ++s)
+    {
+        std::map<std::pair<uint32_t, uint32_t>, uint32_t> midpoints;
+        auto midpoint = [&](uint32_t a, uint32_t b) {
+            auto key = std::make_pair(std::min(a, b), std::max(a, b));
+            auto it = midpoints.find(key);
+            if (it != midpoints.end())
+                return it->second;
+            positions.push_back(glm::normalize(positions[a] + positions[b]));
+            uint32_t index = static_cast<uint32_t>(positions.size() - 1);
+            midpoints[key] = index;
+            return index;
+        };
+        std::vector<uint32_t> next;
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            uint32_t a = indices[i], b = indices[i + 1], c = indices[i + 2];
+            uint32_t ab = midpoint(a, b), bc = midpoint(b, c), ca = midpoint(c, a);
+            next.insert(next.end(), { a, ab, ca, b, bc, ab, c, ca, bc, ab, bc, ca });
+        }
+        indices = std::move(next);
+    }
+}
+
+static double SignedVolume(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices)
+{
+    double volume = 0.0;
+    for (size_t i = 0; i < indices.size(); i += 3)
+        volume += glm::dot(glm::dvec3(positions[indices[i]]),
+                           glm::cross(glm::dvec3(positions[indices[i + 1]]), glm::dvec3(positions[indices[i + 2]]))) / 6.0;
+    return volume;
+}
+
+static void CheckValidIndices(const std::vector<uint32_t>& indices, size_t vertexCount)
+{
+    CHECK(indices.size() % 3 == 0);
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        CHECK(indices[i] < vertexCount && indices[i + 1] < vertexCount && indices[i + 2] < vertexCount);
+        CHECK(indices[i] != indices[i + 1] && indices[i + 1] != indices[i + 2] && indices[i] != indices[i + 2]);
+    }
+}
+
+static void TestSphereChain()
+{
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    MakeIcosphere(4, positions, indices);
+    const double fullVolume = SignedVolume(positions, indices);
+
+    const float ratios[] = { 0.5f, 0.25f, 0.1f };
+    std::vector<uint32_t> source = indices;
+    auto start = std::chrono::steady_clock::now();
+    for (float ratio : ratios)
+    {
+        size_t target = (static_cast<size_t>(indices.size() * ratio) / 3) * 3;
+        float error = 0.0f;
+        std::vector<uint32_t> lod = MeshSimplifier::Simplify(positions, source, target, 0.05f, &error);
+        CheckValidIndices(lod, positions.size());
+        // Cerca del objetivo (no por encima del 10%) y con el volumen conservado.
+        CHECK(lod.size() <= target + target / 10);
+        CHECK(error > 0.0f && error <= 0.05f);
+        double volume = SignedVolume(positions, lod);
+        CHECK(volume > 0.0 && std::abs(volume - fullVolume) / fullVolume < 0.15);
+        std::cout << "[MeshLODTest] Sphere LOD " << ratio * 100.0f << "%: " << lod.size() / 3 << " triangles, error "
+                  << error << ", volume " << volume / fullVolume * 100.0 << "%" << std::endl;
+        source = std::move(lod);
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[MeshLODTest] Chain for " << indices.size() / 3 << " triangles built in " << ms << " ms" << std::endl;
+}
+
+static void TestBordersAreLocked()
+{
+    // Rejilla plana de 32x32 quads: el interior se puede colapsar sin error, el borde no se toca.
+    const int n = 32;
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    for (int y = 0; y <= n; ++y)
+        for (int x = 0; x <= n; ++x)
+            positions.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.0f);
+    for (int y = 0; y < n; ++y)
+        for (int x = 0; x < n; ++x)
+        {
+            uint32_t i = y * (n + 1) + x;
+            indices.insert(indices.end(), { i, i + 1, i + n + 2, i, i + n + 2, i + n + 1 });
+        }
+    float error = 1.0f;
+    std::vector<uint32_t> lod = MeshSimplifier::Simplify(positions, indices, 0, 0.01f, &error);
+    CheckValidIndices(lod, positions.size());
+    CHECK(error < 1e-4f);
+    CHECK(lod.size() < indices.size() / 4);
+
+    // El área total se conserva y todos los vértices del borde siguen referenciados.
+    double area = 0.0;
+    std::vector<uint8_t> used(positions.size(), 0);
+    for (size_t i = 0; i < lod.size(); i += 3)
+    {
+        area += 0.5 * glm::length(glm::cross(positions[lod[i + 1]] - positions[lod[i]], positions[lod[i + 2]] - positions[lod[i]]));
+        used[lod[i]] = used[lod[i + 1]] = used[lod[i + 2]] = 1;
+    }
+    CHECK(std::abs(area - n * n) < 1e-3);
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        const glm::vec3& p = positions[i];
+        if (p.x == 0.0f || p.y == 0.0f || p.x == n || p.y == n)
+            CHECK(used[i]);
+    }
+    std::cout << "[MeshLODTest] Flat grid with borders: " << indices.size() / 3 << " -> " << lod.size() / 3
+              << " triangles" << std::endl;
+}
+
+static void TestErrorLimitStops()
+{
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    MakeIcosphere(3, positions, indices);
+    float error = 0.0f;
+    // Con un error máximo minúsculo no se puede reducir una esfera al 1%.
+    std::vector<uint32_t> lod = MeshSimplifier::Simplify(positions, indices, indices.size() / 100, 1e-4f, &error);
+    CHECK(lod.size() > indices.size() / 2);
+    CHECK(error <= 1e-4f);
+    std::cout << "[MeshLODTest] Error limit respected" << std::endl;
+}
+
+static void TestLODSelection()
+{
+    LODSettings settings;
+    BoundingSphere sphere;
+    sphere.center = glm::vec3(0.0f, 0.0f, -10.0f);
+    sphere.radius = 1.0f;
+    float near = LODSelector::ScreenSize(sphere, glm::vec3(0.0f), 45.0f);
+    sphere.center.z = -1000.0f;
+    float far = LODSelector::ScreenSize(sphere, glm::vec3(0.0f), 45.0f);
+    CHECK(near > far);
+    CHECK(LODSelector::Select(near, 0, 4, settings) == 0);
+    CHECK(LODSelector::Select(far, 0, 4, settings) == 3);
+    CHECK(LODSelector::Select(far, 0, 2, settings) == 1);
+    CHECK(LODSelector::Select(far, 0, 1, settings) == 0);
+
+    // Justo alrededor del primer umbral no hay cambios (histéresis).
+    const float threshold = LODSettings::Thresholds[0];
+    CHECK(LODSelector::Select(threshold * 0.95f, 0, 4, settings) == 0);
+    CHECK(LODSelector::Select(threshold * 1.05f, 1, 4, settings) == 1);
+    CHECK(LODSelector::Select(threshold * 0.8f, 0, 4, settings) == 1);
+    CHECK(LODSelector::Select(threshold * 1.2f, 1, 4, settings) == 0);
+
+    // El bias desplaza la selección.
+    settings.bias = 2.0f;
+    CHECK(LODSelector::Select(threshold * 0.8f, 0, 4, settings) == 0);
+
+    glm::mat4 transform = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(5.0f, 0.0f, 0.0f)), glm::vec3(3.0f));
+    BoundingSphere world = LODSelector::TransformSphere(BoundingSphere{ glm::vec3(1.0f, 0.0f, 0.0f), 2.0f }, transform);
+    CHECK(std::abs(world.center.x - 8.0f) < 1e-5f && std::abs(world.radius - 6.0f) < 1e-5f);
+    std::cout << "[MeshLODTest] LOD selection with hysteresis OK" << std::endl;
+}
+
+int main()
+{
+    TestSphereChain();
+    TestBordersAreLocked();
+    TestErrorLimitStops();
+    TestLODSelection();
+    std::cout << "[MeshLODTest] All tests passed." << std::endl;
+    return 0;
+}
\ No newline at end of file
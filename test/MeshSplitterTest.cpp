@@ -0,0 +1,102 @@
+/**
+ * @file MeshSplitterTest.cpp
+ * @brief Test de CPU (sin contexto OpenGL) de la división de mallas grandes en trozos
+ * indexables con índices de 16 bits.
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+
+#include "renderer/MeshSplitter.h"
+
+#include "TestCheck.h"
+
+// Rejilla de (n+1)^2 vértices y 2*n^2 triángulos.
+static std::vector<uint32_t> MakeGrid(uint32_t n)
+{
+    std::vector<uint32_t> indices;
+    for (uint32_t y = 0; y < n; ++y)
+        for (uint32_t x = 0; x < n; ++x)
+        {
+            uint32_t i = y * (n + 1) + x;
+            indices.insert(indices.end(), { i, i + 1, i + n + 2, i, i + n + 2, i + n + 1 });
+        }
+    return indices;
+}
+
+// Comprueba límites por trozo y que la concatenación reproduce los triángulos originales en orden.
+static void CheckChunks(const std::vector<MeshChunk>& chunks, const std::vector<uint32_t>& indices, size_t maxVertices)
+{
+    std::vector<uint32_t> rebuilt;
+    for (const auto& chunk : chunks)
+    {
+        CHECK(!chunk.indices.empty());
+        CHECK(chunk.vertexRemap.size() <= maxVertices);
+        for (uint32_t local : chunk.indices)
+        {
+            CHECK(local < chunk.vertexRemap.size());
+            rebuilt.push_back(chunk.vertexRemap[local]);
+        }
+    }
+    CHECK(rebuilt == indices);
+}
+
+static void TestSmallMeshIsOneChunk()
+{
+    std::vector<uint32_t> indices = MakeGrid(100);
+    const size_t vertexCount = 101 * 101;
+    CHECK(!MeshSplitter::NeedsSplit(vertexCount));
+    std::vector<MeshChunk> chunks = MeshSplitter::Split(vertexCount, indices);
+    CHECK(chunks.size() == 1);
+    CHECK(chunks[0].vertexRemap.size() == vertexCount);
+    CheckChunks(chunks, indices, MeshSplitter::Max16BitVertices);
+    std::cout << "[MeshSplitterTest] Small mesh kept in one chunk" << std::endl;
+}
+
+static void TestLargeMeshSplits()
+{
+    const uint32_t n = 400; // 160801 vértices
+    std::vector<uint32_t> indices = MakeGrid(n);
+    const size_t vertexCount = static_cast<size_t>(n + 1) * (n + 1);
+    CHECK(MeshSplitter::NeedsSplit(vertexCount));
+    std::vector<MeshChunk> chunks = MeshSplitter::Split(vertexCount, indices);
+    CHECK(chunks.size() >= 3);
+    CheckChunks(chunks, indices, MeshSplitter::Max16BitVertices);
+
+    // Con un index buffer coherente se duplican pocos vértices (solo las filas frontera).
+    size_t total = 0;
+    for (const auto& chunk : chunks)
+        total += chunk.vertexRemap.size();
+    CHECK(total < vertexCount + chunks.size() * (n + 1) * 2);
+    std::cout << "[MeshSplitterTest] " << vertexCount << " vertices split into " << chunks.size() << " chunks ("
+              << total - vertexCount << " duplicated vertices)" << std::endl;
+}
+
+static void TestSmallLimitAndShuffledIndices()
+{
+    // Triángulos desordenados y un límite pequeño: todos los trozos deben respetarlo.
+    std::vector<uint32_t> indices = MakeGrid(64);
+    std::vector<size_t> order(indices.size() / 3);
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::shuffle(order.begin(), order.end(), std::mt19937(1));
+    std::vector<uint32_t> shuffled;
+    for (size_t t : order)
+        shuffled.insert(shuffled.end(), { indices[t * 3], indices[t * 3 + 1], indices[t * 3 + 2] });
+    std::vector<MeshChunk> chunks = MeshSplitter::Split(65 * 65, shuffled, 300);
+    CHECK(chunks.size() > 1);
+    CheckChunks(chunks, shuffled, 300);
+    std::cout << "[MeshSplitterTest] Shuffled mesh with limit 300: " << chunks.size() << " chunks" << std::endl;
+}
+
+int main()
+{
+    TestSmallMeshIsOneChunk();
+    TestLargeMeshSplits();
+    TestSmallLimitAndShuffledIndices();
+    std::cout << "[MeshSplitterTest] All tests passed." << std::endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+/**
+ * @file NormalMatrixTest.cpp
+ * @brief Test de CPU (sin contexto OpenGL) de las matrices normales calculadas en CPU
+ * (TransformComponent::normalMatrix y MeshInstance::normalMatrix) frente a la inversa traspuesta
+ * por vértice que hacía pbr_vertex.glsl, y benchmark de la transformación de normales del tren.
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <glm/glm.hpp>
+
+#include "components/TransformComponent.h"
+
+#include "TestCheck.h"
+
+// Vértices de assets/train/scene.gltf (suma de los accesores POSITION).
+static const size_t TrainVertexCount = 1499238;
+
+static glm::mat3 ReferenceNormalMatrix(const glm::mat4& model)
+{
+    return glm::transpose(glm::inverse(glm::mat3(model)));
+}
+
+// Las dos matrices pueden diferir en un factor de escala: se comparan las normales ya normalizadas.
+static bool SameNormals(const glm::mat3& a, const glm::mat3& b)
+{
+    const glm::vec3 normals[] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, glm::normalize(glm::vec3(1, -2, 3)) };
+    for (const glm::vec3& n : normals)
+    {
+        if (glm::length(glm::normalize(a * n) - glm::normalize(b * n)) > 1e-4f)
+            return false;
+    }
+    return true;
+}
+
+static TransformComponent RandomTransform(std::mt19937& rng, bool uniformScale)
+{
+    std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+    std::uniform_real_distribution<float> scale(0.2f, 4.0f);
+    TransformComponent transform;
+    transform.translation = glm::vec3(angle(rng), angle(rng), angle(rng));
+    transform.rotation = glm::vec3(angle(rng), angle(rng), angle(rng));
+    float s = scale(rng);
+    transform.scale = uniformScale ? glm::vec3(s) : glm::vec3(s, scale(rng), scale(rng));
+    transform.UpdateTransform();
+    return transform;
+}
+
+static void TestEntityNormalMatrix()
+{
+    std::mt19937 rng(7);
+    for (int i = 0; i < 1000; ++i)
+    {
+        TransformComponent transform = RandomTransform(rng, i % 2 == 0);
+        CHECK(SameNormals(transform.normalMatrix, ReferenceNormalMatrix(transform.transform)));
+    }
+
+    // Escala uniforme sin rotación: identidad.
+    TransformComponent scaled;
+    scaled.scale = glm::vec3(3.0f);
+    scaled.UpdateTransform();
+    CHECK(scaled.normalMatrix == glm::mat3(1.0f));
+    std::cout << "[NormalMatrixTest] Entity normal matrices match inverse-transpose" << std::endl;
+}
+
+// Entidad * nodo: el producto de las matrices normales de cada parte es la del producto.
+static void TestComposedNormalMatrix()
+{
+    std::mt19937 rng(11);
+    for (int i = 0; i < 1000; ++i)
+    {
+        TransformComponent entity = RandomTransform(rng, false);
+        glm::mat4 node = RandomTransform(rng, false).transform;
+        glm::mat3 composed = entity.normalMatrix * ReferenceNormalMatrix(node);
+        CHECK(SameNormals(composed, ReferenceNormalMatrix(entity.transform * node)));
+    }
+    std::cout << "[NormalMatrixTest] Entity * node normal matrices match the world inverse-transpose" << std::endl;
+}
+
+// Lo que hace el vertex shader con las normales del tren, antes (inversa por vértice) y ahora (matriz leída).
+static void BenchmarkTrainNormals()
+{
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<glm::vec3> normals(TrainVertexCount);
+    for (auto& n : normals)
+        n = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)) + glm::vec3(0.0f, 0.0f, 1e-3f));
+    TransformComponent transform = RandomTransform(rng, false);
+    const glm::mat4 model = transform.transform;
+
+    // Como en la GPU, la matriz se lee por vértice (el compilador no puede sacar la inversa del bucle).
+    const glm::mat4* volatile instanceModel = &model;
+    glm::vec3 sumPerVertex(0.0f), sumPrecomputed(0.0f);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto& n : normals)
+        sumPerVertex += glm::normalize(ReferenceNormalMatrix(*instanceModel) * n);
+    auto middle = std::chrono::high_resolution_clock::now();
+    const glm::mat3 normalMatrix = transform.normalMatrix;
+    for (const auto& n : normals)
+        sumPrecomputed += glm::normalize(normalMatrix * n);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    CHECK(glm::length(sumPerVertex - sumPrecomputed) < 1e-5f * static_cast<float>(TrainVertexCount));
+    double perVertexMs = std::chrono::duration<double, std::milli>(middle - start).count();
+    double precomputedMs = std::chrono::duration<double, std::milli>(end - middle).count();
+    std::cout << "[NormalMatrixTest] Train normals (" << TrainVertexCount << " vertices): per-vertex inverse "
+              << perVertexMs << " ms, precomputed " << precomputedMs << " ms (" << perVertexMs / precomputedMs
+              << "x)" << std::endl;
+}
+
+int main()
+{
+    TestEntityNormalMatrix();
+    TestComposedNormalMatrix();
+    BenchmarkTrainNormals();
+    std::cout << "[NormalMatrixTest] All tests passed" << std::endl;
+    return 0;
+}
\ No newline at end of file
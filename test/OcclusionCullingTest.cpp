@@ -0,0 +1,165 @@
+/**
+ * @file OcclusionCullingTest.cpp
+ * @brief Test de CPU (sin contexto OpenGL) del occlusion culling por software: rasterización de
+ * oclusores, test conservador de AABBs, recorte contra el plano near y benchmark.
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "renderer/Bounds.h"
+#include "renderer/OcclusionCuller.h"
+
+#include "TestCheck.h"
+
+static glm::mat4 MakeViewProj()
+{
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1920.0f / 1080.0f, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return projection * view;
+}
+
+// Cuadrado de lado 2*halfSize en el plano z = 0 (dos triángulos).
+static OccluderMesh MakeQuad(float halfSize)
+{
+    OccluderMesh quad;
+    quad.positions = { glm::vec3(-halfSize, -halfSize, 0.0f), glm::vec3(halfSize, -halfSize, 0.0f),
+                       glm::vec3(halfSize, halfSize, 0.0f), glm::vec3(-halfSize, halfSize, 0.0f) };
+    quad.indices = { 0, 1, 2, 0, 2, 3 };
+    quad.bounds = AABB(glm::vec3(-halfSize, -halfSize, 0.0f), glm::vec3(halfSize, halfSize, 0.0f));
+    return quad;
+}
+
+static void TestWallOccludes()
+{
+    OcclusionCuller culler;
+    culler.BeginFrame(MakeViewProj());
+    OccluderMesh wall = MakeQuad(3.0f);
+    culler.RasterizeOccluder(wall, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -10.0f)));
+    CHECK(culler.GetStats().occluders == 1);
+    CHECK(culler.GetStats().occluderTriangles == 2);
+
+    AABB behind(glm::vec3(-1.0f, -1.0f, -22.0f), glm::vec3(1.0f, 1.0f, -20.0f));
+    AABB inFront(glm::vec3(-1.0f, -1.0f, -6.0f), glm::vec3(1.0f, 1.0f, -4.0f));
+    AABB peeking(glm::vec3(5.0f, -1.0f, -32.0f), glm::vec3(15.0f, 1.0f, -30.0f)); // Asoma por el lateral
+    AABB crossingWall(glm::vec3(-1.0f, -1.0f, -12.0f), glm::vec3(1.0f, 1.0f, -8.0f));
+    AABB crossingNear(glm::vec3(-1.0f, -1.0f, -1.0f), glm::vec3(1.0f, 1.0f, 1.0f));
+    CHECK(!culler.IsVisible(behind));
+    CHECK(culler.IsVisible(inFront));
+    CHECK(culler.IsVisible(peeking));
+    CHECK(culler.IsVisible(crossingWall));
+    CHECK(culler.IsVisible(crossingNear));
+    // El oclusor no debe ocultarse a sí mismo.
+    CHECK(culler.IsVisible(AABB(glm::vec3(-3.0f, -3.0f, -10.0f), glm::vec3(3.0f, 3.0f, -10.0f))));
+    CHECK(culler.GetStats().tested == 6);
+    CHECK(culler.GetStats().occluded == 1);
+    std::cout << "[OcclusionCullingTest] Wall occlusion OK" << std::endl;
+}
+
+static void TestEmptyBufferKeepsEverything()
+{
+    OcclusionCuller culler;
+    culler.BeginFrame(MakeViewProj());
+    CHECK(culler.IsVisible(AABB(glm::vec3(-1.0f, -1.0f, -50.0f), glm::vec3(1.0f, 1.0f, -48.0f))));
+    // Un hueco entre dos oclusores deja ver lo que hay detrás.
+    OccluderMesh wall = MakeQuad(2.0f);
+    culler.RasterizeOccluder(wall, glm::translate(glm::mat4(1.0f), glm::vec3(-3.0f, 0.0f, -10.0f)));
+    culler.RasterizeOccluder(wall, glm::translate(glm::mat4(1.0f), glm::vec3(3.0f, 0.0f, -10.0f)));
+    CHECK(culler.IsVisible(AABB(glm::vec3(-0.5f, -0.5f, -30.0f), glm::vec3(0.5f, 0.5f, -29.0f))));
+    CHECK(!culler.IsVisible(AABB(glm::vec3(-7.0f, -0.5f, -30.0f), glm::vec3(-5.0f, 0.5f, -29.0f))));
+    std::cout << "[OcclusionCullingTest] Gaps between occluders OK" << std::endl;
+}
+
+static void TestNearClipping()
+{
+    // Un suelo que pasa por detrás de la cámara debe recortarse contra el near y seguir ocluyendo.
+    OcclusionCuller culler;
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1920.0f / 1080.0f, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, -0.5f, -5.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    culler.BeginFrame(projection * view);
+    OccluderMesh ground = MakeQuad(50.0f);
+    culler.RasterizeOccluder(ground, glm::rotate(glm::mat4(1.0f), glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f)));
+    CHECK(culler.GetStats().occluderTriangles > 0);
+    // Bajo el suelo: oculto. Sobre el suelo: visible.
+    CHECK(!culler.IsVisible(AABB(glm::vec3(-1.0f, -3.0f, -12.0f), glm::vec3(1.0f, -2.0f, -10.0f))));
+    CHECK(culler.IsVisible(AABB(glm::vec3(-1.0f, 0.0f, -12.0f), glm::vec3(1.0f, 0.5f, -10.0f))));
+    std::cout << "[OcclusionCullingTest] Near plane clipping OK" << std::endl;
+}
+
+static void TestOccluderSelection()
+{
+    AABB modelBounds(glm::vec3(-50.0f), glm::vec3(50.0f));
+    OccluderMesh wall = MakeQuad(10.0f);
+    OccluderMesh out;
+    CHECK(OcclusionCuller::BuildOccluder(wall.positions, wall.indices, modelBounds, out));
+    CHECK(out.TriangleCount() == 2);
+    // Demasiado pequeño respecto al modelo.
+    OccluderMesh pebble = MakeQuad(0.5f);
+    CHECK(!OcclusionCuller::BuildOccluder(pebble.positions, pebble.indices, modelBounds, out));
+    // Demasiados triángulos.
+    std::vector<uint32_t> dense;
+    for (size_t i = 0; i <= OcclusionCuller::MaxOccluderTriangles; ++i)
+        dense.insert(dense.end(), { 0, 1, 2 });
+    CHECK(!OcclusionCuller::BuildOccluder(wall.positions, dense, modelBounds, out));
+    std::cout << "[OcclusionCullingTest] Occluder selection OK" << std::endl;
+}
+
+static void BenchmarkOcclusion()
+{
+    const int occluderCount = 200;
+    const size_t boxCount = 100000;
+    const int iterations = 20;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> lateral(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> depthRange(-90.0f, -5.0f);
+    std::uniform_real_distribution<float> size(0.2f, 2.0f);
+
+    OccluderMesh wall = MakeQuad(3.0f);
+    std::vector<glm::mat4> occluders;
+    for (int i = 0; i < occluderCount; ++i)
+        occluders.push_back(glm::translate(glm::mat4(1.0f), glm::vec3(lateral(rng), lateral(rng) * 0.2f, depthRange(rng) * 0.3f)));
+    std::vector<AABB> boxes;
+    for (size_t i = 0; i < boxCount; ++i)
+    {
+        glm::vec3 c(lateral(rng), lateral(rng) * 0.2f, depthRange(rng));
+        glm::vec3 e(size(rng));
+        boxes.emplace_back(c - e, c + e);
+    }
+
+    OcclusionCuller culler;
+    double rasterMs = 0.0, testMs = 0.0;
+    for (int it = 0; it < iterations; ++it)
+    {
+        auto start = std::chrono::steady_clock::now();
+        culler.BeginFrame(MakeViewProj());
+        for (const auto& model : occluders)
+            culler.RasterizeOccluder(wall, model);
+        auto mid = std::chrono::steady_clock::now();
+        for (const auto& box : boxes)
+            culler.IsVisible(box);
+        auto end = std::chrono::steady_clock::now();
+        rasterMs += std::chrono::duration<double, std::milli>(mid - start).count();
+        testMs += std::chrono::duration<double, std::milli>(end - mid).count();
+    }
+    const OcclusionStats& stats = culler.GetStats();
+    CHECK(stats.occluded > 0 && stats.occluded < stats.tested);
+    std::cout << "[OcclusionCullingTest] " << occluderCount << " occluders rasterized in " << rasterMs / iterations
+              << " ms, " << boxCount << " boxes tested in " << testMs / iterations << " ms (" << stats.occluded
+              << " occluded)" << std::endl;
+}
+
+int main()
+{
+    TestWallOccludes();
+    TestEmptyBufferKeepsEverything();
+    TestNearClipping();
+    TestOccluderSelection();
+    BenchmarkOcclusion();
+    std::cout << "[OcclusionCullingTest] All tests passed." << std::endl;
+    return 0;
+}
\ No newline at end of file
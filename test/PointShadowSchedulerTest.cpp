@@ -0,0 +1,116 @@
+/**
+ * @file PointShadowSchedulerTest.cpp
+ * @brief Test de CPU (sin contexto OpenGL) del reparto de slots y el refresco por caras del atlas de sombras.
+ */
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+
+#include "renderer/PointShadowScheduler.h"
+
+#include "TestCheck.h"
+
+static AABB Box(const glm::vec3& center, float halfSize)
+{
+    return AABB(center - glm::vec3(halfSize), center + glm::vec3(halfSize));
+}
+
+static uint32_t Faces(const std::vector<PointShadowRequest>& requests)
+{
+    uint32_t faces = 0;
+    for (const auto& request : requests)
+        for (int f = 0; f < 6; ++f)
+            faces += (request.faces >> f) & 1u;
+    return faces;
+}
+
+static void TestFacesTouched()
+{
+    glm::vec3 light(0.0f);
+    CHECK(PointShadowScheduler::FacesTouched(light, 10.0f, Box(glm::vec3(5.0f, 0.0f, 0.0f), 0.5f)) == 0x01);
+    CHECK(PointShadowScheduler::FacesTouched(light, 10.0f, Box(glm::vec3(0.0f, -5.0f, 0.0f), 0.5f)) == 0x08);
+    // Sobre la diagonal x = z: toca +X y +Z.
+    CHECK(PointShadowScheduler::FacesTouched(light, 10.0f, Box(glm::vec3(4.0f, 0.0f, 4.0f), 0.5f)) == (0x01 | 0x10));
+    // Fuera del radio: nada. Conteniendo la luz: todo.
+    CHECK(PointShadowScheduler::FacesTouched(light, 10.0f, Box(glm::vec3(20.0f, 0.0f, 0.0f), 0.5f)) == 0);
+    CHECK(PointShadowScheduler::FacesTouched(light, 10.0f, Box(glm::vec3(0.2f), 1.0f)) == PointShadowScheduler::AllFaces);
+    std::cout << "[PointShadowSchedulerTest] Face classification OK" << std::endl;
+}
+
+static void TestSchedulingScalesWithChange()
+{
+    PointShadowSettings settings;
+    settings.slotCount = 8;
+    settings.faceBudget = 12;
+    PointShadowScheduler scheduler;
+    scheduler.SetSettings(settings);
+
+    // 10 luces en fila: las 8 más cercanas a la cámara tienen slot.
+    std::vector<ShadowLight> lights;
+    for (uint32_t i = 0; i < 10; ++i)
+        lights.push_back({ i, glm::vec3(i * 20.0f, 3.0f, 0.0f), 8.0f });
+    glm::vec3 camera(-10.0f, 3.0f, 0.0f);
+    std::vector<PointShadowRequest> requests;
+    std::vector<AABB> moved;
+
+    // Primer llenado del atlas: 48 caras repartidas en 4 frames de 12.
+    uint32_t frames = 0;
+    uint32_t total = 0;
+    do
+    {
+        scheduler.Schedule(lights, moved, camera, requests);
+        CHECK(Faces(requests) <= settings.faceBudget);
+        total += Faces(requests);
+        ++frames;
+    } while (!requests.empty() && frames < 10);
+    CHECK(total == 48);
+    CHECK(frames == 5);
+    CHECK(scheduler.GetSlot(7) >= 0);
+    CHECK(scheduler.GetSlot(8) < 0 && scheduler.GetSlot(9) < 0);
+
+    // Escena quieta: coste cero.
+    scheduler.Schedule(lights, moved, camera, requests);
+    CHECK(requests.empty());
+
+    // Un coche pasando junto a la luz 2 (x = 40): solo se refrescan las caras que ve, y solo de esa luz.
+    moved = { Box(glm::vec3(44.0f, 3.0f, 0.0f), 1.0f), Box(glm::vec3(45.0f, 3.0f, 0.0f), 1.0f) };
+    scheduler.Schedule(lights, moved, camera, requests);
+    CHECK(requests.size() == 1);
+    CHECK(requests[0].light == 2);
+    CHECK(requests[0].faces == 0x01);
+    CHECK(scheduler.GetStats().shadowedLights == 8);
+    std::cout << "[PointShadowSchedulerTest] Scheduling OK (" << frames << " frames to fill, "
+              << Faces(requests) << " face for a moving caster)" << std::endl;
+}
+
+static void TestNoStarvation()
+{
+    // Con presupuesto de una cara, una luz cercana siempre sucia no bloquea a una lejana.
+    PointShadowSettings settings;
+    settings.slotCount = 2;
+    settings.faceBudget = 1;
+    PointShadowScheduler scheduler;
+    scheduler.SetSettings(settings);
+    std::vector<ShadowLight> lights = { { 0, glm::vec3(0.0f), 5.0f }, { 1, glm::vec3(100.0f, 0.0f, 0.0f), 5.0f } };
+    std::vector<PointShadowRequest> requests;
+    std::vector<AABB> moved = { Box(glm::vec3(0.0f), 1.0f) };
+    bool farServed = false;
+    for (int frame = 0; frame < 20 && !farServed; ++frame)
+    {
+        scheduler.Schedule(lights, moved, glm::vec3(0.0f), requests);
+        CHECK(Faces(requests) == 1);
+        farServed = requests[0].light == 1;
+    }
+    CHECK(farServed);
+    std::cout << "[PointShadowSchedulerTest] No starvation OK" << std::endl;
+}
+
+int main()
+{
+    TestFacesTouched();
+    TestSchedulingScalesWithChange();
+    TestNoStarvation();
+    std::cout << "[PointShadowSchedulerTest] All tests passed" << std::endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+/**
+ * @file RingAllocatorTest.cpp
+ * @brief Test de CPU (sin contexto OpenGL) del reparto por secciones del FrameRingBuffer:
+ * alineación, límites de la sección de cada frame, rotación entre frames y crecimiento a mitad del ring.
+ */
+
+#include <iostream>
+#include <cstdlib>
+
+#include "utils/RingAllocator.h"
+
+#include "TestCheck.h"
+
+static void TestAlignment()
+{
+    RingAllocator ring;
+    ring.Reset(4096);
+    CHECK(ring.Allocate(100, 256) == 0);
+    CHECK(ring.Allocate(16, 256) == 256);
+    CHECK(ring.Allocate(4, 1) == 272);
+    CHECK(ring.Allocate(64, 16) == 288);
+    CHECK(ring.GetUsed() == 352);
+    std::cout << "[RingAllocatorTest] Allocations honour the requested alignment" << std::endl;
+}
+
+static void TestSectionLimits()
+{
+    RingAllocator ring;
+    ring.Reset(1024);
+    CHECK(ring.Allocate(1000, 16) == 0);
+    // No cabe (con la alineación) en lo que queda: no invade la sección del frame siguiente.
+    CHECK(ring.Allocate(32, 16) == RingAllocator::InvalidOffset);
+    CHECK(ring.Allocate(16, 16) == 1008);
+    CHECK(ring.Allocate(1, 1) == RingAllocator::InvalidOffset);
+    CHECK(ring.GetPeak() == 1024);
+    std::cout << "[RingAllocatorTest] Allocations stay inside the frame's section" << std::endl;
+}
+
+static void TestFrameRotation()
+{
+    RingAllocator ring;
+    ring.Reset(1000);
+    for (uint32_t frame = 0; frame < RingAllocator::FrameCount * 2; ++frame)
+    {
+        uint32_t section = frame % RingAllocator::FrameCount;
+        CHECK(ring.GetFrame() == section);
+        // La sección 1 empieza en 1000: la alineación a 256 la lleva a 1024.
+        size_t first = ring.Allocate(8, 256);
+        size_t expected = (section * 1000 + 255) / 256 * 256;
+        CHECK(first == expected);
+        CHECK(first >= ring.SectionOffset() && first + 8 <= ring.SectionOffset() + ring.GetSectionSize());
+        ring.NextFrame();
+        CHECK(ring.GetUsed() == 0);
+    }
+    CHECK(ring.GetTotalSize() == 3000);
+    std::cout << "[RingAllocatorTest] Frames rotate through " << RingAllocator::FrameCount << " sections" << std::endl;
+}
+
+static void TestGrowMidRing()
+{
+    RingAllocator ring;
+    ring.Reset(1024);
+    ring.NextFrame();
+    CHECK(ring.Allocate(1000, 16) == 1024);
+    CHECK(ring.Allocate(512, 16) == RingAllocator::InvalidOffset);
+
+    // Crecer en el frame 1: la sección sigue siendo la 1 (sus fences y los de los frames en vuelo
+    // siguen cubriendo lo mismo) y empieza vacía en el buffer nuevo.
+    ring.Resize(4096);
+    CHECK(ring.GetFrame() == 1);
+    CHECK(ring.GetUsed() == 0);
+    CHECK(ring.GetTotalSize() == 4096 * RingAllocator::FrameCount);
+    CHECK(ring.Allocate(512, 16) == 4096);
+    ring.NextFrame();
+    CHECK(ring.GetFrame() == 2);
+    CHECK(ring.Allocate(8, 16) == 8192);
+    ring.NextFrame();
+    CHECK(ring.GetFrame() == 0);
+    std::cout << "[RingAllocatorTest] Growing mid-ring keeps the frame index" << std::endl;
+}
+
+int main()
+{
+    TestAlignment();
+    TestSectionLimits();
+    TestFrameRotation();
+    TestGrowMidRing();
+    std::cout << "[RingAllocatorTest] All tests passed" << std::endl;
+    return 0;
+}
\ No newline at end of file
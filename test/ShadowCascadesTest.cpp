@@ -0,0 +1,129 @@
+/**
+ * @file ShadowCascadesTest.cpp
+ * @brief Test de CPU (sin contexto OpenGL) de la colocación y la caché de las cascadas de sombra.
+ */
+
+#include <iostream>
+#include <random>
+#include <cmath>
+#include <cstdlib>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include "renderer/ShadowCascades.h"
+
+#include "TestCheck.h"
+
+static const float Fov = 45.0f;
+static const float Aspect = 16.0f / 9.0f;
+static const float Near = 0.1f;
+static const float Far = 100.0f;
+static const glm::vec3 LightDir = glm::normalize(glm::vec3(-0.4f, -1.0f, -0.3f));
+
+static glm::mat4 MakeView(const glm::vec3& position, const glm::vec3& target)
+{
+    return glm::lookAt(position, target, glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+static void TestSplits()
+{
+    ShadowCascades cascades;
+    ShadowCascadeSettings settings;
+    settings.maxDistance = 80.0f;
+    cascades.SetSettings(settings);
+    cascades.Update(MakeView(glm::vec3(0.0f, 10.0f, 20.0f), glm::vec3(0.0f)), Fov, Aspect, Near, Far, LightDir);
+
+    float previous = Near;
+    for (uint32_t i = 0; i < cascades.GetCascadeCount(); ++i)
+    {
+        const ShadowCascade& cascade = cascades.GetCascade(i);
+        CHECK(cascade.splitNear == previous);
+        CHECK(cascade.splitFar > cascade.splitNear);
+        previous = cascade.splitFar;
+    }
+    CHECK(std::abs(previous - 80.0f) < 1e-3f);
+    CHECK(cascades.FindCascade(0.5f) == 0);
+    CHECK(cascades.FindCascade(79.0f) == static_cast<int>(cascades.GetCascadeCount()) - 1);
+    CHECK(cascades.FindCascade(90.0f) == -1);
+    std::cout << "[ShadowCascadesTest] Splits OK (" << cascades.GetCascade(0).splitFar << ", "
+              << cascades.GetCascade(1).splitFar << ", " << cascades.GetCascade(2).splitFar << ", "
+              << cascades.GetCascade(3).splitFar << ")" << std::endl;
+}
+
+static void TestCoverage()
+{
+    // Todo punto visible de un slice debe caer dentro del volumen de su cascada.
+    ShadowCascades cascades;
+    cascades.SetSettings(ShadowCascadeSettings());
+    glm::mat4 view = MakeView(glm::vec3(3.0f, 10.0f, 20.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    cascades.Update(view, Fov, Aspect, Near, Far, LightDir);
+    glm::mat4 invView = glm::inverse(view);
+    float tanHalfY = std::tan(glm::radians(Fov) * 0.5f);
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> depth(Near, 100.0f);
+    for (int s = 0; s < 20000; ++s)
+    {
+        float d = depth(rng);
+        glm::vec3 viewPos(unit(rng) * d * tanHalfY * Aspect, unit(rng) * d * tanHalfY, -d);
+        int c = cascades.FindCascade(d);
+        CHECK(c >= 0);
+        glm::vec4 clip = cascades.GetCascade(c).viewProj * invView * glm::vec4(viewPos, 1.0f);
+        glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        CHECK(std::abs(ndc.x) <= 1.0f && std::abs(ndc.y) <= 1.0f && std::abs(ndc.z) <= 1.0f);
+    }
+    std::cout << "[ShadowCascadesTest] Coverage OK" << std::endl;
+}
+
+static void TestStablePlacement()
+{
+    ShadowCascades cascades;
+    ShadowCascadeSettings settings;
+    cascades.SetSettings(settings);
+    glm::vec3 position(0.0f, 10.0f, 20.0f);
+    glm::vec3 target(0.0f);
+    CHECK(cascades.Update(MakeView(position, target), Fov, Aspect, Near, Far, LightDir) == 0xFu);
+
+    // Centros ajustados a texel en espacio de luz.
+    for (uint32_t i = 0; i < cascades.GetCascadeCount(); ++i)
+    {
+        const ShadowCascade& cascade = cascades.GetCascade(i);
+        float texel = cascades.GetTexelSize(i);
+        for (int axis = 0; axis < 2; ++axis)
+        {
+            float steps = cascade.center[axis] / texel;
+            CHECK(std::abs(steps - std::round(steps)) < 1e-2f);
+        }
+    }
+
+    // Un desplazamiento pequeño (un coche avanzando con la cámara) no mueve las cascadas lejanas.
+    uint32_t versions[ShadowCascades::MaxCascades];
+    for (uint32_t i = 0; i < cascades.GetCascadeCount(); ++i)
+        versions[i] = cascades.GetCascade(i).version;
+    glm::vec3 step(0.05f, 0.0f, -0.05f);
+    uint32_t farReplaced = 0;
+    for (int frame = 1; frame <= 20; ++frame)
+    {
+        uint32_t replaced = cascades.Update(MakeView(position + step * float(frame), target + step * float(frame)),
+                                            Fov, Aspect, Near, Far, LightDir);
+        farReplaced |= replaced & 0xCu;
+    }
+    CHECK(farReplaced == 0);
+    CHECK(cascades.GetCascade(3).version == versions[3]);
+
+    // Un salto grande recoloca todas; un cambio de dirección de la luz también.
+    uint32_t replaced = cascades.Update(MakeView(position + glm::vec3(500.0f, 0.0f, 0.0f), target + glm::vec3(500.0f, 0.0f, 0.0f)),
+                                        Fov, Aspect, Near, Far, LightDir);
+    CHECK(replaced == 0xFu);
+    CHECK(cascades.Update(MakeView(position, target), Fov, Aspect, Near, Far, glm::vec3(0.3f, -1.0f, 0.0f)) == 0xFu);
+    std::cout << "[ShadowCascadesTest] Stable placement OK" << std::endl;
+}
+
+int main()
+{
+    TestSplits();
+    TestCoverage();
+    TestStablePlacement();
+    std::cout << "[ShadowCascadesTest] All tests passed" << std::endl;
+    return 0;
+}
\ No newline at end of file
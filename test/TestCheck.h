@@ -0,0 +1,33 @@
+/**
+ * @file TestCheck.h
+ * @brief Utilidades comunes de los tests de CPU: CHECK (aborta con el fallo y su línea, también en
+ * Release) y el frustum de la cámara por defecto.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <cstdlib>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "renderer/Frustum.h"
+
+#define CHECK(cond)                                                                     \
+    do                                                                                  \
+    {                                                                                   \
+        if (!(cond))                                                                    \
+        {                                                                               \
+            std::cerr << "CHECK failed: " #cond " (" << __FILE__ << ":" << __LINE__ << ")" \
+                      << std::endl;                                                     \
+            std::exit(1);                                                               \
+        }                                                                               \
+    } while (0)
+
+// Misma configuración que Camera por defecto: fov 45º, 16:9, near 0.1, far 100, mirando a -Z desde el origen.
+inline Frustum MakeCameraFrustum()
+{
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1920.0f / 1080.0f, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return Frustum::FromMatrix(projection * view);
+}
@@ -0,0 +1,98 @@
+/**
+ * @file VertexFormatTest.cpp
+ * @brief Test de CPU (sin contexto OpenGL) del formato de vértice compacto: precisión de la
+ * cuantización de posiciones, codificación octaédrica de normales/tangentes y UV en half.
+ */
+
+#include <iostream>
+#include <random>
+#include <cmath>
+#include <cstdlib>
+#include <glm/glm.hpp>
+
+#include "renderer/VertexFormat.h"
+
+#include "TestCheck.h"
+
+static glm::vec3 RandomUnit(std::mt19937& rng)
+{
+    std::normal_distribution<float> gauss(0.0f, 1.0f);
+    glm::vec3 v;
+    do
+    {
+        v = glm::vec3(gauss(rng), gauss(rng), gauss(rng));
+    } while (glm::length(v) < 1e-3f);
+    return glm::normalize(v);
+}
+
+// Ángulo entre vectores unitarios a partir de la cuerda (más preciso que acos(dot) para ángulos pequeños).
+static float AngleDegrees(const glm::vec3& a, const glm::vec3& b)
+{
+    return glm::degrees(2.0f * std::asin(std::min(glm::length(a - b) * 0.5f, 1.0f)));
+}
+
+static void TestRoundTrip()
+{
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> coord(-3.0f, 7.0f);
+    std::uniform_real_distribution<float> uv(-2.0f, 2.0f);
+    const glm::vec3 boundsMin(-3.0f), boundsMax(7.0f);
+    VertexQuantization quantization = VertexPacking::QuantizationForBounds(boundsMin, boundsMax);
+
+    float maxPositionError = 0.0f, maxNormalAngle = 0.0f, maxTangentAngle = 0.0f, maxUVError = 0.0f;
+    for (int i = 0; i < 100000; ++i)
+    {
+        glm::vec3 position(coord(rng), coord(rng), coord(rng));
+        glm::vec3 normal = RandomUnit(rng);
+        glm::vec4 tangent(RandomUnit(rng), (i & 1) ? 1.0f : -1.0f);
+        glm::vec2 texCoords(uv(rng), uv(rng));
+
+        CompactVertex packed = VertexPacking::Pack(position, normal, tangent, texCoords, quantization);
+        maxPositionError = std::max(maxPositionError,
+                                    glm::length(VertexPacking::UnpackPosition(packed, quantization) - position));
+        maxNormalAngle = std::max(maxNormalAngle, AngleDegrees(VertexPacking::UnpackNormal(packed), normal));
+        glm::vec4 decodedTangent = VertexPacking::UnpackTangent(packed);
+        maxTangentAngle = std::max(maxTangentAngle, AngleDegrees(glm::vec3(decodedTangent), glm::vec3(tangent)));
+        CHECK(decodedTangent.w == tangent.w);
+        glm::vec2 decodedUV = VertexPacking::UnpackTexCoords(packed);
+        maxUVError = std::max(maxUVError, std::max(std::abs(decodedUV.x - texCoords.x), std::abs(decodedUV.y - texCoords.y)));
+    }
+
+    // unorm16 sobre 10 unidades: medio paso por eje como máximo.
+    CHECK(maxPositionError <= std::sqrt(3.0f) * 0.5f * 10.0f / 65535.0f + 1e-5f);
+    CHECK(maxNormalAngle < 0.01f);
+    CHECK(maxTangentAngle < 0.01f);
+    CHECK(maxUVError < 2e-3f); // half: 10 bits de mantisa en [-2, 2]
+    std::cout << "[VertexFormatTest] Max errors: position " << maxPositionError << ", normal " << maxNormalAngle
+              << " deg, tangent " << maxTangentAngle << " deg, uv " << maxUVError << std::endl;
+}
+
+static void TestEdgeCases()
+{
+    // Caja plana en un eje: no debe dividir por cero.
+    VertexQuantization flat = VertexPacking::QuantizationForBounds(glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(4.0f, 2.0f, 4.0f));
+    CompactVertex v = VertexPacking::Pack(glm::vec3(1.0f, 2.0f, 3.0f), glm::vec3(0.0f, 1.0f, 0.0f),
+                                          glm::vec4(0.0f), glm::vec2(0.5f), flat);
+    glm::vec3 p = VertexPacking::UnpackPosition(v, flat);
+    CHECK(std::abs(p.x - 1.0f) < 1e-3f && std::abs(p.y - 2.0f) < 1e-6f && std::abs(p.z - 3.0f) < 1e-3f);
+
+    // Sin tangente se genera una perpendicular a la normal.
+    glm::vec3 t = glm::vec3(VertexPacking::UnpackTangent(v));
+    CHECK(std::abs(glm::dot(t, glm::vec3(0.0f, 1.0f, 0.0f))) < 1e-3f);
+
+    // Los ejes y los polos de la codificación octaédrica se conservan.
+    const glm::vec3 axes[] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+    for (const auto& axis : axes)
+        CHECK(glm::length(VertexPacking::OctDecode(VertexPacking::OctEncode(axis)) - axis) < 1e-5f);
+
+    CHECK(sizeof(CompactVertex) == 20);
+    std::cout << "[VertexFormatTest] Edge cases OK (" << sizeof(CompactVertex) << " bytes per vertex)" << std::endl;
+}
+
+int main()
+{
+    TestRoundTrip();
+    TestEdgeCases();
+    std::cout << "[VertexFormatTest] All tests passed." << std::endl;
+    return 0;
+}
\ No newline at end of file